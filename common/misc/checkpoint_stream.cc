@@ -0,0 +1,41 @@
+#include "checkpoint_stream.h"
+
+// Larger stdio buffers: checkpoints are written and read sequentially
+static const size_t CHECKPOINT_BUFFER_SIZE = 1 << 20;
+
+CheckpointWriter::CheckpointWriter(const std::string& filename)
+   : _filename(filename)
+{
+   _file = fopen(_filename.c_str(), "wb");
+   LOG_ASSERT_ERROR(_file, "Could not open checkpoint file(%s) for writing", _filename.c_str());
+   setvbuf(_file, NULL, _IOFBF, CHECKPOINT_BUFFER_SIZE);
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+   __attribute(__unused__) int ret = fclose(_file);
+   LOG_ASSERT_ERROR(ret == 0, "Could not write checkpoint file(%s)", _filename.c_str());
+}
+
+CheckpointReader::CheckpointReader(const std::string& filename)
+   : _filename(filename)
+{
+   _file = fopen(_filename.c_str(), "rb");
+   LOG_ASSERT_ERROR(_file, "Could not open checkpoint file(%s) for reading", _filename.c_str());
+   setvbuf(_file, NULL, _IOFBF, CHECKPOINT_BUFFER_SIZE);
+}
+
+CheckpointReader::~CheckpointReader()
+{
+   fclose(_file);
+}
+
+void
+CheckpointReader::checkSection(UInt32 section)
+{
+   UInt32 saved_section;
+   (*this) >> saved_section;
+   LOG_ASSERT_ERROR(saved_section == section,
+                    "Checkpoint file(%s) is corrupt or was written with a different configuration: "
+                    "expected section(%#x), found(%#x)", _filename.c_str(), section, saved_section);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <set>
+
+#include "fixed_types.h"
+#include "log.h"
+
+// Binary streams for simulator checkpoints
+// Values are written back to back in the host's native layout, so a
+// checkpoint can only be restored by the same simulator build. Every
+// component writes a section marker before its state; a mismatch on
+// restore points at the component whose layout changed.
+
+enum CheckpointSection
+{
+   CHECKPOINT_TILE = 0x43500001,
+   CHECKPOINT_CORE_MODEL,
+   CHECKPOINT_MEMORY_MANAGER,
+   CHECKPOINT_CACHE,
+   CHECKPOINT_DIRECTORY_CACHE,
+   CHECKPOINT_DRAM,
+   CHECKPOINT_VM_MANAGER
+};
+
+class CheckpointWriter
+{
+public:
+   CheckpointWriter(const std::string& filename);
+   ~CheckpointWriter();
+
+   template <class T> void put(const T* data, UInt64 num);
+   template <class T> void put(const std::vector<T>& data);
+   template <class T> void put(const std::set<T>& data);
+
+   template <class T> CheckpointWriter& operator<<(const T& data)
+   { put<T>(&data, 1); return *this; }
+
+   void putSection(UInt32 section) { (*this) << section; }
+
+private:
+   std::string _filename;
+   FILE* _file;
+};
+
+class CheckpointReader
+{
+public:
+   CheckpointReader(const std::string& filename);
+   ~CheckpointReader();
+
+   template <class T> void get(T* data, UInt64 num);
+   template <class T> void get(std::vector<T>& data);
+   template <class T> void get(std::set<T>& data);
+
+   template <class T> CheckpointReader& operator>>(T& data)
+   { get<T>(&data, 1); return *this; }
+
+   void checkSection(UInt32 section);
+
+private:
+   std::string _filename;
+   FILE* _file;
+};
+
+template <class T>
+void CheckpointWriter::put(const T* data, UInt64 num)
+{
+   __attribute(__unused__) size_t written = fwrite(data, sizeof(T), num, _file);
+   LOG_ASSERT_ERROR(written == num, "Could not write checkpoint file(%s)", _filename.c_str());
+}
+
+template <class T>
+void CheckpointWriter::put(const std::vector<T>& data)
+{
+   (*this) << (UInt64) data.size();
+   if (!data.empty())
+      put<T>(&data[0], data.size());
+}
+
+template <class T>
+void CheckpointWriter::put(const std::set<T>& data)
+{
+   (*this) << (UInt64) data.size();
+   for (typename std::set<T>::const_iterator it = data.begin(); it != data.end(); it++)
+      (*this) << *it;
+}
+
+template <class T>
+void CheckpointReader::get(T* data, UInt64 num)
+{
+   __attribute(__unused__) size_t read = fread(data, sizeof(T), num, _file);
+   LOG_ASSERT_ERROR(read == num, "Checkpoint file(%s) is truncated", _filename.c_str());
+}
+
+template <class T>
+void CheckpointReader::get(std::vector<T>& data)
+{
+   UInt64 size;
+   (*this) >> size;
+   data.resize(size);
+   if (size > 0)
+      get<T>(&data[0], size);
+}
+
+template <class T>
+void CheckpointReader::get(std::set<T>& data)
+{
+   UInt64 size;
+   (*this) >> size;
+   data.clear();
+   for (UInt64 i = 0; i < size; i++)
+   {
+      T element;
+      (*this) >> element;
+      data.insert(data.end(), element);
+   }
+}
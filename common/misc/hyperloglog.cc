@@ -0,0 +1,88 @@
+#include <cmath>
+
+#include "hyperloglog.h"
+#include "log.h"
+
+HyperLogLog::HyperLogLog(UInt32 precision)
+   : _precision(precision)
+   , _num_registers(1 << precision)
+{
+   LOG_ASSERT_ERROR(precision >= MIN_PRECISION && precision <= MAX_PRECISION,
+                    "HyperLogLog precision(%u) must be between %u and %u", precision, MIN_PRECISION, MAX_PRECISION);
+   _registers.resize(_num_registers, 0);
+}
+
+HyperLogLog::~HyperLogLog()
+{}
+
+void
+HyperLogLog::insert(UInt64 key)
+{
+   // The top bits select the register, which keeps the longest run of
+   // leading zeros (plus one) seen in the remaining bits
+   UInt64 h = hash(key);
+   UInt32 index = (UInt32) (h >> (64 - _precision));
+   UInt64 remaining = h << _precision;
+   UInt8 rank = (remaining == 0) ? (UInt8) (64 - _precision + 1) : (UInt8) (__builtin_clzll(remaining) + 1);
+   if (rank > _registers[index])
+      _registers[index] = rank;
+}
+
+UInt64
+HyperLogLog::estimate() const
+{
+   double m = (double) _num_registers;
+   double sum = 0.0;
+   UInt32 num_zero_registers = 0;
+   for (UInt32 i = 0; i < _num_registers; i++)
+   {
+      sum += ldexp(1.0, -((int) _registers[i]));
+      if (_registers[i] == 0)
+         num_zero_registers ++;
+   }
+
+   double alpha;
+   switch (_num_registers)
+   {
+   case 16:
+      alpha = 0.673;
+      break;
+   case 32:
+      alpha = 0.697;
+      break;
+   case 64:
+      alpha = 0.709;
+      break;
+   default:
+      alpha = 0.7213 / (1.0 + 1.079 / m);
+      break;
+   }
+   double estimate = alpha * m * m / sum;
+
+   // The raw estimate is biased for small cardinalities, where linear
+   // counting on the empty registers is accurate. With a 64-bit hash, no
+   // correction is needed for large ones
+   if ((estimate <= 2.5 * m) && (num_zero_registers > 0))
+      estimate = m * log(m / (double) num_zero_registers);
+
+   return (UInt64) (estimate + 0.5);
+}
+
+double
+HyperLogLog::getStandardError(UInt32 precision)
+{
+   return 1.04 / sqrt((double) (1 << precision));
+}
+
+UInt64
+HyperLogLog::hash(UInt64 key)
+{
+   // 64-bit finalizer of MurmurHash3
+   UInt64 h = key;
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return h;
+}
@@ -0,0 +1,37 @@
+#ifndef HYPERLOGLOG_H
+#define HYPERLOGLOG_H
+
+#include <vector>
+
+#include "fixed_types.h"
+
+// Estimates the number of distinct keys inserted (HyperLogLog, with linear
+// counting for small cardinalities)
+//
+// Keeps 2^precision one-byte registers. The relative standard error of the
+// estimate is 1.04 / sqrt(2^precision), e.g., 1.6% for a precision of 12
+// (4 KB), independently of the number of keys. Inserting a key that was
+// already inserted never changes the estimate.
+class HyperLogLog
+{
+public:
+   HyperLogLog(UInt32 precision);
+   ~HyperLogLog();
+
+   void insert(UInt64 key);
+   UInt64 estimate() const;
+
+   static double getStandardError(UInt32 precision);
+
+   static const UInt32 MIN_PRECISION = 4;
+   static const UInt32 MAX_PRECISION = 16;
+
+private:
+   UInt32 _precision;
+   UInt32 _num_registers;
+   std::vector<UInt8> _registers;
+
+   static UInt64 hash(UInt64 key);
+};
+
+#endif /* HYPERLOGLOG_H */
@@ -0,0 +1,194 @@
+#include "mailbox.h"
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <limits.h>
+#include "utils.h"
+#include "log.h"
+
+Mailbox::Mailbox(UInt32 capacity)
+   : m_enqueue_pos(0)
+   , m_dequeue_pos(0)
+   , m_overflow_count(0)
+   , m_sleeping(0)
+   , m_spin_count(MIN_SPIN_COUNT)
+{
+   LOG_ASSERT_ERROR(isPower2(capacity) && (capacity >= 2),
+                    "Mailbox capacity(%u) must be a power of 2", capacity);
+
+   m_ring = new Slot[capacity];
+   m_mask = capacity - 1;
+   for (UInt32 i = 0; i < capacity; i++)
+   {
+      m_ring[i].m_sequence = i;
+      m_ring[i].m_msg = NULL;
+   }
+}
+
+Mailbox::~Mailbox()
+{
+   delete [] m_ring;
+}
+
+void Mailbox::push(Byte* msg)
+{
+   if ((m_overflow_count > 0) || !tryEnqueue(msg))
+   {
+      m_overflow_lock.acquire();
+      m_overflow_queue.push(msg);
+      __sync_fetch_and_add(&m_overflow_count, 1);
+      m_overflow_lock.release();
+   }
+
+   wakeReceiver();
+}
+
+Byte* Mailbox::pop()
+{
+   Byte* msg;
+   while ((msg = tryPop()) == NULL)
+      waitForMessage();
+   return msg;
+}
+
+UInt32 Mailbox::popMany(Byte** msgs, UInt32 max_msgs)
+{
+   assert(max_msgs > 0);
+
+   msgs[0] = pop();
+
+   UInt32 num_msgs = 1;
+   while (num_msgs < max_msgs)
+   {
+      Byte* msg = tryPop();
+      if (msg == NULL)
+         break;
+      msgs[num_msgs ++] = msg;
+   }
+   return num_msgs;
+}
+
+Byte* Mailbox::tryPop()
+{
+   // Messages in the ring are always older than those in the overflow queue
+   Byte* msg = tryDequeue();
+   if ((msg == NULL) && (m_overflow_count > 0))
+   {
+      m_overflow_lock.acquire();
+      if (!m_overflow_queue.empty())
+      {
+         msg = m_overflow_queue.front();
+         m_overflow_queue.pop();
+         __sync_fetch_and_sub(&m_overflow_count, 1);
+      }
+      m_overflow_lock.release();
+   }
+   return msg;
+}
+
+bool Mailbox::empty()
+{
+   UInt64 pos = m_dequeue_pos;
+   __sync_synchronize();
+   return (m_ring[pos & m_mask].m_sequence != (pos + 1)) && (m_overflow_count == 0);
+}
+
+bool Mailbox::tryEnqueue(Byte* msg)
+{
+   UInt64 pos = m_enqueue_pos;
+   Slot* slot;
+
+   while (true)
+   {
+      slot = &m_ring[pos & m_mask];
+      SInt64 diff = (SInt64) slot->m_sequence - (SInt64) pos;
+      if (diff == 0)
+      {
+         // Slot is free: claim it
+         if (__sync_bool_compare_and_swap(&m_enqueue_pos, pos, pos + 1))
+            break;
+         pos = m_enqueue_pos;
+      }
+      else if (diff < 0)
+      {
+         // Ring is full
+         return false;
+      }
+      else
+      {
+         pos = m_enqueue_pos;
+      }
+   }
+
+   slot->m_msg = msg;
+   // Publish the message
+   __sync_synchronize();
+   slot->m_sequence = pos + 1;
+   return true;
+}
+
+Byte* Mailbox::tryDequeue()
+{
+   UInt64 pos = m_dequeue_pos;
+   Slot* slot;
+
+   while (true)
+   {
+      slot = &m_ring[pos & m_mask];
+      SInt64 diff = (SInt64) slot->m_sequence - (SInt64) (pos + 1);
+      if (diff == 0)
+      {
+         if (__sync_bool_compare_and_swap(&m_dequeue_pos, pos, pos + 1))
+            break;
+         pos = m_dequeue_pos;
+      }
+      else if (diff < 0)
+      {
+         // Ring is empty
+         return NULL;
+      }
+      else
+      {
+         pos = m_dequeue_pos;
+      }
+   }
+
+   __sync_synchronize();
+   Byte* msg = slot->m_msg;
+   // Hand the slot back to the producers for the next lap around the ring
+   __sync_synchronize();
+   slot->m_sequence = pos + m_mask + 1;
+   return msg;
+}
+
+void Mailbox::waitForMessage()
+{
+   // Spin first: handoffs between simulator threads are usually quick
+   for (UInt32 i = 0; i < m_spin_count; i++)
+   {
+      if (!empty())
+      {
+         if (m_spin_count < MAX_SPIN_COUNT)
+            m_spin_count *= 2;
+         return;
+      }
+      __asm__ __volatile__("pause" ::: "memory");
+   }
+   if (m_spin_count > MIN_SPIN_COUNT)
+      m_spin_count /= 2;
+
+   // Announce that we are going to sleep, then re-check to avoid a lost wakeup
+   m_sleeping = 1;
+   __sync_synchronize();
+   if (empty())
+      syscall(SYS_futex, (void*) &m_sleeping, FUTEX_WAIT, 1, NULL, NULL, 0);
+   m_sleeping = 0;
+}
+
+void Mailbox::wakeReceiver()
+{
+   __sync_synchronize();
+   if ((m_sleeping == 1) && __sync_bool_compare_and_swap(&m_sleeping, 1, 0))
+      syscall(SYS_futex, (void*) &m_sleeping, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
@@ -0,0 +1,75 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <queue>
+
+#include "fixed_types.h"
+#include "lock.h"
+
+// Message queue for intra-process transport nodes
+//
+// Messages go through a bounded lock-free ring (Vyukov-style, per-slot
+// sequence numbers) that any number of threads may push to. If the ring
+// fills up, messages spill into a locked overflow queue; while the overflow
+// queue is non-empty all producers use it, so per-producer FIFO order is kept.
+//
+// A waiting receiver first spins for an adaptively sized number of polls
+// and then sleeps on a futex until a producer wakes it up.
+
+class Mailbox
+{
+public:
+   Mailbox(UInt32 capacity = DEFAULT_CAPACITY);
+   ~Mailbox();
+
+   void push(Byte* msg);
+
+   // Blocking receive of one message
+   Byte* pop();
+   // Blocking receive of at least one and at most 'max_msgs' messages
+   UInt32 popMany(Byte** msgs, UInt32 max_msgs);
+   // Non-blocking receive, returns NULL if no message is available
+   Byte* tryPop();
+
+   bool empty();
+
+   static const UInt32 DEFAULT_CAPACITY = 1024;
+
+private:
+   struct Slot
+   {
+      volatile UInt64 m_sequence;
+      Byte* m_msg;
+   };
+
+   static const UInt32 MIN_SPIN_COUNT = 16;
+   static const UInt32 MAX_SPIN_COUNT = 4096;
+   static const UInt32 HOST_CACHE_LINE_SIZE = 64;
+
+   Slot* m_ring;
+   UInt64 m_mask;
+
+   // Keep the producer and consumer positions on separate host cache lines.
+   // Padding instead of an alignment attribute, since heap-allocated
+   // mailboxes are not over-aligned by operator new before C++17
+   char m_pad0[HOST_CACHE_LINE_SIZE];
+   volatile UInt64 m_enqueue_pos;
+   char m_pad1[HOST_CACHE_LINE_SIZE - sizeof(UInt64)];
+   volatile UInt64 m_dequeue_pos;
+   char m_pad2[HOST_CACHE_LINE_SIZE - sizeof(UInt64)];
+
+   Lock m_overflow_lock;
+   std::queue<Byte*> m_overflow_queue;
+   volatile UInt32 m_overflow_count;
+
+   // 1 while a receiver is (about to go) asleep on the futex
+   volatile int m_sleeping;
+   UInt32 m_spin_count;
+
+   bool tryEnqueue(Byte* msg);
+   Byte* tryDequeue();
+   void waitForMessage();
+   void wakeReceiver();
+};
+
+#endif // MAILBOX_H
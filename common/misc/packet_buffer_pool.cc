@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "packet_buffer_pool.h"
+#include "utils.h"
+#include "log.h"
+
+PacketBufferPool::SizeClass PacketBufferPool::m_size_classes[NUM_SIZE_CLASSES];
+
+Byte* PacketBufferPool::allocate(UInt32 size)
+{
+   UInt32 size_class = getSizeClass(size);
+   BufferHeader* header = NULL;
+
+   if (size_class < NUM_SIZE_CLASSES)
+   {
+      SizeClass& free_buffers = m_size_classes[size_class];
+
+      lockSizeClass(free_buffers);
+      header = free_buffers.m_free_list;
+      if (header)
+      {
+         free_buffers.m_free_list = header->m_next;
+         free_buffers.m_num_free --;
+      }
+      unlockSizeClass(free_buffers);
+
+      if (!header)
+         header = (BufferHeader*) malloc(sizeof(BufferHeader) + (1 << (size_class + MIN_BUFFER_SIZE_LOG2)));
+   }
+   else
+   {
+      header = (BufferHeader*) malloc(sizeof(BufferHeader) + size);
+   }
+
+   LOG_ASSERT_ERROR(header != NULL, "Could not allocate message buffer of size(%u)", size);
+
+   header->m_size_class = size_class;
+   header->m_in_use = 1;
+   header->m_next = NULL;
+
+   return (Byte*) (header + 1);
+}
+
+void PacketBufferPool::release(Byte* buffer)
+{
+   BufferHeader* header = getHeader(buffer);
+
+   __attribute(__unused__) bool was_in_use = __sync_bool_compare_and_swap(&header->m_in_use, 1, 0);
+   LOG_ASSERT_ERROR(was_in_use, "Message buffer(%p) released twice", buffer);
+
+   if (header->m_size_class < NUM_SIZE_CLASSES)
+   {
+      SizeClass& free_buffers = m_size_classes[header->m_size_class];
+
+      lockSizeClass(free_buffers);
+      if (free_buffers.m_num_free < MAX_FREE_BUFFERS)
+      {
+         header->m_next = free_buffers.m_free_list;
+         free_buffers.m_free_list = header;
+         free_buffers.m_num_free ++;
+         header = NULL;
+      }
+      unlockSizeClass(free_buffers);
+   }
+
+   if (header)
+      free(header);
+}
+
+UInt32 PacketBufferPool::getSizeClass(UInt32 size)
+{
+   if (size <= (1U << MIN_BUFFER_SIZE_LOG2))
+      return 0;
+   if (size > (1U << (MIN_BUFFER_SIZE_LOG2 + NUM_SIZE_CLASSES - 1)))
+      return NUM_SIZE_CLASSES;
+   return ceilLog2(size) - MIN_BUFFER_SIZE_LOG2;
+}
+
+PacketBufferPool::BufferHeader* PacketBufferPool::getHeader(Byte* buffer)
+{
+   assert(buffer != NULL);
+   return ((BufferHeader*) buffer) - 1;
+}
+
+void PacketBufferPool::lockSizeClass(SizeClass& size_class)
+{
+   while (__sync_lock_test_and_set(&size_class.m_lock, 1))
+   {
+      while (size_class.m_lock)
+         __asm__ __volatile__ ("pause");
+   }
+}
+
+void PacketBufferPool::unlockSizeClass(SizeClass& size_class)
+{
+   __sync_lock_release(&size_class.m_lock);
+}
@@ -0,0 +1,51 @@
+#ifndef PACKET_BUFFER_POOL_H
+#define PACKET_BUFFER_POOL_H
+
+#include "fixed_types.h"
+
+// Pooled, single-owner message buffers
+//
+// Every buffer handed to or returned by a Transport::Node comes from this
+// pool. Buffers are grouped into power-of-2 size classes and released
+// buffers are kept on per-class free lists, so the steady-state message path
+// does not go through malloc/free. A buffer has exactly one owner at a time,
+// which releases it exactly once; broadcasts are serialized into a separate
+// buffer per receiver, so buffers are never shared. Requests larger than the
+// biggest size class are served (and freed) directly by malloc.
+
+class PacketBufferPool
+{
+public:
+   // Returns a buffer of at least 'size' bytes owned by the caller
+   static Byte* allocate(UInt32 size);
+   static void release(Byte* buffer);
+
+private:
+   struct BufferHeader
+   {
+      UInt32 m_size_class;
+      volatile SInt32 m_in_use;      // Catches double releases
+      BufferHeader* m_next;
+   };
+
+   struct SizeClass
+   {
+      volatile SInt32 m_lock;
+      UInt32 m_num_free;
+      BufferHeader* m_free_list;
+   };
+
+   static const UInt32 MIN_BUFFER_SIZE_LOG2 = 6;   // 64 bytes
+   static const UInt32 NUM_SIZE_CLASSES = 8;       // Up to 8 KB
+   static const UInt32 MAX_FREE_BUFFERS = 4096;    // Per size class
+
+   // Plain data, so it is usable before and after static construction
+   static SizeClass m_size_classes[NUM_SIZE_CLASSES];
+
+   static UInt32 getSizeClass(UInt32 size);
+   static BufferHeader* getHeader(Byte* buffer);
+   static void lockSizeClass(SizeClass& size_class);
+   static void unlockSizeClass(SizeClass& size_class);
+};
+
+#endif // PACKET_BUFFER_POOL_H
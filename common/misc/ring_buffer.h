@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cassert>
+
+#include "fixed_types.h"
+
+// FIFO with a fixed, power-of-2 capacity. All the storage is allocated
+// up front, so push() and pop() never allocate. Not thread-safe.
+template<typename T>
+class RingBuffer
+{
+public:
+   RingBuffer(UInt32 capacity);
+   ~RingBuffer();
+
+   void push(const T& value);
+   void pop();
+   T& front();
+   T& operator[](UInt32 index);
+
+   UInt32 size() const     { return _tail - _head; }
+   UInt32 capacity() const { return _mask + 1; }
+   bool empty() const      { return _head == _tail; }
+   bool full() const       { return size() == capacity(); }
+
+private:
+   RingBuffer(const RingBuffer&);
+   RingBuffer& operator=(const RingBuffer&);
+
+   T* _elements;
+   UInt32 _mask;
+   // Indices only ever increase and wrap around naturally
+   UInt32 _head;
+   UInt32 _tail;
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(UInt32 capacity)
+   : _mask(capacity - 1)
+   , _head(0)
+   , _tail(0)
+{
+   assert((capacity > 0) && ((capacity & (capacity - 1)) == 0));
+   _elements = new T[capacity];
+}
+
+template <typename T>
+RingBuffer<T>::~RingBuffer()
+{
+   delete [] _elements;
+}
+
+template <typename T>
+void RingBuffer<T>::push(const T& value)
+{
+   assert(!full());
+   _elements[_tail & _mask] = value;
+   _tail ++;
+}
+
+template <typename T>
+void RingBuffer<T>::pop()
+{
+   assert(!empty());
+   _head ++;
+}
+
+template <typename T>
+T& RingBuffer<T>::front()
+{
+   assert(!empty());
+   return _elements[_head & _mask];
+}
+
+template <typename T>
+T& RingBuffer<T>::operator[](UInt32 index)
+{
+   // index 0 is the front
+   assert(index < size());
+   return _elements[(_head + index) & _mask];
+}
@@ -4,28 +4,58 @@
 #include "fixed_types.h"
 #include "log.h"
 
+// Clock of one frequency domain. The clock period is kept as an exact
+// fraction of picoseconds, derived once from the frequency (in GHz, rounded
+// to the nearest MHz), so converting between cycles and time takes only
+// integer arithmetic. Models that convert often keep one of these and
+// re-derive it when their frequency changes.
+class FrequencyDomain
+{
+   public:
+      explicit FrequencyDomain(float frequency = 0) { setFrequency(frequency); }
+
+      void setFrequency(float frequency);
+      float getFrequency() const { return _frequency; }
+
+      // Both conversions round up
+      UInt64 toPicosec(UInt64 cycles) const;
+      UInt64 toCycles(UInt64 picosec) const;
+
+      bool operator==(const FrequencyDomain& domain) const
+            { return (_period_num == domain._period_num) && (_period_den == domain._period_den); }
+      bool operator!=(const FrequencyDomain& domain) const
+            { return !(*this == domain); }
+
+   private:
+      float _frequency;
+      // Clock period is (_period_num / _period_den) picoseconds
+      UInt32 _period_num;
+      UInt32 _period_den;
+};
+
 class Latency
 {
    public:
-      Latency(UInt64 cycles = 0, float frequency = 0):_cycles(cycles), _frequency(frequency){};
+      Latency(UInt64 cycles = 0, float frequency = 0):_cycles(cycles), _domain(frequency){};
+      Latency(UInt64 cycles, const FrequencyDomain& domain):_cycles(cycles), _domain(domain){};
       Latency(const Latency& lat):_cycles(lat._cycles),
-                                  _frequency(lat._frequency) {};
+                                  _domain(lat._domain) {};
       ~Latency(){};
 
       Latency operator+(const Latency& lat) const;
 
       Latency operator=(const Latency& lat)
-            { return Latency(lat._cycles, lat._frequency);}
+            { _cycles = lat._cycles; _domain = lat._domain; return *this; }
 
       Latency operator+=(const Latency& lat);
 
-      UInt64 toPicosec() const;
+      UInt64 toPicosec() const { return _domain.toPicosec(_cycles); }
 
       UInt64 getCycles() const {return _cycles; }
 
    private:
       UInt64 _cycles;
-      float _frequency;
+      FrequencyDomain _domain;
 };
 
 class Time
@@ -71,7 +101,10 @@ class Time
 
       UInt64 getTime() const { return _picosec; }
 
-      UInt64 toCycles(float frequency) const;
+      UInt64 toCycles(float frequency) const
+            { return FrequencyDomain(frequency).toCycles(_picosec); }
+      UInt64 toCycles(const FrequencyDomain& domain) const
+            { return domain.toCycles(_picosec); }
 
       UInt64 toPicosec() const { return _picosec; }
 
@@ -82,37 +115,66 @@ class Time
 };
 
 
-inline UInt64 Latency::toPicosec() const
+inline void FrequencyDomain::setFrequency(float frequency)
 {
-   UInt64 picosec = (UInt64) ceil( ((double) 1000*_cycles) /  ((double) _frequency) );
+   _frequency = frequency;
+
+   UInt32 frequency_in_mhz = (UInt32) floor(((double) frequency) * 1000 + 0.5);
+   if (frequency_in_mhz == 0)
+   {
+      // No clock; every conversion gives 0
+      _period_num = 0;
+      _period_den = 1;
+      return;
+   }
+
+   // period = 10^6 / frequency_in_mhz picoseconds, in lowest terms
+   UInt32 num = 1000000;
+   UInt32 den = frequency_in_mhz;
+   while (den != 0)
+   {
+      UInt32 rem = num % den;
+      num = den;
+      den = rem;
+   }
+   _period_num = 1000000 / num;
+   _period_den = frequency_in_mhz / num;
+}
+
+inline UInt64 FrequencyDomain::toPicosec(UInt64 cycles) const
+{
+   if (_period_den == 1)
+      return cycles * _period_num;
+   // Split to keep the intermediate products small
+   return (cycles / _period_den) * _period_num +
+          ((cycles % _period_den) * _period_num + _period_den - 1) / _period_den;
+}
 
-   return picosec;
+inline UInt64 FrequencyDomain::toCycles(UInt64 picosec) const
+{
+   if (_period_num == 0)
+      return 0;
+   return (picosec / _period_num) * _period_den +
+          ((picosec % _period_num) * _period_den + _period_num - 1) / _period_num;
 }
 
 inline Latency Latency::operator+(const Latency& lat) const
 {
-   LOG_ASSERT_ERROR(_frequency == lat._frequency,
+   LOG_ASSERT_ERROR(_domain == lat._domain,
       "Attempting to add latencies from different frequencies");
 
-   return Latency(_cycles + lat._cycles, _frequency);
+   return Latency(_cycles + lat._cycles, _domain);
 }
 
 inline Latency Latency::operator+=(const Latency& lat)
 {
-   LOG_ASSERT_ERROR(_frequency == lat._frequency,
+   LOG_ASSERT_ERROR(_domain == lat._domain,
       "Attempting to add latencies from different frequencies");
    _cycles += lat._cycles;
    return *this;
 }
 
-inline UInt64 Time::toCycles(float frequency) const
-{
-   UInt64 cycles = (UInt64) ceil(((double) (_picosec) * ((double) frequency))/double(1000));
-
-   return cycles;
-}
-
 inline UInt64 Time::toNanosec() const
 {
-   return (UInt64) ceil(((double) _picosec)/double(1000));
+   return (_picosec + 999) / 1000;
 }
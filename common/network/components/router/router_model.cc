@@ -4,6 +4,7 @@
 #include "utils.h"
 #include "queue_model_history_list.h"
 #include "queue_model_history_tree.h"
+#include "queue_model_history_calendar.h"
 #include "log.h"
 #include "time_types.h"
 
@@ -13,6 +14,7 @@ RouterModel::RouterModel(NetworkModel* model, float frequency,
                          bool contention_model_enabled, string& contention_model_type)
    : _model(model)
    , _frequency(frequency)
+   , _frequency_domain(frequency)
    , _num_input_ports(num_input_ports)
    , _num_output_ports(num_output_ports)
    , _flit_width(flit_width)
@@ -86,7 +88,7 @@ RouterModel::processPacket(const NetPacket& pkt, vector<SInt32>& output_port_lis
       UInt64 max_queue_delay = 0;
       for (vector<SInt32>::iterator it = output_port_list.begin(); it != output_port_list.end(); it++)
       {
-         UInt64 queue_delay = _contention_model_list[*it]->computeQueueDelay(pkt.time.toCycles(_frequency), num_flits);
+         UInt64 queue_delay = _contention_model_list[*it]->computeQueueDelay(pkt.time.toCycles(_frequency_domain), num_flits);
          max_queue_delay = max<UInt64>(max_queue_delay, queue_delay);
       }
 
@@ -207,6 +209,11 @@ RouterModel::getPercentAnalyticalModelsUsed(SInt32 output_port_start, SInt32 out
          QueueModelHistoryTree* queue_model = (QueueModelHistoryTree*) _contention_model_list[i];
          total_analytical_model_requests += queue_model->getTotalRequestsUsingAnalyticalModel();
       }
+      else if (queue_model_type == QueueModel::HISTORY_CALENDAR)
+      {
+         QueueModelHistoryCalendar* queue_model = (QueueModelHistoryCalendar*) _contention_model_list[i];
+         total_analytical_model_requests += queue_model->getTotalRequestsUsingAnalyticalModel();
+      }
    }
 
    return (total_requests > 0) ? (((float) total_analytical_model_requests * 100) / total_requests) : 0.0;
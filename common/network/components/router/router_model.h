@@ -7,6 +7,7 @@ using std::vector;
 
 #include "fixed_types.h"
 #include "queue_model.h"
+#include "time_types.h"
 #include "router_power_model.h"
 
 class NetworkModel;
@@ -49,6 +50,7 @@ public:
 private:
    NetworkModel* _model;
    float _frequency;
+   FrequencyDomain _frequency_domain;
    SInt32 _num_input_ports;
    SInt32 _num_output_ports;
    SInt32 _flit_width;
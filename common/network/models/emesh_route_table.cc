@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "emesh_route_table.h"
+#include "config.h"
+#include "log.h"
+
+EMeshRouteTable* EMeshRouteTable::_singleton = NULL;
+
+EMeshRouteTable*
+EMeshRouteTable::getSingleton()
+{
+   if (_singleton == NULL)
+      _singleton = new EMeshRouteTable((SInt32) Config::getSingleton()->getApplicationTiles());
+   return _singleton;
+}
+
+EMeshRouteTable::EMeshRouteTable(SInt32 num_tiles)
+   : _num_tiles(num_tiles)
+{
+   _mesh_width = (SInt32) floor (sqrt(num_tiles));
+   _mesh_height = (SInt32) ceil (1.0 * num_tiles / _mesh_width);
+   LOG_ASSERT_ERROR((_mesh_width + _mesh_height) < (1 << (16 - _DIRECTION_BITS)),
+                    "Mesh Width(%i), Mesh Height(%i) too large for the route table", _mesh_width, _mesh_height);
+
+   _tile_offsets[SELF] = 0;
+   _tile_offsets[LEFT] = -1;
+   _tile_offsets[RIGHT] = 1;
+   _tile_offsets[DOWN] = -_mesh_width;
+   _tile_offsets[UP] = _mesh_width;
+
+   if ((UInt32) num_tiles > MAX_TABLE_TILES)
+      return;
+
+   _entries.resize(num_tiles * num_tiles);
+   for (tile_id_t tile = 0; tile < num_tiles; tile++)
+   {
+      for (tile_id_t dest = 0; dest < num_tiles; dest++)
+         _entries[tile * num_tiles + dest] = computeEntry(tile, dest);
+   }
+}
+
+UInt16
+EMeshRouteTable::computeEntry(tile_id_t tile, tile_id_t dest) const
+{
+   SInt32 cx = tile % _mesh_width;
+   SInt32 cy = tile / _mesh_width;
+   SInt32 dx = dest % _mesh_width;
+   SInt32 dy = dest / _mesh_width;
+
+   // Route along X first, then along Y
+   OutputDirection direction;
+   if (cx > dx)
+      direction = LEFT;
+   else if (cx < dx)
+      direction = RIGHT;
+   else if (cy > dy)
+      direction = DOWN;
+   else if (cy < dy)
+      direction = UP;
+   else
+      direction = SELF;
+
+   UInt32 distance = abs(cx - dx) + abs(cy - dy);
+   return (UInt16) ((distance << _DIRECTION_BITS) | direction);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "fixed_types.h"
+
+// XY (dimension-ordered) routes between every pair of application tiles of
+// an electrical mesh, computed once per process and shared by the emesh
+// network models. Each (current tile, destination tile) entry packs the
+// remaining number of hops together with the output port the packet takes
+// out of the current tile. The next tile follows from the port, so a whole
+// route is a chain of lookups.
+//
+// Meshes with more than MAX_TABLE_TILES tiles do not store a table; the
+// entries are then computed on every lookup.
+
+class EMeshRouteTable
+{
+public:
+   // Same order as the router output ports of the emesh models
+   enum OutputDirection
+   {
+      SELF = 0,
+      LEFT,
+      RIGHT,
+      DOWN,
+      UP,
+      NUM_OUTPUT_DIRECTIONS
+   };
+
+   static EMeshRouteTable* getSingleton();
+
+   SInt32 getMeshWidth() const { return _mesh_width; }
+   SInt32 getMeshHeight() const { return _mesh_height; }
+
+   UInt32 getDistance(tile_id_t tile, tile_id_t dest) const
+   { return getEntry(tile, dest) >> _DIRECTION_BITS; }
+   OutputDirection getOutputDirection(tile_id_t tile, tile_id_t dest) const
+   { return (OutputDirection) (getEntry(tile, dest) & _DIRECTION_MASK); }
+   tile_id_t getNextTile(tile_id_t tile, OutputDirection direction) const
+   { return tile + _tile_offsets[direction]; }
+
+private:
+   static const UInt32 MAX_TABLE_TILES = 4096;
+   static const UInt32 _DIRECTION_BITS = 3;
+   static const UInt16 _DIRECTION_MASK = (1 << _DIRECTION_BITS) - 1;
+
+   EMeshRouteTable(SInt32 num_tiles);
+
+   UInt16 getEntry(tile_id_t tile, tile_id_t dest) const
+   {
+      return _entries.empty() ? computeEntry(tile, dest) : _entries[tile * _num_tiles + dest];
+   }
+   UInt16 computeEntry(tile_id_t tile, tile_id_t dest) const;
+
+   static EMeshRouteTable* _singleton;
+
+   SInt32 _num_tiles;
+   SInt32 _mesh_width;
+   SInt32 _mesh_height;
+   SInt32 _tile_offsets[NUM_OUTPUT_DIRECTIONS];
+   vector<UInt16> _entries;
+};
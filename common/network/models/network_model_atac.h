@@ -26,6 +26,7 @@ public:
    static bool isTileCountPermissible(SInt32 tile_count);
    static pair<bool, vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
    static pair<bool, vector<vector<tile_id_t> > > computeProcessToTileMapping();
+   static Time computeMinimumHopLatency();
 
    void outputSummary(std::ostream &out);
 
@@ -2,6 +2,7 @@
 using namespace std;
 
 #include "network_model_emesh_hop_by_hop.h"
+#include "emesh_route_table.h"
 #include "tile.h"
 #include "simulator.h"
 #include "config.h"
@@ -11,6 +12,7 @@ using namespace std;
 bool NetworkModelEMeshHopByHop::_initialized = false;
 SInt32 NetworkModelEMeshHopByHop::_mesh_width;
 SInt32 NetworkModelEMeshHopByHop::_mesh_height;
+EMeshRouteTable* NetworkModelEMeshHopByHop::_route_table;
 bool NetworkModelEMeshHopByHop::_contention_model_enabled;
 
 NetworkModelEMeshHopByHop::NetworkModelEMeshHopByHop(Network* net, SInt32 network_id)
@@ -30,6 +32,7 @@ NetworkModelEMeshHopByHop::NetworkModelEMeshHopByHop(Network* net, SInt32 networ
    {
       LOG_PRINT_ERROR("Could not read emesh_hop_by_hop parameters from the configuration file");
    }
+   _frequency_domain.setFrequency(_frequency);
 
    // Initialize Topology Params
    initializeEMeshTopologyParams();
@@ -54,8 +57,10 @@ NetworkModelEMeshHopByHop::initializeEMeshTopologyParams()
 
    SInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
 
-   _mesh_width = (SInt32) floor (sqrt(num_application_tiles));
-   _mesh_height = (SInt32) ceil (1.0 * num_application_tiles / _mesh_width);
+   // Unicast routes are looked up, not recomputed at every hop
+   _route_table = EMeshRouteTable::getSingleton();
+   _mesh_width = _route_table->getMeshWidth();
+   _mesh_height = _route_table->getMeshHeight();
    LOG_ASSERT_ERROR(num_application_tiles == (_mesh_width * _mesh_height),
          "Num Application Tiles(%i), Mesh Width(%i), Mesh Height(%i)",
          num_application_tiles, _mesh_width, _mesh_height);
@@ -153,7 +158,7 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
       UInt64 contention_delay = 0;
       _injection_router->processPacket(pkt, 0, zero_load_delay, contention_delay);
       
-      Hop hop(pkt, _tile_id, EMESH, Latency(0,_frequency), Latency(contention_delay,_frequency));
+      Hop hop(pkt, _tile_id, EMESH, Latency(0,_frequency_domain), Latency(contention_delay,_frequency_domain));
       next_hops.push(hop);
    }
 
@@ -214,29 +219,20 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
          // Populate the next_hops queue
          for (list<NextDest>::iterator it = next_dest_list.begin(); it != next_dest_list.end(); it++)
          {
-            Hop hop(pkt, (*it)._tile_id, (*it)._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+            Hop hop(pkt, (*it)._tile_id, (*it)._node_type, Latency(zero_load_delay,_frequency_domain), Latency(contention_delay,_frequency_domain));
             next_hops.push(hop);
          }
       }
 
       else // (pkt_receiver != NetPacket::BROADCAST)
       {
-         SInt32 cx, cy, dx, dy;
-         computePosition(_tile_id, cx, cy);
-         computePosition(pkt_receiver, dx, dy);
+         EMeshRouteTable::OutputDirection direction = _route_table->getOutputDirection(_tile_id, pkt_receiver);
 
          NextDest next_dest;
-
-         if (cx > dx)
-            next_dest = NextDest(computeTileID(cx-1,cy), LEFT, EMESH);
-         else if (cx < dx)
-            next_dest = NextDest(computeTileID(cx+1,cy), RIGHT, EMESH);
-         else if (cy > dy)
-            next_dest = NextDest(computeTileID(cx,cy-1), DOWN, EMESH);
-         else if (cy < dy)
-            next_dest = NextDest(computeTileID(cx,cy+1), UP, EMESH);
-         else
+         if (direction == EMeshRouteTable::SELF)
             next_dest = NextDest(_tile_id, SELF, RECEIVE_TILE);
+         else
+            next_dest = NextDest(_route_table->getNextTile(_tile_id, direction), direction, EMESH);
 
          UInt64 zero_load_delay = 0;
          UInt64 contention_delay = 0;
@@ -249,7 +245,7 @@ NetworkModelEMeshHopByHop::routePacket(const NetPacket &pkt, queue<Hop> &next_ho
          _mesh_link_list[next_dest._output_port]->processPacket(pkt, zero_load_delay);
 
          assert(next_dest._tile_id != INVALID_TILE_ID);
-         Hop hop(pkt, next_dest._tile_id, next_dest._node_type, Latency(zero_load_delay,_frequency), Latency(contention_delay,_frequency));
+         Hop hop(pkt, next_dest._tile_id, next_dest._node_type, Latency(zero_load_delay,_frequency_domain), Latency(contention_delay,_frequency_domain));
          next_hops.push(hop);
       
       } // (pkt_receiver == NetPacket::BROADCAST)
@@ -281,17 +277,7 @@ NetworkModelEMeshHopByHop::computeTileID(SInt32 x, SInt32 y)
 SInt32
 NetworkModelEMeshHopByHop::computeDistance(tile_id_t sender, tile_id_t receiver)
 {
-   SInt32 num_application_tiles = (SInt32) Config::getSingleton()->getApplicationTiles();
-   SInt32 mesh_width = (SInt32) floor(sqrt(1.0 * num_application_tiles));
-   __attribute__((__unused__)) SInt32 mesh_height = (SInt32) ceil(1.0 * num_application_tiles / mesh_width);
-
-   SInt32 sx, sy, dx, dy;
-   sx = sender % mesh_width;
-   sy = sender / mesh_width;
-   dx = receiver % mesh_width;
-   dy = receiver / mesh_width;
-
-   return abs(sx-dx) + abs(sy-dy);
+   return EMeshRouteTable::getSingleton()->getDistance(sender, receiver);
 }
 
 void
@@ -431,6 +417,25 @@ NetworkModelEMeshHopByHop::computeProcessToTileMapping()
    return (make_pair(true, process_to_tile_mapping));
 }
 
+Time
+NetworkModelEMeshHopByHop::computeMinimumHopLatency()
+{
+   float frequency = 0.0;
+   UInt64 router_delay = 0;
+   UInt64 link_delay = 0;
+   try
+   {
+      frequency = Sim()->getCfg()->getFloat("network/emesh_hop_by_hop/frequency");
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh_hop_by_hop/router/delay");
+      link_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh_hop_by_hop/link/delay");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read emesh_hop_by_hop link and router parameters");
+   }
+   return Time(Latency(router_delay + link_delay, frequency));
+}
+
 void
 NetworkModelEMeshHopByHop::outputEventCountSummary(ostream& out)
 {
@@ -13,6 +13,8 @@ using std::ostream;
 #include "router_model.h"
 #include "electrical_link_model.h"
 
+class EMeshRouteTable;
+
 class NetworkModelEMeshHopByHop : public NetworkModel
 {
 public:
@@ -22,6 +24,7 @@ public:
    static bool isTileCountPermissible(SInt32 tile_count);
    static pair<bool,vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
    static pair<bool,vector<Config::TileList> > computeProcessToTileMapping();
+   static Time computeMinimumHopLatency();
 
    void outputSummary(std::ostream &out);
 
@@ -33,6 +36,7 @@ private:
       EMESH = 2 // Always Start at 2
    };
 
+   // Same values as EMeshRouteTable::OutputDirection
    enum OutputDirection
    {
       SELF = 0,
@@ -46,6 +50,7 @@ private:
    static bool _initialized;
    static SInt32 _mesh_width;
    static SInt32 _mesh_height;
+   static EMeshRouteTable* _route_table;
 
    // Is contention model enabled?
    static bool _contention_model_enabled;
@@ -2,6 +2,7 @@
 #include <math.h>
 
 #include "network_model_emesh_hop_counter.h"
+#include "emesh_route_table.h"
 #include "simulator.h"
 #include "config.h"
 #include "config.h"
@@ -15,8 +16,10 @@ NetworkModelEMeshHopCounter::NetworkModelEMeshHopCounter(Network *net, SInt32 ne
 {
    SInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
 
-   _mesh_width = (SInt32) floor (sqrt(num_application_tiles));
-   _mesh_height = (SInt32) ceil (1.0 * num_application_tiles / _mesh_width);
+   // Hop counts come from the shared route table
+   _route_table = EMeshRouteTable::getSingleton();
+   _mesh_width = _route_table->getMeshWidth();
+   _mesh_height = _route_table->getMeshHeight();
 
    assert(num_application_tiles <= _mesh_width * _mesh_height);
    assert(num_application_tiles > (_mesh_width - 1) * _mesh_height);
@@ -31,6 +34,7 @@ NetworkModelEMeshHopCounter::NetworkModelEMeshHopCounter(Network *net, SInt32 ne
    {
       LOG_PRINT_ERROR("Could not read emesh_hop_counter paramters from the cfg file");
    }
+   _frequency_domain.setFrequency(_frequency);
 
    // Broadcast Capability
    _has_broadcast_capability = false;
@@ -47,6 +51,25 @@ NetworkModelEMeshHopCounter::~NetworkModelEMeshHopCounter()
    destroyRouterAndLinkModels();
 }
 
+Time
+NetworkModelEMeshHopCounter::computeMinimumHopLatency()
+{
+   float frequency = 0.0;
+   UInt64 router_delay = 0;
+   UInt64 link_delay = 0;
+   try
+   {
+      frequency = Sim()->getCfg()->getFloat("network/emesh_hop_counter/frequency");
+      router_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh_hop_counter/router/delay");
+      link_delay = (UInt64) Sim()->getCfg()->getInt("network/emesh_hop_counter/link/delay");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read emesh_hop_counter link and router parameters");
+   }
+   return Time(Latency(router_delay + link_delay, frequency));
+}
+
 void
 NetworkModelEMeshHopCounter::createRouterAndLinkModels()
 {
@@ -127,29 +150,11 @@ NetworkModelEMeshHopCounter::updateEventCounters(UInt32 num_flits, UInt32 num_ho
    _link_traversals += (num_flits * num_hops);
 }
 
-void
-NetworkModelEMeshHopCounter::computePosition(tile_id_t tile, SInt32 &x, SInt32 &y)
-{
-   x = tile % _mesh_width;
-   y = tile / _mesh_width;
-}
-
-SInt32
-NetworkModelEMeshHopCounter::computeDistance(SInt32 x1, SInt32 y1, SInt32 x2, SInt32 y2)
-{
-   return abs(x1 - x2) + abs(y1 - y2);
-}
-
 void
 NetworkModelEMeshHopCounter::routePacket(const NetPacket &pkt, queue<Hop> &next_hops)
 {
-   SInt32 sx, sy, dx, dy;
-
-   computePosition(TILE_ID(pkt.sender), sx, sy);
-   computePosition(TILE_ID(pkt.receiver), dx, dy);
-
-   UInt32 num_hops = computeDistance(sx, sy, dx, dy);
-   Latency latency = (isModelEnabled(pkt)) ? Latency(num_hops * _hop_latency,_frequency) : Latency(0,_frequency);
+   UInt32 num_hops = _route_table->getDistance(TILE_ID(pkt.sender), TILE_ID(pkt.receiver));
+   Latency latency = (isModelEnabled(pkt)) ? Latency(num_hops * _hop_latency,_frequency_domain) : Latency(0,_frequency_domain);
 
    updateDynamicEnergy(pkt, num_hops);
 
@@ -6,6 +6,8 @@
 #include "electrical_link_power_model.h"
 #include "lock.h"
 
+class EMeshRouteTable;
+
 class NetworkModelEMeshHopCounter : public NetworkModel
 {
 public:
@@ -15,10 +17,13 @@ public:
    void routePacket(const NetPacket &pkt, queue<Hop> &next_hops);
    void outputSummary(std::ostream &out);
 
+   static Time computeMinimumHopLatency();
+
 private:
    // Topolgy parameters
    SInt32 _mesh_width;
    SInt32 _mesh_height;
+   EMeshRouteTable* _route_table;
    static const UInt32 _NUM_OUTPUT_DIRECTIONS = 5;
 
    // Electrical router and link power models
@@ -39,8 +44,6 @@ private:
    void initializeEventCounters();
    void destroyRouterAndLinkModels();
    
-   void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
-   SInt32 computeDistance(SInt32 x1, SInt32 y1, SInt32 x2, SInt32 y2);
    void updateDynamicEnergy(const NetPacket& packet, UInt32 num_hops);
    void updateEventCounters(UInt32 num_flits, UInt32 num_hops);
    
@@ -6,6 +6,7 @@ NetworkModelMagic::NetworkModelMagic(Network *net, SInt32 network_id)
    : NetworkModel(net, network_id)
 {
    _frequency = 1.0;
+   _frequency_domain.setFrequency(_frequency);
    _flit_width = -1;
    _has_broadcast_capability = false;
 }
@@ -18,7 +19,7 @@ NetworkModelMagic::routePacket(const NetPacket &pkt, queue<Hop> &next_hops)
 {
    LOG_PRINT("Entering routePacket");
    // A latency of '1'
-   Hop hop(pkt, TILE_ID(pkt.receiver), RECEIVE_TILE, Latency(1,_frequency), Latency(0,_frequency));
+   Hop hop(pkt, TILE_ID(pkt.receiver), RECEIVE_TILE, Latency(1,_frequency_domain), Latency(0,_frequency_domain));
    next_hops.push(hop);
 }
 
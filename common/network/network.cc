@@ -1,5 +1,6 @@
 #include <cstring>
 #include "transport.h"
+#include "packet_buffer_pool.h"
 #include "tile.h"
 #include "core_model.h"
 #include "network.h"
@@ -98,69 +99,74 @@ void Network::netPullFromTransport()
    {
       LOG_PRINT("Entering netPullFromTransport");
 
-      NetPacket packet(_transport->recv());
+      // Drain a batch of packets per wakeup
+      Byte* buffers[MAX_TRANSPORT_RECV_BATCH];
+      UInt32 num_buffers = _transport->recvMany(buffers, MAX_TRANSPORT_RECV_BATCH);
 
-      LOG_PRINT("Pull packet : type %i, from (%i, %i), time %llu",
-                (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time.toNanosec());
-      LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
-                       "Invalid Packet Sender(%i)", packet.sender);
-      LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
-                       "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
+      for (UInt32 i = 0; i < num_buffers; i++)
+      {
+         NetPacket packet(buffers[i]);
+
+         LOG_PRINT("Pull packet : type %i, from (%i, %i), time %llu",
+                   (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time.toNanosec());
+         LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
+                          "Invalid Packet Sender(%i)", packet.sender);
+         LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
+                          "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
 
-      NetworkModel* model = getNetworkModelFromPacketType(packet.type);
+         NetworkModel* model = getNetworkModelFromPacketType(packet.type);
    
-      if (model->isPacketReadyToBeReceived(packet))   // Receive Packet
-      {
-         // I have accepted the packet - process the received packet
-         model->__processReceivedPacket(packet);
+         if (model->isPacketReadyToBeReceived(packet))   // Receive Packet
+         {
+            // I have accepted the packet - process the received packet
+            model->__processReceivedPacket(packet);
          
-         // asynchronous I/O support
-         NetworkCallback callback = _callbacks[packet.type];
+            // asynchronous I/O support
+            NetworkCallback callback = _callbacks[packet.type];
 
-         if (callback != NULL)
-         {
-            LOG_PRINT("Executing callback on packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu", 
-                      (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
-                      packet.receiver.tile_id, packet.receiver.core_type,
-                      _tile->getId(), packet.time.toNanosec());
-            assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
-            assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
+            if (callback != NULL)
+            {
+               LOG_PRINT("Executing callback on packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu", 
+                         (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
+                         packet.receiver.tile_id, packet.receiver.core_type,
+                         _tile->getId(), packet.time.toNanosec());
+               assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
+               assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
 
-            callback(_callbackObjs[packet.type], packet);
+               callback(_callbackObjs[packet.type], packet);
 
-            // De-allocate packet payload
-            if (packet.length > 0)
-               delete [] (Byte*) packet.data;
-         }
+               // De-allocate packet payload
+               packet.release();
+            }
 
-         // synchronous I/O support
-         else
-         {
-            LOG_PRINT("Enqueuing packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu",
-                      (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type,
-                      packet.receiver.tile_id, packet.receiver.core_type,
-                      _tile->getId(), packet.time.toNanosec());
+            // synchronous I/O support
+            else
+            {
+               LOG_PRINT("Enqueuing packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu",
+                         (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type,
+                         packet.receiver.tile_id, packet.receiver.core_type,
+                         _tile->getId(), packet.time.toNanosec());
 
-            _netQueueLock.acquire();
-            _netQueue.push_back(packet);
-            _netQueueLock.release();
+               _netQueueLock.acquire();
+               _netQueue.push_back(packet);
+               _netQueueLock.release();
 
-            _netQueueCond.broadcast();
+               _netQueueCond.broadcast();
+            }
          }
-      }
 
-      else // Forward Packet
-      { 
-         LOG_PRINT("Forwarding packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu.", 
-                   (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
-                   packet.receiver.tile_id, packet.receiver.core_type,
-                   _tile->getId(), packet.time.toNanosec());
+         else // Forward Packet
+         { 
+            LOG_PRINT("Forwarding packet : type %i, from (%i, %i), to (%i, %i), tile_id %i, time %llu.", 
+                      (SInt32) packet.type, packet.sender.tile_id, packet.sender.core_type,
+                      packet.receiver.tile_id, packet.receiver.core_type,
+                      _tile->getId(), packet.time.toNanosec());
 
-         forwardPacket(packet);
+            forwardPacket(packet);
          
-         // De-allocate packet payload
-         if (packet.length > 0)
-            delete [] (Byte*) packet.data;
+            // De-allocate packet payload
+            packet.release();
+         }
       }
    }
    while (_transport->query());
@@ -243,11 +249,22 @@ SInt32 Network::forwardPacket(const NetPacket& packet)
                    hop._next_tile_id,
                    _tile->getId(), hop._time.toNanosec());
          
-         _transport->send(hop._next_tile_id, buffer, packet.bufferSize());
+         // The last hop takes over the buffer, earlier ones get a copy
+         // since the header is rewritten for every hop
+         if (hop_queue.empty())
+         {
+            _transport->sendBuffer(hop._next_tile_id, buffer, packet.bufferSize());
+            buffer = NULL;
+         }
+         else
+         {
+            _transport->send(hop._next_tile_id, buffer, packet.bufferSize());
+         }
       }
    }
 
-   delete [] buffer;
+   if (buffer)
+      PacketBufferPool::release(buffer);
 
    return packet.length;
 }
@@ -679,15 +696,19 @@ NetPacket::NetPacket(Byte *buffer)
 {
    memcpy(this, buffer, sizeof(*this));
 
+   // The payload stays in the transport buffer, which is returned to the
+   // pool by release()
    // LOG_ASSERT_ERROR(length > 0, "type(%u), sender(%i), receiver(%i), length(%u)", type, sender, receiver, length);
    if (length > 0)
-   {
-      Byte* data_buffer = new Byte[length];
-      memcpy(data_buffer, buffer + sizeof(*this), length);
-      data = data_buffer;
-   }
+      data = buffer + sizeof(*this);
+   else
+      PacketBufferPool::release(buffer);
+}
 
-   delete [] buffer;
+void NetPacket::release()
+{
+   if (length > 0)
+      PacketBufferPool::release((Byte*) data - sizeof(*this));
 }
 
 // This implementation is slightly wasteful because there is no need
@@ -703,7 +724,7 @@ Byte* NetPacket::makeBuffer() const
    UInt32 size = bufferSize();
    assert(size >= sizeof(NetPacket));
 
-   Byte *buffer = new Byte[size];
+   Byte *buffer = PacketBufferPool::allocate(size);
 
    memcpy(buffer, this, sizeof(*this));
    memcpy(buffer + sizeof(*this), data, length);
@@ -47,7 +47,11 @@ public:
    NetPacket(Time time, PacketType type, SInt32 sender, 
              SInt32 receiver, UInt32 length, const void *data);
 
+   // Frees the payload of a packet received from the network
+   void release();
+
    UInt32 bufferSize() const;
+   // The buffer comes from the PacketBufferPool
    Byte *makeBuffer() const;
 
    static const SInt32 BROADCAST = 0xDEADBABE;
@@ -141,6 +145,9 @@ private:
    // Is shortCut available through shared memory
    bool _sharedMemoryShortcutEnabled;
 
+   // Max number of packets pulled from the transport per wakeup
+   static const UInt32 MAX_TRANSPORT_RECV_BATCH = 32;
+
    SInt32 forwardPacket(const NetPacket& packet);
    
    // -- Network Injection/Ejection Rate Trace -- //
@@ -137,8 +137,8 @@ NetworkModel::processReceivedPacket(NetPacket& pkt)
    // Add serialization latency due to finite link bandwidth
    UInt64 num_flits = computeNumFlits(getModeledLength(pkt));
 
-   pkt.time += Latency(num_flits,_frequency);
-   pkt.zero_load_delay += Latency(num_flits,_frequency);
+   pkt.time += Latency(num_flits,_frequency_domain);
+   pkt.zero_load_delay += Latency(num_flits,_frequency_domain);
 }
 
 void
@@ -284,12 +284,12 @@ NetworkModel::outputSummary(ostream& out)
       UInt64 total_contention_delay_in_ns = _total_contention_delay.toNanosec();
 
       out << "    Average Packet Latency (in clock cycles): " <<
-         ((float) _total_packet_latency.toCycles(_frequency)) / _total_packets_received << endl;
+         ((float) _total_packet_latency.toCycles(_frequency_domain)) / _total_packets_received << endl;
       out << "    Average Packet Latency (in nanoseconds): " <<
          ((float) total_packet_latency_in_ns) / _total_packets_received << endl;
 
       out << "    Average Contention Delay (in clock cycles): " <<
-         ((float) _total_contention_delay.toCycles(_frequency)) / _total_packets_received << endl;
+         ((float) _total_contention_delay.toCycles(_frequency_domain)) / _total_packets_received << endl;
       out << "    Average Contention Delay (in nanoseconds): " <<
          ((float) total_contention_delay_in_ns) / _total_packets_received << endl;
    }
@@ -398,6 +398,31 @@ NetworkModel::computeProcessToTileMapping(UInt32 network_type)
    }
 }
 
+Time
+NetworkModel::computeMinimumHopLatency(UInt32 network_type)
+{
+   switch (network_type)
+   {
+      case NETWORK_MAGIC:
+         // See NetworkModelMagic::routePacket
+         return Time(Latency(1, 1.0));
+
+      case NETWORK_EMESH_HOP_COUNTER:
+         return NetworkModelEMeshHopCounter::computeMinimumHopLatency();
+
+      case NETWORK_EMESH_HOP_BY_HOP:
+         return NetworkModelEMeshHopByHop::computeMinimumHopLatency();
+
+      case NETWORK_ATAC:
+         return NetworkModelAtac::computeMinimumHopLatency();
+
+      default:
+         fprintf(stderr, "*ERROR* Unrecognized network type(%u)\n", network_type);
+         abort();
+         return Time(0);
+   }
+}
+
 bool
 NetworkModel::processCornerCases(const NetPacket& pkt, queue<Hop>& next_hops)
 {
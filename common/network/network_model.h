@@ -80,6 +80,8 @@ public:
    static bool isTileCountPermissible(UInt32 network_type, SInt32 tile_count);
    static pair<bool, vector<tile_id_t> > computeMemoryControllerPositions(UInt32 network_type, SInt32 num_memory_controllers, SInt32 total_tiles);
    static pair<bool, vector<Config::TileList> > computeProcessToTileMapping(UInt32 network_type);
+   // Lower bound on the latency of any packet sent on the network (one hop at zero load)
+   static Time computeMinimumHopLatency(UInt32 network_type);
 
    // SEND_TILE, RECEIVE_TILE
    static const SInt32 SEND_TILE = 0;
@@ -92,6 +94,8 @@ public:
    // Compute Number of Flits
    SInt32 computeNumFlits(UInt32 pkt_length);
 
+   UInt64 getTotalPacketsSent() const { return _total_packets_sent; }
+
    // Tracing Network Injection/Ejection Rate
    void popCurrentUtilizationStatistics(UInt64& total_flits_sent, UInt64& total_flits_broadcasted, UInt64& total_flits_received);
 
@@ -112,6 +116,8 @@ protected:
 
    // Frequency
    float _frequency;
+   // Set from _frequency by the constructor of each model
+   FrequencyDomain _frequency_domain;
    // Flit Width
    SInt32 _flit_width;
    // Has Broadcast Capability
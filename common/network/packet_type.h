@@ -10,6 +10,7 @@ enum PacketType
    SHARED_MEM,
    FREQ_CONTROL,
    SIM_THREAD_TERMINATE_THREADS,
+   SIM_THREAD_PAUSE_THREADS,
    MCP_REQUEST_TYPE,
    MCP_RESPONSE_TYPE,
    MCP_SYSTEM_TYPE,
@@ -26,6 +27,7 @@ enum PacketType
    SYSTEM_INITIALIZATION_ACK,
    SYSTEM_INITIALIZATION_FINI,
    CLOCK_SKEW_MANAGEMENT,
+   SYNC_REQUEST_TYPE,
    NUM_PACKET_TYPES
 };
 
@@ -57,6 +59,7 @@ static EStaticNetwork g_type_to_static_network_map[] __attribute__((unused)) =
    STATIC_NETWORK_MEMORY,        // SHARED_MEM
    STATIC_NETWORK_FREQ_CONTROL,  // FREQ_CONTROL
    STATIC_NETWORK_SYSTEM,        // ST_TERMINATE_THREADS
+   STATIC_NETWORK_SYSTEM,        // ST_PAUSE_THREADS
    STATIC_NETWORK_USER,          // MCP_REQ
    STATIC_NETWORK_USER,          // MCP_RESP
    STATIC_NETWORK_SYSTEM,        // MCP_SYSTEM
@@ -72,7 +75,8 @@ static EStaticNetwork g_type_to_static_network_map[] __attribute__((unused)) =
    STATIC_NETWORK_SYSTEM,        // SYSTEM_INITIALIZATION_NOTIFY
    STATIC_NETWORK_SYSTEM,        // SYSTEM_INITIALIZATION_ACK
    STATIC_NETWORK_SYSTEM,        // SYSTEM_INITIALIZATION_FINI
-   STATIC_NETWORK_SYSTEM         // CLOCK_SKEW_MANAGEMENT
+   STATIC_NETWORK_SYSTEM,        // CLOCK_SKEW_MANAGEMENT
+   STATIC_NETWORK_USER           // SYNC_REQUEST
 };
 
 #endif
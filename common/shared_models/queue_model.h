@@ -11,7 +11,8 @@ public:
    {
       BASIC = 0,
       HISTORY_LIST,
-      HISTORY_TREE
+      HISTORY_TREE,
+      HISTORY_CALENDAR
    };
 
    QueueModel(Type type);
@@ -0,0 +1,208 @@
+#include <cstring>
+#include <cassert>
+
+#include "simulator.h"
+#include "config.h"
+#include "queue_model_history_calendar.h"
+#include "utils.h"
+#include "log.h"
+
+QueueModelHistoryCalendar::QueueModelHistoryCalendar(UInt64 min_processing_time)
+   : QueueModel(HISTORY_CALENDAR)
+   , _window_start(0)
+   , _head_word(0)
+   , _total_requests_using_analytical_model(0)
+{
+   // Gaps of any size are tracked exactly, so min_processing_time is not needed
+   try
+   {
+      _window_size = Sim()->getCfg()->getInt("queue_model/history_calendar/window_size");
+      _analytical_model_enabled = Sim()->getCfg()->getBool("queue_model/history_calendar/analytical_model_enabled");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Could not read queue_model/history_calendar parameters from the cfg file");
+   }
+
+   _num_words = _window_size / 64;
+   LOG_ASSERT_ERROR(isPower2(_num_words) && (_num_words >= 64),
+                    "queue_model/history_calendar/window_size(%llu) must be a power of 2 and at least 4096",
+                    _window_size);
+
+   _busy_words = new UInt64[_num_words];
+   _full_words = new UInt64[_num_words / 64];
+   memset(_busy_words, 0, _num_words * sizeof(UInt64));
+   memset(_full_words, 0, (_num_words / 64) * sizeof(UInt64));
+
+   _queue_model_m_g_1 = new QueueModelMG1();
+}
+
+QueueModelHistoryCalendar::~QueueModelHistoryCalendar()
+{
+   delete _queue_model_m_g_1;
+   delete [] _full_words;
+   delete [] _busy_words;
+}
+
+UInt64
+QueueModelHistoryCalendar::computeQueueDelay(UInt64 pkt_time, UInt64 processing_time, tile_id_t requester)
+{
+   LOG_PRINT("Packet(%llu,%llu)", pkt_time, processing_time);
+   LOG_ASSERT_ERROR(processing_time <= (_window_size / 2),
+                    "Processing time(%llu) too large for window size(%llu)", processing_time, _window_size);
+
+   UInt64 queue_delay;
+
+   if ( _analytical_model_enabled && ((pkt_time + processing_time) <= _window_start) )
+   {
+      // The history for this request has already been discarded
+      _total_requests_using_analytical_model ++;
+      queue_delay = _queue_model_m_g_1->computeQueueDelay(pkt_time, processing_time, requester);
+   }
+   else
+   {
+      UInt64 start_time = findFreeSlot(max<UInt64>(pkt_time, _window_start), processing_time);
+      markBusy(start_time, processing_time);
+      queue_delay = start_time - pkt_time;
+   }
+
+   _queue_model_m_g_1->updateQueue(pkt_time, processing_time, queue_delay);
+
+   // Update Utilization Counters
+   updateQueueUtilizationCounters(pkt_time, processing_time, queue_delay);
+
+   LOG_PRINT("Packet(%llu,%llu) -> Queue Delay(%llu)", pkt_time, processing_time, queue_delay);
+
+   return queue_delay;
+}
+
+UInt64
+QueueModelHistoryCalendar::findFreeSlot(UInt64 start, UInt64 length)
+{
+   // Everything beyond the end of the window is free
+   UInt64 cycle = start;
+   while (cycle < getWindowEnd())
+   {
+      cycle = getNextFreeCycle(cycle);
+      if (cycle >= getWindowEnd())
+         break;
+
+      UInt64 end = min<UInt64>(cycle + length, getWindowEnd());
+      UInt64 busy_cycle = getNextBusyCycle(cycle, end);
+      if (busy_cycle == end)
+         break;
+
+      cycle = busy_cycle;
+   }
+   return cycle;
+}
+
+void
+QueueModelHistoryCalendar::markBusy(UInt64 start, UInt64 length)
+{
+   if (length == 0)
+      return;
+
+   if ((start + length) > getWindowEnd())
+      slideWindow(start + length);
+   assert(start >= _window_start);
+
+   UInt64 offset = start - _window_start;
+   UInt64 end_offset = offset + length;
+   while (offset < end_offset)
+   {
+      UInt32 word = offset >> 6;
+      UInt32 first_bit = offset & 63;
+      UInt32 num_bits = min<UInt64>(64 - first_bit, end_offset - offset);
+      UInt64 mask = (num_bits == 64) ? ~0ULL : (((1ULL << num_bits) - 1) << first_bit);
+
+      UInt32 physical_word = getPhysicalWord(word);
+      _busy_words[physical_word] |= mask;
+      if (_busy_words[physical_word] == ~0ULL)
+         _full_words[physical_word >> 6] |= (1ULL << (physical_word & 63));
+
+      offset += num_bits;
+   }
+}
+
+void
+QueueModelHistoryCalendar::slideWindow(UInt64 new_window_end)
+{
+   UInt64 num_words = (new_window_end - getWindowEnd() + 63) >> 6;
+
+   if (num_words >= _num_words)
+   {
+      // Nothing in the current window survives
+      memset(_busy_words, 0, _num_words * sizeof(UInt64));
+      memset(_full_words, 0, (_num_words / 64) * sizeof(UInt64));
+      _head_word = 0;
+      _window_start = ((new_window_end + 63) & ~63ULL) - _window_size;
+      return;
+   }
+
+   // The oldest words are reused for the newest cycles
+   for (UInt32 word = 0; word < num_words; word++)
+   {
+      UInt32 physical_word = getPhysicalWord(word);
+      _busy_words[physical_word] = 0;
+      _full_words[physical_word >> 6] &= ~(1ULL << (physical_word & 63));
+   }
+   _head_word = getPhysicalWord(num_words);
+   _window_start += (num_words << 6);
+}
+
+UInt64
+QueueModelHistoryCalendar::getNextFreeCycle(UInt64 cycle)
+{
+   UInt64 offset = cycle - _window_start;
+   UInt32 word = offset >> 6;
+   UInt64 free_bits = ~_busy_words[getPhysicalWord(word)] & (~0ULL << (offset & 63));
+
+   while (free_bits == 0)
+   {
+      word = getNextNonFullWord(word + 1);
+      if (word == _num_words)
+         return getWindowEnd();
+      free_bits = ~_busy_words[getPhysicalWord(word)];
+   }
+
+   return _window_start + (((UInt64) word) << 6) + __builtin_ctzll(free_bits);
+}
+
+UInt64
+QueueModelHistoryCalendar::getNextBusyCycle(UInt64 cycle, UInt64 end)
+{
+   // Returns 'end' if [cycle, end) is free
+   UInt64 offset = cycle - _window_start;
+   UInt32 word = offset >> 6;
+   UInt64 busy_bits = _busy_words[getPhysicalWord(word)] & (~0ULL << (offset & 63));
+
+   while (busy_bits == 0)
+   {
+      word ++;
+      if ((_window_start + (((UInt64) word) << 6)) >= end)
+         return end;
+      busy_bits = _busy_words[getPhysicalWord(word)];
+   }
+
+   return min<UInt64>(end, _window_start + (((UInt64) word) << 6) + __builtin_ctzll(busy_bits));
+}
+
+UInt32
+QueueModelHistoryCalendar::getNextNonFullWord(UInt32 word)
+{
+   // Returns _num_words if all words from 'word' to the end of the window are full
+   while (word < _num_words)
+   {
+      UInt32 physical_word = getPhysicalWord(word);
+      UInt64 non_full_bits = ~_full_words[physical_word >> 6] & (~0ULL << (physical_word & 63));
+      if (non_full_bits)
+      {
+         UInt32 next_word = word + (__builtin_ctzll(non_full_bits) - (physical_word & 63));
+         return min<UInt32>(next_word, _num_words);
+      }
+      // _num_words is a multiple of 64, so a summary word never wraps around
+      word += 64 - (physical_word & 63);
+   }
+   return _num_words;
+}
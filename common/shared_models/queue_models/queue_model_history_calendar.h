@@ -0,0 +1,52 @@
+#pragma once
+
+#include "fixed_types.h"
+#include "queue_model.h"
+#include "queue_model_m_g_1.h"
+
+// Keeps the busy history of the queue as a bitmap with one bit per cycle
+// over a sliding window of the most recent 'window_size' cycles. Requests
+// are placed in the first free gap at or after their arrival time. A second
+// bitmap marks the words that are completely busy, so that a search skips
+// 64 busy words at a time. The window slides forward as later requests
+// arrive; requests that fall entirely before it use the analytical model
+// (if enabled).
+
+class QueueModelHistoryCalendar : public QueueModel
+{
+public:
+   QueueModelHistoryCalendar(UInt64 min_processing_time);
+   ~QueueModelHistoryCalendar();
+
+   UInt64 computeQueueDelay(UInt64 pkt_time, UInt64 processing_time, tile_id_t requester = INVALID_TILE_ID);
+   UInt64 getTotalRequestsUsingAnalyticalModel() { return _total_requests_using_analytical_model; }
+
+private:
+   UInt64 findFreeSlot(UInt64 start, UInt64 length);
+   void markBusy(UInt64 start, UInt64 length);
+   void slideWindow(UInt64 new_window_end);
+
+   UInt64 getNextFreeCycle(UInt64 cycle);
+   UInt64 getNextBusyCycle(UInt64 cycle, UInt64 end);
+   UInt32 getNextNonFullWord(UInt32 word);
+
+   UInt64 getWindowEnd() { return _window_start + _window_size; }
+   // Words are addressed relative to the start of the window
+   UInt32 getPhysicalWord(UInt32 word) { return (_head_word + word) & (_num_words - 1); }
+
+   // Private Fields
+   QueueModelMG1* _queue_model_m_g_1;
+
+   // Is analytical model used ?
+   bool _analytical_model_enabled;
+
+   UInt64 _window_size;
+   UInt64 _window_start;
+   UInt32 _num_words;
+   UInt32 _head_word;
+   UInt64* _busy_words;
+   UInt64* _full_words;
+
+   // Queue Counters
+   UInt64 _total_requests_using_analytical_model;
+};
@@ -0,0 +1,112 @@
+#include <sstream>
+
+#include "checkpoint_manager.h"
+#include "checkpoint_stream.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "mcp.h"
+#include "vm_manager.h"
+#include "sim_thread_manager.h"
+#include "transport.h"
+#include "log.h"
+
+CheckpointManager::CheckpointManager()
+   : _handled(false)
+{
+   try
+   {
+      _save_dir = Sim()->getCfg()->getString("checkpoint/save_dir", "");
+      _restore_dir = Sim()->getCfg()->getString("checkpoint/restore_dir", "");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read checkpoint parameters from the cfg file");
+   }
+
+   LOG_ASSERT_ERROR(_save_dir.empty() || _restore_dir.empty(),
+                    "Only one of checkpoint/save_dir and checkpoint/restore_dir can be set");
+}
+
+CheckpointManager::~CheckpointManager()
+{}
+
+void
+CheckpointManager::handleModelsEnabled()
+{
+   if (_handled)
+      return;
+   _handled = true;
+
+   if (_save_dir.empty() && _restore_dir.empty())
+      return;
+
+   // This runs on the LCP (or the main thread), while the sim threads keep
+   // serving the packets of remote tiles and updating the local caches and
+   // directories. Hold them for the duration
+   Sim()->getSimThreadManager()->pauseSimThreads();
+
+   if (!_save_dir.empty())
+      saveCheckpoint();
+   else
+      restoreCheckpoint();
+
+   // No process resumes serving requests before all have been restored
+   Transport::getSingleton()->barrier();
+
+   Sim()->getSimThreadManager()->resumeSimThreads();
+}
+
+void
+CheckpointManager::saveCheckpoint()
+{
+   fprintf(stderr, "[[Graphite]] --> [ Saving checkpoint to %s ]\n", _save_dir.c_str());
+
+   Config* config = Sim()->getConfig();
+   for (UInt32 i = 0; i < config->getNumLocalTiles(); i++)
+   {
+      Tile* tile = Sim()->getTileManager()->getTileFromIndex(i);
+      CheckpointWriter checkpoint(getTileFilename(_save_dir, tile->getId()));
+      tile->saveState(checkpoint);
+   }
+
+   if (Sim()->getMCP())
+   {
+      CheckpointWriter checkpoint(getVMManagerFilename(_save_dir));
+      Sim()->getMCP()->getVMManager()->saveState(checkpoint);
+   }
+}
+
+void
+CheckpointManager::restoreCheckpoint()
+{
+   fprintf(stderr, "[[Graphite]] --> [ Restoring checkpoint from %s ]\n", _restore_dir.c_str());
+
+   Config* config = Sim()->getConfig();
+   for (UInt32 i = 0; i < config->getNumLocalTiles(); i++)
+   {
+      Tile* tile = Sim()->getTileManager()->getTileFromIndex(i);
+      CheckpointReader checkpoint(getTileFilename(_restore_dir, tile->getId()));
+      tile->restoreState(checkpoint);
+   }
+
+   if (Sim()->getMCP())
+   {
+      CheckpointReader checkpoint(getVMManagerFilename(_restore_dir));
+      Sim()->getMCP()->getVMManager()->restoreState(checkpoint);
+   }
+}
+
+string
+CheckpointManager::getTileFilename(const string& dir, tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << dir << "/tile_" << tile_id << ".ckpt";
+   return filename.str();
+}
+
+string
+CheckpointManager::getVMManagerFilename(const string& dir)
+{
+   return dir + "/vm_manager.ckpt";
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+using std::string;
+#include "fixed_types.h"
+
+// Saves or restores the simulated machine state (caches, directories, DRAM
+// contents, core clocks and the VM layout) the first time the performance
+// models are enabled, i.e., at the start of the region of interest. The
+// application itself runs natively and cannot be checkpointed, so a
+// restored run re-executes up to that point with the models disabled.
+// Everything it rebuilt in the meantime (cache and DRAM contents, line and
+// directory states, the VM layout) holds its live data and must stay
+// consistent with it: a restore only compares that state with the
+// checkpoint and warns about differences. The timing state (core clocks),
+// the replacement state and the miss type history are restored.
+//
+// Every process writes one file per local tile; the process running the
+// MCP also writes the VM layout. The local sim threads are paused around
+// the save or restore, and all processes meet at a transport barrier before
+// resuming them. In-flight coherence traffic is not captured, so the
+// application must have no memory requests outstanding at that point, as
+// at the start of main() or with the other threads blocked at a barrier.
+
+class CheckpointManager
+{
+public:
+   CheckpointManager();
+   ~CheckpointManager();
+
+   void handleModelsEnabled();
+
+private:
+   string _save_dir;
+   string _restore_dir;
+   bool _handled;
+
+   void saveCheckpoint();
+   void restoreCheckpoint();
+
+   string getTileFilename(const string& dir, tile_id_t tile_id);
+   string getVMManagerFilename(const string& dir);
+};
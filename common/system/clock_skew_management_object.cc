@@ -1,11 +1,17 @@
 #include "core.h"
+#include "tile.h"
+#include "simulator.h"
+#include "config.h"
 #include "network.h"
+#include "network_model.h"
 #include "transport.h"
 #include "packetize.h"
 
 #include "clock_skew_management_object.h"
 #include "lax_barrier_sync_client.h"
 #include "lax_barrier_sync_server.h"
+#include "lax_barrier_tree_sync_client.h"
+#include "adaptive_quantum_controller.h"
 #include "lax_p2p_sync_client.h"
 
 #include "log.h"
@@ -27,6 +33,8 @@ ClockSkewManagementObject::parseScheme(std::string scheme)
       return LAX_BARRIER;
    else if (scheme == "lax_p2p")
       return LAX_P2P;
+   else if (scheme == "pdes")
+      return PDES;
    else
    {
       LOG_PRINT_ERROR("Unrecognized clock skew management scheme: %s", scheme.c_str());
@@ -34,6 +42,86 @@ ClockSkewManagementObject::parseScheme(std::string scheme)
    }
 }
 
+UInt64
+ClockSkewManagementObject::getBarrierInterval(Scheme scheme)
+{
+   UInt64 barrier_interval = 0;
+
+   if (scheme == LAX_BARRIER)
+   {
+      try
+      {
+         barrier_interval = (UInt64) Sim()->getCfg()->getInt("clock_skew_management/lax_barrier/quantum");
+      }
+      catch(...)
+      {
+         LOG_PRINT_ERROR("Error Reading 'clock_skew_management/lax_barrier/quantum' from the config file");
+      }
+      return barrier_interval;
+   }
+
+   assert(scheme == PDES);
+   SInt64 lookahead_cfg = 0;
+   try
+   {
+      lookahead_cfg = (SInt64) Sim()->getCfg()->getInt("clock_skew_management/pdes/lookahead", 0);
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Error Reading 'clock_skew_management/pdes/lookahead' from the config file");
+   }
+   if (lookahead_cfg > 0)
+      return (UInt64) lookahead_cfg;
+   if (lookahead_cfg == 0)
+   {
+      // Every window ends in a barrier across all tiles, so a window as long as
+      // the lax_barrier quantum keeps the synchronization cost of lax_barrier
+      return getBarrierInterval(LAX_BARRIER);
+   }
+
+   // Windows no longer than the latency of a single network hop: a packet sent
+   // within a window is never received before the end of that window. This
+   // puts a barrier every 1-2 cycles, so it is only used when asked for (< 0)
+   Time lookahead(~0ULL);
+   SInt32 networks[] = {STATIC_NETWORK_USER, STATIC_NETWORK_MEMORY};
+   for (UInt32 i = 0; i < sizeof(networks) / sizeof(networks[0]); i++)
+   {
+      UInt32 network_type = NetworkModel::parseNetworkType(Config::getSingleton()->getNetworkType(networks[i]));
+      Time hop_latency = NetworkModel::computeMinimumHopLatency(network_type);
+      if (hop_latency < lookahead)
+         lookahead = hop_latency;
+   }
+
+   // Round down, so that a window never exceeds the lookahead (Time is in ps)
+   barrier_interval = lookahead.getTime() / 1000;
+   LOG_ASSERT_WARNING(barrier_interval > 0, "Minimum network hop latency(%llu ps) is below 1 ns, using a lookahead of 1 ns",
+                      lookahead.getTime());
+   return max<UInt64>(barrier_interval, 1);
+}
+
+UInt32
+ClockSkewManagementObject::getBarrierTreeFanIn()
+{
+   UInt32 fan_in = 0;
+   try
+   {
+      fan_in = Sim()->getCfg()->getInt("clock_skew_management/barrier_tree_fan_in", 0);
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Error Reading 'clock_skew_management/barrier_tree_fan_in' from the config file");
+   }
+   return fan_in;
+}
+
+UInt64
+ClockSkewManagementClient::getTotalPacketsSent(Core* core)
+{
+   Network* network = core->getTile()->getNetwork();
+   return network->getNetworkModel(STATIC_NETWORK_USER)->getTotalPacketsSent() +
+          network->getNetworkModel(STATIC_NETWORK_MEMORY)->getTotalPacketsSent();
+}
+
 ClockSkewManagementClient*
 ClockSkewManagementClient::create(std::string scheme_str, Core* core)
 {
@@ -45,7 +133,11 @@ ClockSkewManagementClient::create(std::string scheme_str, Core* core)
          return (ClockSkewManagementClient*) NULL;
 
       case LAX_BARRIER:
-         return new LaxBarrierSyncClient(core);
+      case PDES:
+         if (getBarrierTreeFanIn() > 0)
+            return new LaxBarrierTreeSyncClient(core, getBarrierInterval(scheme), getBarrierTreeFanIn(),
+                                                (scheme == LAX_BARRIER) && AdaptiveQuantumController::isEnabled());
+         return new LaxBarrierSyncClient(core, getBarrierInterval(scheme));
 
       case LAX_P2P:
          return new LaxP2PSyncClient(core);
@@ -66,6 +158,7 @@ ClockSkewManagementManager::create(std::string scheme_str)
       case LAX:
       case LAX_BARRIER:
       case LAX_P2P:
+      case PDES:
          return (ClockSkewManagementManager*) NULL;
 
       default:
@@ -85,7 +178,12 @@ ClockSkewManagementServer::create(std::string scheme_str, Network& network, Unst
          return (ClockSkewManagementServer*) NULL;
 
       case LAX_BARRIER:
-         return new LaxBarrierSyncServer(network, recv_buff);
+      case PDES:
+         // The barrier tree runs on the application tiles
+         if (getBarrierTreeFanIn() > 0)
+            return (ClockSkewManagementServer*) NULL;
+         return new LaxBarrierSyncServer(network, recv_buff, getBarrierInterval(scheme),
+                                         (scheme == LAX_BARRIER) && AdaptiveQuantumController::isEnabled());
 
       case LAX_P2P:
          return (ClockSkewManagementServer*) NULL;
@@ -19,10 +19,17 @@ public:
       LAX = 0,
       LAX_BARRIER,
       LAX_P2P,
+      PDES,
       NUM_SCHEMES
    };
 
    static Scheme parseScheme(std::string scheme);
+
+protected:
+   // Time between successive barriers (in nanoseconds) for LAX_BARRIER and PDES
+   static UInt64 getBarrierInterval(Scheme scheme);
+   // Fan-in of the barrier tree for LAX_BARRIER and PDES (0 if the MCP runs the barrier)
+   static UInt32 getBarrierTreeFanIn();
 };
  
 void ClockSkewManagementClientNetworkCallback(void* obj, NetPacket packet);
@@ -40,6 +47,11 @@ public:
    virtual void disable() = 0;
    virtual void synchronize(Time curr_time = Time(0)) = 0;
    virtual void netProcessSyncMsg(const NetPacket& recv_pkt) = 0;
+   virtual void onCoreStateChange() {}
+
+protected:
+   // Packets sent by the tile of 'core' on the user and memory networks
+   static UInt64 getTotalPacketsSent(Core* core);
 };
 
 class ClockSkewManagementManager : public ClockSkewManagementObject
@@ -0,0 +1,94 @@
+#include "adaptive_quantum_controller.h"
+#include "simulator.h"
+#include "config.h"
+#include "log.h"
+
+using std::endl;
+
+AdaptiveQuantumController::AdaptiveQuantumController(UInt64 quantum)
+   : m_quantum(quantum)
+   , m_num_barriers(0)
+   , m_num_quantum_increases(0)
+   , m_num_quantum_decreases(0)
+{
+   std::string output_dir;
+   try
+   {
+      m_min_quantum = (UInt64) Sim()->getCfg()->getInt("clock_skew_management/lax_barrier/min_quantum");
+      m_max_quantum = (UInt64) Sim()->getCfg()->getInt("clock_skew_management/lax_barrier/max_quantum");
+      m_low_traffic_threshold = Sim()->getCfg()->getFloat("clock_skew_management/lax_barrier/low_traffic_threshold");
+      m_high_traffic_threshold = Sim()->getCfg()->getFloat("clock_skew_management/lax_barrier/high_traffic_threshold");
+      output_dir = Sim()->getCfg()->getString("general/output_dir");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read clock_skew_management/lax_barrier adaptive quantum parameters from the cfg file");
+   }
+
+   LOG_ASSERT_ERROR((m_min_quantum > 0) && (m_min_quantum <= m_quantum) && (m_quantum <= m_max_quantum),
+                    "Need 0 < min_quantum(%llu) <= quantum(%llu) <= max_quantum(%llu)",
+                    m_min_quantum, m_quantum, m_max_quantum);
+   LOG_ASSERT_ERROR(m_low_traffic_threshold < m_high_traffic_threshold,
+                    "low_traffic_threshold(%g) must be below high_traffic_threshold(%g)",
+                    m_low_traffic_threshold, m_high_traffic_threshold);
+
+   m_num_application_tiles = Config::getSingleton()->getApplicationTiles();
+
+   std::string filename = output_dir + "/barrier_quantum.dat";
+   m_trace_file.open(filename.c_str());
+   m_trace_file << "# Barrier Time (in ns), Quantum (in ns), Traffic (in packets per tile per microsecond)" << endl;
+   m_trace_file << 0 << " " << m_quantum << " " << 0 << endl;
+}
+
+AdaptiveQuantumController::~AdaptiveQuantumController()
+{
+   m_trace_file << "# Barriers: " << m_num_barriers << endl;
+   m_trace_file << "# Quantum Increases: " << m_num_quantum_increases << endl;
+   m_trace_file << "# Quantum Decreases: " << m_num_quantum_decreases << endl;
+   m_trace_file.close();
+}
+
+bool
+AdaptiveQuantumController::isEnabled()
+{
+   bool enabled = false;
+   try
+   {
+      enabled = Sim()->getCfg()->getBool("clock_skew_management/lax_barrier/adaptive_quantum", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read clock_skew_management/lax_barrier/adaptive_quantum from the cfg file");
+   }
+   return enabled;
+}
+
+UInt64
+AdaptiveQuantumController::update(UInt64 barrier_time, UInt64 elapsed_time, UInt64 num_packets)
+{
+   m_num_barriers ++;
+   if (elapsed_time == 0)
+      return m_quantum;
+
+   double traffic = (1000.0 * num_packets) / ((double) m_num_application_tiles * elapsed_time);
+
+   UInt64 quantum = m_quantum;
+   if (traffic < m_low_traffic_threshold)
+      quantum = std::min<UInt64>(m_quantum * 2, m_max_quantum);
+   else if (traffic > m_high_traffic_threshold)
+      quantum = std::max<UInt64>(m_quantum / 2, m_min_quantum);
+
+   if (quantum != m_quantum)
+   {
+      if (quantum > m_quantum)
+         m_num_quantum_increases ++;
+      else
+         m_num_quantum_decreases ++;
+
+      LOG_PRINT("Barrier time(%llu): quantum(%llu) -> quantum(%llu), traffic(%g)", barrier_time, m_quantum, quantum, traffic);
+      m_trace_file << barrier_time << " " << quantum << " " << traffic << endl;
+      m_quantum = quantum;
+   }
+
+   return m_quantum;
+}
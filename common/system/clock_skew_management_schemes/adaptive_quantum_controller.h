@@ -0,0 +1,42 @@
+#pragma once
+
+#include <fstream>
+
+#include "fixed_types.h"
+
+// Adaptive quantum for the lax_barrier scheme
+//
+// At every barrier, the quantum is doubled if the application tiles sent few
+// packets (user and memory networks) in the quantum that just ended, and halved
+// if they sent many, within [min_quantum, max_quantum]. Every change is traced
+// to barrier_quantum.dat in the output directory.
+class AdaptiveQuantumController
+{
+public:
+   AdaptiveQuantumController(UInt64 quantum);
+   ~AdaptiveQuantumController();
+
+   static bool isEnabled();
+
+   UInt64 getQuantum() const { return m_quantum; }
+
+   // Called at a barrier at 'barrier_time' (in nanoseconds) that ends a quantum of
+   // 'elapsed_time' nanoseconds in which the application tiles sent 'num_packets' packets.
+   // Returns the next quantum
+   UInt64 update(UInt64 barrier_time, UInt64 elapsed_time, UInt64 num_packets);
+
+private:
+   UInt64 m_quantum;
+   UInt64 m_min_quantum;
+   UInt64 m_max_quantum;
+   // In packets per tile per microsecond
+   double m_low_traffic_threshold;
+   double m_high_traffic_threshold;
+   UInt32 m_num_application_tiles;
+
+   UInt64 m_num_barriers;
+   UInt64 m_num_quantum_increases;
+   UInt64 m_num_quantum_decreases;
+
+   std::ofstream m_trace_file;
+};
@@ -11,17 +11,11 @@
 #include "core.h"
 #include "core_model.h"
 
-LaxBarrierSyncClient::LaxBarrierSyncClient(Core* core):
-   m_core(core)
+LaxBarrierSyncClient::LaxBarrierSyncClient(Core* core, UInt64 barrier_interval):
+   m_core(core),
+   m_barrier_interval(barrier_interval),
+   m_last_packets_sent(0)
 {
-   try
-   {
-      m_barrier_interval = (UInt64) Sim()->getCfg()->getInt("clock_skew_management/lax_barrier/quantum"); 
-   }
-   catch(...)
-   {
-      LOG_PRINT_ERROR("Error Reading 'clock_skew_management/barrier/quantum' from the config file");
-   }
    m_next_sync_time = m_barrier_interval;
 }
 
@@ -43,7 +37,10 @@ LaxBarrierSyncClient::synchronize(Time time)
       // Send 'SIM_BARRIER_WAIT' request
       int msg_type = MCP_MESSAGE_CLOCK_SKEW_MANAGEMENT;
 
-      m_send_buff << msg_type << curr_time_ns;
+      // Packets sent since the last barrier, for the adaptive quantum
+      UInt64 packets_sent = getTotalPacketsSent(m_core);
+      m_send_buff << msg_type << curr_time_ns << (packets_sent - m_last_packets_sent);
+      m_last_packets_sent = packets_sent;
       m_core->getTile()->getNetwork()->netSend(Config::getSingleton()->getMCPCoreId(), MCP_SYSTEM_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
       LOG_PRINT("Core(%i, %i), curr_time(%llu), m_next_sync_time(%llu) sent SIM_BARRIER_WAIT", m_core->getId().tile_id, m_core->getId().core_type, curr_time_ns, m_next_sync_time);
@@ -51,19 +48,20 @@ LaxBarrierSyncClient::synchronize(Time time)
       // Receive 'BARRIER_RELEASE' response
       NetPacket recv_pkt;
       recv_pkt = m_core->getTile()->getNetwork()->netRecv(Config::getSingleton()->getMCPCoreId(), m_core->getId(), MCP_SYSTEM_RESPONSE_TYPE);
-      assert(recv_pkt.length == sizeof(int));
+      assert(recv_pkt.length == sizeof(unsigned int) + sizeof(UInt64));
 
       unsigned int dummy;
+      UInt64 next_barrier_time;
       m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
-      m_recv_buff >> dummy;
+      m_recv_buff >> dummy >> next_barrier_time;
       assert(dummy == BARRIER_RELEASE);
 
-      LOG_PRINT("Tile(%i) received SIM_BARRIER_RELEASE", m_core->getTile()->getId());
+      LOG_PRINT("Tile(%i) received SIM_BARRIER_RELEASE, next_barrier_time(%llu)", m_core->getTile()->getId(), next_barrier_time);
 
-      // Update 'm_next_sync_time'
-      m_next_sync_time = ((curr_time_ns / m_barrier_interval) * m_barrier_interval) + m_barrier_interval;
+      // Update 'm_next_sync_time' (the quantum may change from one barrier to the next)
+      m_next_sync_time = next_barrier_time;
 
       // Delete the data buffer
-      delete [] (Byte*) recv_pkt.data;
+      recv_pkt.release();
    }
 }
@@ -17,9 +17,10 @@ private:
 
    UInt64 m_barrier_interval;
    UInt64 m_next_sync_time;
+   UInt64 m_last_packets_sent;
 
 public:
-   LaxBarrierSyncClient(Core* core);
+   LaxBarrierSyncClient(Core* core, UInt64 barrier_interval);
    ~LaxBarrierSyncClient();
 
    void enable() {}
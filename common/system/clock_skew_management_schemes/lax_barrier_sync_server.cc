@@ -1,5 +1,6 @@
 #include "lax_barrier_sync_client.h"
 #include "lax_barrier_sync_server.h"
+#include "adaptive_quantum_controller.h"
 #include "simulator.h"
 #include "thread_manager.h"
 #include "tile_manager.h"
@@ -9,20 +10,19 @@
 #include "statistics_thread.h"
 #include "log.h"
 
-LaxBarrierSyncServer::LaxBarrierSyncServer(Network &network, UnstructuredBuffer &recv_buff):
+LaxBarrierSyncServer::LaxBarrierSyncServer(Network &network, UnstructuredBuffer &recv_buff, UInt64 barrier_interval, bool adaptive_quantum):
    m_network(network),
-   m_recv_buff(recv_buff)
+   m_recv_buff(recv_buff),
+   m_barrier_interval(barrier_interval),
+   m_quantum_controller(NULL),
+   m_num_packets_in_quantum(0)
 {
    m_thread_manager = Sim()->getThreadManager();
-   try
-   {
-      m_barrier_interval = (UInt64) Sim()->getCfg()->getInt("clock_skew_management/lax_barrier/quantum"); 
-   }
-   catch(...)
-   {
-      LOG_PRINT_ERROR("Error Reading 'clock_skew_management/barrier/quantum' from the config file");
-   }
 
+   if (adaptive_quantum)
+      m_quantum_controller = new AdaptiveQuantumController(m_barrier_interval);
+
+   m_prev_barrier_time = 0;
    m_next_barrier_time = m_barrier_interval;
    m_num_application_tiles = Config::getSingleton()->getApplicationTiles();
    m_local_clock_list.resize(m_num_application_tiles);
@@ -36,7 +36,9 @@ LaxBarrierSyncServer::LaxBarrierSyncServer(Network &network, UnstructuredBuffer
 }
 
 LaxBarrierSyncServer::~LaxBarrierSyncServer()
-{}
+{
+   delete m_quantum_controller;
+}
 
 void
 LaxBarrierSyncServer::processSyncMsg(core_id_t core_id)
@@ -57,7 +59,9 @@ void
 LaxBarrierSyncServer::barrierWait(core_id_t core_id)
 {
    UInt64 time_ns;
-   m_recv_buff >> time_ns;
+   UInt64 num_packets;
+   m_recv_buff >> time_ns >> num_packets;
+   m_num_packets_in_quantum += num_packets;
 
    LOG_PRINT("Received 'SIM_BARRIER_WAIT' from Core(%i, %i), Time(%llu)", core_id.tile_id, core_id.core_type, time_ns);
 
@@ -67,9 +71,7 @@ LaxBarrierSyncServer::barrierWait(core_id_t core_id)
    {
       LOG_PRINT("Sent 'SIM_BARRIER_RELEASE' immediately time(%llu), m_next_barrier_time(%llu)", time, m_next_barrier_time);
       // LOG_PRINT_WARNING("tile_id(%i), local_clock(%llu), m_next_barrier_time(%llu), m_barrier_interval(%llu)", tile_id, time, m_next_barrier_time, m_barrier_interval);
-      unsigned int reply = LaxBarrierSyncClient::BARRIER_RELEASE;
-
-      m_network.netSend(core_id, MCP_SYSTEM_RESPONSE_TYPE, (char*) &reply, sizeof(reply));
+      sendBarrierRelease(core_id);
       return;
    }
 
@@ -127,6 +129,15 @@ LaxBarrierSyncServer::barrierRelease()
    // time till a thread can be resumed. Then only, will we have 
    // forward progress
 
+   // Choose the next quantum from the traffic in the quantum that just ended
+   if (m_quantum_controller)
+   {
+      m_barrier_interval = m_quantum_controller->update(m_next_barrier_time, m_next_barrier_time - m_prev_barrier_time,
+                                                        m_num_packets_in_quantum);
+      m_num_packets_in_quantum = 0;
+   }
+   m_prev_barrier_time = m_next_barrier_time;
+
    bool thread_resumed = false;
    while (!thread_resumed)
    {
@@ -142,9 +153,7 @@ LaxBarrierSyncServer::barrierRelease()
             {
                LOG_ASSERT_ERROR(m_thread_manager->isCoreRunning(tile_id) != INVALID_THREAD_ID || m_thread_manager->isCoreInitializing(tile_id) != INVALID_THREAD_ID, "(%i) has acquired barrier, local_clock(%i), m_next_barrier_time(%llu), but not initializing or running", tile_id, m_local_clock_list[tile_id], m_next_barrier_time);
 
-               unsigned int reply = LaxBarrierSyncClient::BARRIER_RELEASE;
-
-               m_network.netSend(Tile::getMainCoreId(tile_id), MCP_SYSTEM_RESPONSE_TYPE, (char*) &reply, sizeof(reply));
+               sendBarrierRelease(Tile::getMainCoreId(tile_id));
 
                m_barrier_acquire_list[tile_id] = false;
 
@@ -158,3 +167,11 @@ LaxBarrierSyncServer::barrierRelease()
    if (Sim()->getStatisticsThread())
       Sim()->getStatisticsThread()->notify(m_next_barrier_time);
 }
+
+void
+LaxBarrierSyncServer::sendBarrierRelease(core_id_t core_id)
+{
+   UnstructuredBuffer send_buff;
+   send_buff << (unsigned int) LaxBarrierSyncClient::BARRIER_RELEASE << m_next_barrier_time;
+   m_network.netSend(core_id, MCP_SYSTEM_RESPONSE_TYPE, send_buff.getBuffer(), send_buff.size());
+}
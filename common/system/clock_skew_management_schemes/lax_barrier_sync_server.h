@@ -8,6 +8,7 @@
 // Forward Decls
 class ThreadManager;
 class Network;
+class AdaptiveQuantumController;
 
 class LaxBarrierSyncServer : public ClockSkewManagementServer
 {
@@ -18,13 +19,17 @@ private:
 
    UInt64 m_barrier_interval;
    UInt64 m_next_barrier_time;
+   UInt64 m_prev_barrier_time;
+   // NULL unless the quantum is adaptive
+   AdaptiveQuantumController* m_quantum_controller;
+   UInt64 m_num_packets_in_quantum;
    std::vector<UInt64> m_local_clock_list;
    std::vector<bool> m_barrier_acquire_list;
    
    UInt32 m_num_application_tiles;
 
 public:
-   LaxBarrierSyncServer(Network &network, UnstructuredBuffer &recv_buff);
+   LaxBarrierSyncServer(Network &network, UnstructuredBuffer &recv_buff, UInt64 barrier_interval, bool adaptive_quantum);
    ~LaxBarrierSyncServer();
 
    void processSyncMsg(core_id_t core_id);
@@ -33,4 +38,5 @@ public:
    void barrierWait(core_id_t core_id);
    bool isBarrierReached(void);
    void barrierRelease(void);
+   void sendBarrierRelease(core_id_t core_id);
 };
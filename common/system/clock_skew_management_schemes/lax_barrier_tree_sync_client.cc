@@ -0,0 +1,306 @@
+#include <cassert>
+
+#include "tile.h"
+#include "lax_barrier_tree_sync_client.h"
+#include "adaptive_quantum_controller.h"
+#include "simulator.h"
+#include "config.h"
+#include "packet_type.h"
+#include "packetize.h"
+#include "network.h"
+#include "core.h"
+#include "core_model.h"
+#include "statistics_thread.h"
+#include "log.h"
+
+const UInt64 LaxBarrierTreeSyncClient::MAX_TIME = ~0ULL;
+
+LaxBarrierTreeSyncClient::LaxBarrierTreeSyncClient(Core* core, UInt64 barrier_interval, UInt32 fan_in, bool adaptive_quantum):
+   m_core(core),
+   m_barrier_interval(barrier_interval),
+   m_enabled(false),
+   m_position(-1),
+   m_parent(INVALID_TILE_ID),
+   m_round(0),
+   m_next_barrier_time(barrier_interval),
+   m_waiting(false),
+   m_waiting_time(0),
+   m_num_children_reported(0),
+   m_round_start_packets_sent(0),
+   m_reported(false),
+   m_reported_num_waiting(0),
+   m_quantum_controller(NULL),
+   m_prev_barrier_time(0)
+{
+   LOG_ASSERT_ERROR(fan_in >= 2, "clock_skew_management/barrier_tree_fan_in(%u) must be 0 or at least 2", fan_in);
+
+   // Application tiles ordered by process, so that most subtrees are local to a process
+   std::vector<tile_id_t> tree_tiles;
+   UInt32 num_application_tiles = Config::getSingleton()->getApplicationTiles();
+   for (UInt32 process_num = 0; process_num < Config::getSingleton()->getProcessCount(); process_num++)
+   {
+      const Config::TileList& tile_list = Config::getSingleton()->getTileListForProcess(process_num);
+      for (Config::TLCI it = tile_list.begin(); it != tile_list.end(); it++)
+      {
+         if (*it < (tile_id_t) num_application_tiles)
+            tree_tiles.push_back(*it);
+      }
+   }
+
+   for (UInt32 i = 0; i < tree_tiles.size(); i++)
+   {
+      if (tree_tiles[i] == m_core->getTile()->getId())
+         m_position = i;
+   }
+   // Thread spawner and MCP tiles never synchronize
+   if (m_position < 0)
+      return;
+
+   if (m_position > 0)
+      m_parent = tree_tiles[(m_position - 1) / fan_in];
+   for (UInt32 i = m_position * fan_in + 1; (i <= m_position * fan_in + fan_in) && (i < tree_tiles.size()); i++)
+      m_children.push_back(tree_tiles[i]);
+
+   m_child_reported.resize(m_children.size(), false);
+   m_child_num_waiting.resize(m_children.size(), 0);
+   m_child_min_waiting_time.resize(m_children.size(), MAX_TIME);
+   m_child_num_packets.resize(m_children.size(), 0);
+
+   if ((m_position == 0) && adaptive_quantum)
+      m_quantum_controller = new AdaptiveQuantumController(m_barrier_interval);
+
+   m_core->getTile()->getNetwork()->registerCallback(CLOCK_SKEW_MANAGEMENT, ClockSkewManagementClientNetworkCallback, this);
+}
+
+LaxBarrierTreeSyncClient::~LaxBarrierTreeSyncClient()
+{
+   if (m_position >= 0)
+      m_core->getTile()->getNetwork()->unregisterCallback(CLOCK_SKEW_MANAGEMENT);
+   delete m_quantum_controller;
+}
+
+void
+LaxBarrierTreeSyncClient::enable()
+{
+   ScopedLock sl(m_lock);
+   m_enabled = true;
+   // Subtrees without running threads report right away
+   checkBarrier();
+}
+
+void
+LaxBarrierTreeSyncClient::disable()
+{
+   ScopedLock sl(m_lock);
+   m_enabled = false;
+}
+
+// Called by user thread
+void
+LaxBarrierTreeSyncClient::synchronize(Time time)
+{
+   if (m_position < 0)
+      return;
+
+   UInt64 curr_time_ns = time.toNanosec();
+   if (curr_time_ns == 0)
+      curr_time_ns = m_core->getModel()->getCurrTime().toNanosec();
+
+   // Only a release changes m_next_barrier_time, so a stale value just takes the slow path
+   if (curr_time_ns < m_next_barrier_time)
+      return;
+
+   m_lock.acquire();
+
+   if (curr_time_ns >= m_next_barrier_time)
+   {
+      LOG_PRINT("Tile(%i), curr_time(%llu), m_next_barrier_time(%llu) waiting at barrier",
+                m_core->getTile()->getId(), curr_time_ns, m_next_barrier_time);
+
+      m_waiting = true;
+      m_waiting_time = curr_time_ns;
+      checkBarrier();
+
+      while (m_waiting)
+         m_cond.wait(m_lock);
+
+      LOG_PRINT("Tile(%i) released, m_next_barrier_time(%llu)", m_core->getTile()->getId(), m_next_barrier_time);
+   }
+
+   m_lock.release();
+}
+
+// Called by the thread that changes the state of the core
+void
+LaxBarrierTreeSyncClient::onCoreStateChange()
+{
+   if (m_position < 0)
+      return;
+
+   ScopedLock sl(m_lock);
+   checkBarrier();
+}
+
+// Called by network thread
+void
+LaxBarrierTreeSyncClient::netProcessSyncMsg(const NetPacket& packet)
+{
+   UnstructuredBuffer recv_buff;
+   recv_buff << make_pair(packet.data, packet.length);
+
+   UInt32 msg_type;
+   UInt64 round;
+   recv_buff >> msg_type >> round;
+
+   ScopedLock sl(m_lock);
+
+   if (msg_type == REPORT)
+   {
+      UInt32 num_waiting;
+      UInt64 min_waiting_time;
+      UInt64 num_packets;
+      recv_buff >> num_waiting >> min_waiting_time >> num_packets;
+      processReport(packet.sender.tile_id, round, num_waiting, min_waiting_time, num_packets);
+   }
+   else if (msg_type == RELEASE)
+   {
+      UInt64 next_barrier_time;
+      recv_buff >> next_barrier_time;
+      release(round, next_barrier_time);
+   }
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized barrier msg type(%u) from tile(%i)", msg_type, packet.sender.tile_id);
+   }
+}
+
+bool
+LaxBarrierTreeSyncClient::isThreadRunning()
+{
+   Core::State state = m_core->getState();
+   return (state == Core::RUNNING) || (state == Core::WAKING_UP);
+}
+
+void
+LaxBarrierTreeSyncClient::processReport(tile_id_t sender, UInt64 round, UInt32 num_waiting, UInt64 min_waiting_time, UInt64 num_packets)
+{
+   // A report that crossed a release on its way up. The child reports
+   // its waiting threads again in the new round
+   if (round != m_round)
+   {
+      LOG_PRINT("Tile(%i) dropped report of round(%llu) from tile(%i) in round(%llu)",
+                m_core->getTile()->getId(), round, sender, m_round);
+      return;
+   }
+
+   UInt32 child_index = 0;
+   while ((child_index < m_children.size()) && (m_children[child_index] != sender))
+      child_index ++;
+   LOG_ASSERT_ERROR(child_index < m_children.size(), "Tile(%i) received a report from tile(%i) which is not its child",
+                    m_core->getTile()->getId(), sender);
+
+   if (!m_child_reported[child_index])
+   {
+      m_child_reported[child_index] = true;
+      m_num_children_reported ++;
+   }
+   m_child_num_waiting[child_index] = num_waiting;
+   m_child_min_waiting_time[child_index] = min_waiting_time;
+   m_child_num_packets[child_index] = num_packets;
+
+   checkBarrier();
+}
+
+void
+LaxBarrierTreeSyncClient::checkBarrier()
+{
+   if (!m_enabled)
+      return;
+
+   // Wait for this tile's thread (if it is running) and for every subtree
+   if ((!m_waiting && isThreadRunning()) || (m_num_children_reported < m_children.size()))
+      return;
+
+   UInt32 num_waiting = m_waiting ? 1 : 0;
+   UInt64 min_waiting_time = m_waiting ? m_waiting_time : MAX_TIME;
+   // Packets sent in this subtree during the quantum, for the adaptive quantum
+   UInt64 num_packets = getTotalPacketsSent(m_core) - m_round_start_packets_sent;
+   for (UInt32 i = 0; i < m_children.size(); i++)
+   {
+      num_waiting += m_child_num_waiting[i];
+      min_waiting_time = min<UInt64>(min_waiting_time, m_child_min_waiting_time[i]);
+      num_packets += m_child_num_packets[i];
+   }
+
+   if (m_position == 0)
+   {
+      // At least one thread must be waiting
+      if (num_waiting == 0)
+         return;
+
+      if (m_quantum_controller)
+         m_barrier_interval = m_quantum_controller->update(m_next_barrier_time, m_next_barrier_time - m_prev_barrier_time, num_packets);
+      m_prev_barrier_time = m_next_barrier_time;
+
+      // The next barrier is placed so that the earliest waiting thread
+      // is resumed, which ensures forward progress
+      UInt64 num_quanta = ((min_waiting_time - m_next_barrier_time) / m_barrier_interval) + 1;
+      release(m_round + 1, m_next_barrier_time + num_quanta * m_barrier_interval);
+      return;
+   }
+
+   // Report again only if more threads have arrived since the last report
+   if (m_reported && (num_waiting == m_reported_num_waiting))
+      return;
+
+   UnstructuredBuffer send_buff;
+   send_buff << (UInt32) REPORT << m_round << num_waiting << min_waiting_time << num_packets;
+   sendMsg(m_parent, send_buff);
+
+   m_reported = true;
+   m_reported_num_waiting = num_waiting;
+}
+
+void
+LaxBarrierTreeSyncClient::release(UInt64 round, UInt64 next_barrier_time)
+{
+   LOG_PRINT("Tile(%i) releasing round(%llu), m_next_barrier_time(%llu)", m_core->getTile()->getId(), round, next_barrier_time);
+
+   m_round = round;
+   m_next_barrier_time = next_barrier_time;
+
+   for (UInt32 i = 0; i < m_children.size(); i++)
+   {
+      UnstructuredBuffer send_buff;
+      send_buff << (UInt32) RELEASE << m_round << m_next_barrier_time;
+      sendMsg(m_children[i], send_buff);
+
+      m_child_reported[i] = false;
+      m_child_num_waiting[i] = 0;
+      m_child_min_waiting_time[i] = MAX_TIME;
+      m_child_num_packets[i] = 0;
+   }
+   m_num_children_reported = 0;
+   m_round_start_packets_sent = getTotalPacketsSent(m_core);
+   m_reported = false;
+   m_reported_num_waiting = 0;
+
+   // A thread past the new barrier keeps waiting in the new round
+   if (m_waiting && (m_waiting_time < m_next_barrier_time))
+   {
+      m_waiting = false;
+      m_cond.broadcast();
+   }
+
+   // Notify Statistics thread about the global time
+   if ((m_position == 0) && Sim()->getStatisticsThread())
+      Sim()->getStatisticsThread()->notify(m_next_barrier_time);
+
+   checkBarrier();
+}
+
+void
+LaxBarrierTreeSyncClient::sendMsg(tile_id_t receiver, UnstructuredBuffer& send_buff)
+{
+   m_core->getTile()->getNetwork()->netSend(Tile::getMainCoreId(receiver), CLOCK_SKEW_MANAGEMENT, send_buff.getBuffer(), send_buff.size());
+}
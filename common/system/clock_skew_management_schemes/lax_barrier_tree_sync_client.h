@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "clock_skew_management_object.h"
+#include "fixed_types.h"
+#include "packetize.h"
+#include "time_types.h"
+#include "lock.h"
+#include "cond.h"
+
+// Forward Decls
+class Core;
+class AdaptiveQuantumController;
+
+// Lax-Barrier with a combining tree instead of the MCP
+//
+// The application tiles (ordered by process, so that subtrees stay within a
+// process) form a k-ary tree. Each tile collects the barrier arrivals of its
+// own thread and the reports of its children, and sends one report to its
+// parent once its subtree has reached the barrier. The root computes the next
+// barrier time and the release travels back down the tree. Tiles whose thread
+// is not running (idle, stalled on a lock/syscall) do not hold up the barrier,
+// as with the MCP barrier. A thread that starts running again after its
+// subtree has already reported joins the barrier from the next quantum on.
+class LaxBarrierTreeSyncClient : public ClockSkewManagementClient
+{
+private:
+   enum MsgType
+   {
+      REPORT = 0,
+      RELEASE
+   };
+
+   static const UInt64 MAX_TIME;
+
+   Core* m_core;
+   UInt64 m_barrier_interval;
+   bool m_enabled;
+
+   // Position in the tree (-1 for tiles that do not run application threads)
+   SInt32 m_position;
+   tile_id_t m_parent;
+   std::vector<tile_id_t> m_children;
+
+   // State of the current barrier (round), protected by m_lock
+   Lock m_lock;
+   ConditionVariable m_cond;
+   UInt64 m_round;
+   UInt64 m_next_barrier_time;
+   bool m_waiting;
+   UInt64 m_waiting_time;
+   UInt32 m_num_children_reported;
+   std::vector<bool> m_child_reported;
+   std::vector<UInt32> m_child_num_waiting;
+   std::vector<UInt64> m_child_min_waiting_time;
+   std::vector<UInt64> m_child_num_packets;
+   UInt64 m_round_start_packets_sent;
+   bool m_reported;
+   UInt32 m_reported_num_waiting;
+
+   // Root only: NULL unless the quantum is adaptive
+   AdaptiveQuantumController* m_quantum_controller;
+   UInt64 m_prev_barrier_time;
+
+   bool isThreadRunning();
+   void checkBarrier();
+   void processReport(tile_id_t sender, UInt64 round, UInt32 num_waiting, UInt64 min_waiting_time, UInt64 num_packets);
+   void release(UInt64 round, UInt64 next_barrier_time);
+   void sendMsg(tile_id_t receiver, UnstructuredBuffer& send_buff);
+
+public:
+   LaxBarrierTreeSyncClient(Core* core, UInt64 barrier_interval, UInt32 fan_in, bool adaptive_quantum);
+   ~LaxBarrierTreeSyncClient();
+
+   void enable();
+   void disable();
+
+   void synchronize(Time time);
+   void netProcessSyncMsg(const NetPacket& packet);
+   void onCoreStateChange();
+};
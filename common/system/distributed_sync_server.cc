@@ -0,0 +1,150 @@
+#include "distributed_sync_server.h"
+#include "sync_server.h"
+#include "sync_client.h"
+#include "message_types.h"
+#include "packetize.h"
+#include "simulator.h"
+#include "config.h"
+#include "tile.h"
+#include "core.h"
+#include "log.h"
+
+DistributedSyncServer::DistributedSyncServer(Tile* tile)
+      : m_tile(tile)
+{
+   m_tile->getNetwork()->registerCallback(SYNC_REQUEST_TYPE, DistributedSyncServerNetworkCallback, this);
+}
+
+DistributedSyncServer::~DistributedSyncServer()
+{
+   m_tile->getNetwork()->unregisterCallback(SYNC_REQUEST_TYPE);
+}
+
+bool DistributedSyncServer::isEnabled()
+{
+   try
+   {
+      return Sim()->getCfg()->getBool("general/distributed_sync", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read general/distributed_sync from the cfg file");
+      return false;
+   }
+}
+
+core_id_t DistributedSyncServer::getHome(carbon_mutex_t mux)
+{
+   return Tile::getMainCoreId(((UInt32) mux) % Config::getSingleton()->getApplicationTiles());
+}
+
+// Called by the clients (lock/unlock) and by the MCP (condition variable waits)
+void DistributedSyncServer::sendRequest(Network* network, MsgType msg_type, core_id_t requester,
+                                        carbon_mutex_t mux, UInt64 time)
+{
+   UnstructuredBuffer send_buff;
+   send_buff << (UInt32) msg_type << requester << mux << time;
+   network->netSend(getHome(mux), SYNC_REQUEST_TYPE, send_buff.getBuffer(), send_buff.size());
+}
+
+// Called by the sim thread of the home tile
+void DistributedSyncServer::processRequest(const NetPacket& packet)
+{
+   UnstructuredBuffer recv_buff;
+   recv_buff << make_pair(packet.data, packet.length);
+
+   UInt32 msg_type;
+   core_id_t requester;
+   carbon_mutex_t mux;
+   UInt64 time;
+   recv_buff >> msg_type >> requester >> mux >> time;
+
+   LOG_ASSERT_ERROR(getHome(mux).tile_id == m_tile->getId(), "mux(%i) is homed on tile(%i), not on tile(%i)",
+                    mux, getHome(mux).tile_id, m_tile->getId());
+
+   // Mutexes are created on their first request
+   HomedMutex& mutex = m_mutexes[mux];
+
+   switch (msg_type)
+   {
+   case MUTEX_LOCK:
+      mutexLock(mutex, requester, mux, time, packet);
+      break;
+
+   case MUTEX_UNLOCK:
+      {
+         mutexUnlock(mutex, requester, mux, time);
+         UInt32 dummy = SyncClient::MUTEX_UNLOCK_RESPONSE;
+         sendReply(requester, packet, &dummy, sizeof(dummy));
+      }
+      break;
+
+   case MUTEX_RELEASE:
+      mutexUnlock(mutex, requester, mux, time);
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized sync request type(%u) from tile(%i)", msg_type, packet.sender.tile_id);
+      break;
+   }
+}
+
+void DistributedSyncServer::mutexLock(HomedMutex& mutex, core_id_t requester, carbon_mutex_t mux, UInt64 time, const NetPacket& packet)
+{
+   if (mutex.m_owner.tile_id == INVALID_TILE_ID)
+   {
+      // Uncontended: grant the lock without involving the MCP
+      mutex.m_owner = requester;
+
+      Reply r;
+      r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
+      r.time = time;
+      sendReply(requester, packet, &r, sizeof(r));
+   }
+   else
+   {
+      LOG_PRINT("mux(%i) held by tile(%i), tile(%i) stalls", mux, mutex.m_owner.tile_id, requester.tile_id);
+      mutex.m_waiting.push(requester);
+      notifyMCP(MCP_MESSAGE_MUTEX_STALL, requester, time);
+   }
+}
+
+void DistributedSyncServer::mutexUnlock(HomedMutex& mutex, core_id_t requester, carbon_mutex_t mux, UInt64 time)
+{
+   LOG_ASSERT_ERROR(mutex.m_owner.tile_id == requester.tile_id && mutex.m_owner.core_type == requester.core_type,
+                    "mux(%i) unlocked by tile(%i) but owned by tile(%i)", mux, requester.tile_id, mutex.m_owner.tile_id);
+
+   if (mutex.m_waiting.empty())
+   {
+      mutex.m_owner = INVALID_CORE_ID;
+   }
+   else
+   {
+      // The MCP resumes the new owner and hands the lock over to it
+      mutex.m_owner = mutex.m_waiting.front();
+      mutex.m_waiting.pop();
+      notifyMCP(MCP_MESSAGE_MUTEX_HANDOFF, mutex.m_owner, time);
+   }
+}
+
+void DistributedSyncServer::sendReply(core_id_t receiver, const NetPacket& request, const void* data, UInt32 length)
+{
+   // The reply leaves the home tile when the request arrives there
+   NetPacket reply(request.time, MCP_RESPONSE_TYPE, m_tile->getCore()->getId(), receiver, length, data);
+   m_tile->getNetwork()->netSend(reply);
+}
+
+void DistributedSyncServer::notifyMCP(SInt32 msg_type, core_id_t requester, UInt64 time)
+{
+   UnstructuredBuffer send_buff;
+   send_buff << msg_type << requester << time;
+   m_tile->getNetwork()->netSend(Config::getSingleton()->getMCPCoreId(), MCP_SYSTEM_TYPE, send_buff.getBuffer(), send_buff.size());
+}
+
+void DistributedSyncServerNetworkCallback(void* obj, NetPacket packet)
+{
+   DistributedSyncServer* server = (DistributedSyncServer*) obj;
+   assert(server);
+
+   server->processRequest(packet);
+}
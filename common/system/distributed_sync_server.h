@@ -0,0 +1,68 @@
+#ifndef DISTRIBUTED_SYNC_SERVER_H
+#define DISTRIBUTED_SYNC_SERVER_H
+
+#include <map>
+#include <queue>
+
+#include "sync_api.h"
+#include "network.h"
+#include "fixed_types.h"
+
+class Tile;
+
+// Serves the Carbon mutexes homed on a tile (general/distributed_sync)
+//
+// Every mutex is homed on an application tile (mutex id modulo the number of
+// application tiles) and its lock/unlock requests are handled by the sim
+// thread of that tile instead of the MCP. An uncontended lock is granted by
+// the home tile alone. The MCP is only involved when a thread stalls on a
+// mutex or is handed a mutex, so that the thread states seen by the thread
+// scheduler and the clock skew management server stay correct.
+// Condition variables and barriers stay on the MCP, which releases and
+// re-acquires the mutex of a condition variable wait on the mutex's home tile.
+class DistributedSyncServer
+{
+   public:
+      enum MsgType
+      {
+         MUTEX_LOCK = 0,
+         MUTEX_UNLOCK,
+         // Unlock on behalf of a thread waiting on a condition variable (no reply)
+         MUTEX_RELEASE
+      };
+
+      DistributedSyncServer(Tile* tile);
+      ~DistributedSyncServer();
+
+      static bool isEnabled();
+      static core_id_t getHome(carbon_mutex_t mux);
+      static void sendRequest(Network* network, MsgType msg_type, core_id_t requester,
+                              carbon_mutex_t mux, UInt64 time);
+
+      void processRequest(const NetPacket& packet);
+
+   private:
+      typedef std::queue<core_id_t> ThreadQueue;
+
+      class HomedMutex
+      {
+         public:
+            HomedMutex() : m_owner(INVALID_CORE_ID) {}
+            core_id_t m_owner;
+            ThreadQueue m_waiting;
+      };
+
+      typedef std::map<carbon_mutex_t, HomedMutex> MutexMap;
+
+      Tile* m_tile;
+      MutexMap m_mutexes;
+
+      void mutexLock(HomedMutex& mutex, core_id_t requester, carbon_mutex_t mux, UInt64 time, const NetPacket& packet);
+      void mutexUnlock(HomedMutex& mutex, core_id_t requester, carbon_mutex_t mux, UInt64 time);
+      void sendReply(core_id_t receiver, const NetPacket& request, const void* data, UInt32 length);
+      void notifyMCP(SInt32 msg_type, core_id_t requester, UInt64 time);
+};
+
+void DistributedSyncServerNetworkCallback(void* obj, NetPacket packet);
+
+#endif // DISTRIBUTED_SYNC_SERVER_H
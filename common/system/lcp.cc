@@ -7,6 +7,7 @@
 #include "performance_counter_manager.h"
 #include "clock_skew_management_object.h"
 
+#include "packet_buffer_pool.h"
 #include "log.h"
 
 // -- general LCP functionality
@@ -87,7 +88,7 @@ void LCP::processPacket()
       break;
    }
 
-   delete [] pkt;
+   PacketBufferPool::release(pkt);
 }
 
 void LCP::finish()
@@ -128,6 +129,5 @@ void LCP::updateCommId(void *vp)
                  /*length*/ 0,
                  /*data*/ NULL);
    Byte *buffer = ack.makeBuffer();
-   m_transport->send(update->tile_id, buffer, ack.bufferSize());
-   delete [] buffer;
+   m_transport->sendBuffer(update->tile_id, buffer, ack.bufferSize());
 }
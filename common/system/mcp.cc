@@ -59,6 +59,9 @@ void MCP::processPacket()
    case MCP_MESSAGE_SYS_CALL:
       m_syscall_server.handleSyscall(recv_pkt.sender);
       break;
+   case MCP_MESSAGE_SYS_CALL_DATA:
+      m_syscall_server.handleSyscallData(recv_pkt.sender);
+      break;
    case MCP_MESSAGE_QUIT:
       LOG_PRINT("Quit message received.");
       m_finished = true;
@@ -73,6 +76,12 @@ void MCP::processPacket()
    case MCP_MESSAGE_MUTEX_UNLOCK:
       m_sync_server.mutexUnlock(recv_pkt.sender);
       break;
+   case MCP_MESSAGE_MUTEX_STALL:
+      m_sync_server.mutexStall(recv_pkt.sender);
+      break;
+   case MCP_MESSAGE_MUTEX_HANDOFF:
+      m_sync_server.mutexHandOff(recv_pkt.sender);
+      break;
 
    case MCP_MESSAGE_COND_INIT:
       m_sync_server.condInit(recv_pkt.sender);
@@ -152,7 +161,7 @@ void MCP::processPacket()
       LOG_PRINT_ERROR("Unhandled MCP message type: %i from %i", msg_type, recv_pkt.sender);
    }
 
-   delete [](Byte*)recv_pkt.data;
+   recv_pkt.release();
 
    LOG_PRINT("Finished processing message -- type : %d", (int)msg_type);
 }
@@ -6,9 +6,12 @@ typedef enum
 {
    MCP_MESSAGE_QUIT,
    MCP_MESSAGE_SYS_CALL,
+   MCP_MESSAGE_SYS_CALL_DATA,
    MCP_MESSAGE_MUTEX_INIT,
    MCP_MESSAGE_MUTEX_LOCK,
    MCP_MESSAGE_MUTEX_UNLOCK,
+   MCP_MESSAGE_MUTEX_STALL,
+   MCP_MESSAGE_MUTEX_HANDOFF,
    MCP_MESSAGE_COND_INIT,
    MCP_MESSAGE_COND_WAIT,
    MCP_MESSAGE_COND_SIGNAL,
@@ -25,7 +25,7 @@ PerformanceCounterManager::togglePerformanceCounters(Byte* msg)
                        0 /* length */, NULL /* data */);
          Byte* buffer = ack.makeBuffer();
          Transport::Node* transport = Transport::getSingleton()->getGlobalNode();
-         transport->send(0, buffer, ack.bufferSize());
+         transport->sendBuffer(0, buffer, ack.bufferSize());
       }
       break;
    
@@ -38,7 +38,7 @@ PerformanceCounterManager::togglePerformanceCounters(Byte* msg)
                        0 /* length */, NULL /* data */);
          Byte* buffer = ack.makeBuffer();
          Transport::Node* transport = Transport::getSingleton()->getGlobalNode();
-         transport->send(0, buffer, ack.bufferSize());
+         transport->sendBuffer(0, buffer, ack.bufferSize());
       }
       break;
    
@@ -0,0 +1,59 @@
+#include "process_syscall_server.h"
+#include "message_types.h"
+#include "config.h"
+#include "tile.h"
+#include "log.h"
+
+using namespace std;
+
+ProcessSyscallServer::ProcessSyscallServer(Tile* tile)
+      : m_tile(tile)
+      , m_SERVER_MAX_BUFF(256*1024)
+      , m_scratch(new char[m_SERVER_MAX_BUFF])
+      , m_syscall_server(*tile->getNetwork(), m_send_buff, m_recv_buff, m_SERVER_MAX_BUFF, m_scratch,
+                         Config::getSingleton()->getCurrentProcessNum())
+{
+   m_tile->getNetwork()->registerCallback(MCP_REQUEST_TYPE, ProcessSyscallServerNetworkCallback, this);
+}
+
+ProcessSyscallServer::~ProcessSyscallServer()
+{
+   m_tile->getNetwork()->unregisterCallback(MCP_REQUEST_TYPE);
+   delete [] m_scratch;
+}
+
+// Called by the sim thread of the thread spawner tile
+void ProcessSyscallServer::processRequest(const NetPacket& packet)
+{
+   m_send_buff.clear();
+   m_recv_buff.clear();
+
+   m_recv_buff << make_pair(packet.data, packet.length);
+
+   int msg_type;
+   m_recv_buff >> msg_type;
+
+   LOG_PRINT("Process syscall server message type(%i), sender(%i,%i)", msg_type, packet.sender.tile_id, packet.sender.core_type);
+
+   switch (msg_type)
+   {
+   case MCP_MESSAGE_SYS_CALL:
+      m_syscall_server.handleSyscall(packet.sender);
+      break;
+   case MCP_MESSAGE_SYS_CALL_DATA:
+      m_syscall_server.handleSyscallData(packet.sender);
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unhandled process syscall server message type: %i from %i", msg_type, packet.sender.tile_id);
+      break;
+   }
+}
+
+void ProcessSyscallServerNetworkCallback(void* obj, NetPacket packet)
+{
+   ProcessSyscallServer* server = (ProcessSyscallServer*) obj;
+   assert(server);
+
+   server->processRequest(packet);
+}
@@ -0,0 +1,39 @@
+#ifndef PROCESS_SYSCALL_SERVER_H
+#define PROCESS_SYSCALL_SERVER_H
+
+#include "syscall_server.h"
+#include "packetize.h"
+#include "network.h"
+#include "fixed_types.h"
+
+class Tile;
+
+// Serves the process-local syscalls of a process (syscall_server/per_process)
+//
+// Hosted by the sim thread of the thread spawner tile of every process.
+// The threads of a process send open/close/read/write/lseek/stat/access/
+// getcwd and the calls on the fds it opened here instead of to the MCP.
+// Syscalls that need a global order (futex, mmap/munmap/brk, pipe, unlink,
+// ...) are still served by the MCP.
+class ProcessSyscallServer
+{
+   public:
+      ProcessSyscallServer(Tile* tile);
+      ~ProcessSyscallServer();
+
+      void processRequest(const NetPacket& packet);
+
+   private:
+      Tile* m_tile;
+      const UInt32 m_SERVER_MAX_BUFF;
+
+      UnstructuredBuffer m_send_buff;
+      UnstructuredBuffer m_recv_buff;
+      char* m_scratch;
+
+      SyscallServer m_syscall_server;
+};
+
+void ProcessSyscallServerNetworkCallback(void* obj, NetPacket packet);
+
+#endif // PROCESS_SYSCALL_SERVER_H
@@ -1,10 +1,19 @@
+#include <sched.h>
+#include <unistd.h>
+
 #include "sim_thread.h"
 #include "tile_manager.h"
 #include "log.h"
 #include "simulator.h"
+#include "config.h"
 #include "tile.h"
 #include "sim_thread_manager.h"
 
+// An idle worker spins, then yields, then sleeps between polls
+static const UInt32 SIM_THREAD_WORKER_SPIN_ROUNDS = 64;
+static const UInt32 SIM_THREAD_WORKER_YIELD_ROUNDS = 1024;
+static const UInt32 SIM_THREAD_WORKER_SLEEP_TIME = 50;   // In microseconds
+
 SimThread::SimThread()
    : m_thread(NULL)
 {
@@ -51,3 +60,78 @@ void SimThread::terminateFunc(void *vp, NetPacket pkt)
    bool *pcont = (bool*) vp;
    *pcont = false;
 }
+
+SimThreadWorker::SimThreadWorker()
+   : m_thread(NULL)
+   , m_worker_id(0)
+   , m_num_workers(0)
+{
+}
+
+SimThreadWorker::~SimThreadWorker()
+{
+   delete m_thread;
+}
+
+void SimThreadWorker::run()
+{
+   Sim()->getTileManager()->registerSimThreadWorker();
+
+   LOG_PRINT("Sim thread worker(%u) starting...", m_worker_id);
+
+   SimThreadManager *sim_thread_manager = Sim()->getSimThreadManager();
+   UInt32 num_local_tiles = Config::getSingleton()->getNumLocalTiles();
+
+   sim_thread_manager->simThreadStartCallback();
+
+   UInt32 steal_index = m_worker_id;
+   UInt32 idle_rounds = 0;
+
+   while (sim_thread_manager->getNumActiveTiles() > 0)
+   {
+      bool serviced = false;
+
+      // Own tiles
+      for (UInt32 i = m_worker_id; i < num_local_tiles; i += m_num_workers)
+         serviced |= sim_thread_manager->serviceTile(i);
+
+      // Tiles of the other workers
+      for (UInt32 i = 0; (i < num_local_tiles) && !serviced; i++)
+      {
+         steal_index = (steal_index + 1) % num_local_tiles;
+         serviced = sim_thread_manager->serviceTile(steal_index);
+      }
+
+      if (serviced)
+      {
+         idle_rounds = 0;
+      }
+      else
+      {
+         idle_rounds ++;
+         backoff(idle_rounds);
+      }
+   }
+
+   sim_thread_manager->simThreadExitCallback();
+
+   LOG_PRINT("Sim thread worker(%u) exiting", m_worker_id);
+}
+
+void SimThreadWorker::backoff(UInt32 idle_rounds)
+{
+   if (idle_rounds < SIM_THREAD_WORKER_SPIN_ROUNDS)
+      return;
+   else if (idle_rounds < SIM_THREAD_WORKER_YIELD_ROUNDS)
+      sched_yield();
+   else
+      usleep(SIM_THREAD_WORKER_SLEEP_TIME);
+}
+
+void SimThreadWorker::spawn(UInt32 worker_id, UInt32 num_workers)
+{
+   m_worker_id = worker_id;
+   m_num_workers = num_workers;
+   m_thread = Thread::create(this);
+   m_thread->run();
+}
@@ -21,4 +21,23 @@ private:
    Thread *m_thread;
 };
 
+// Worker of the sim thread pool. Serves the network traffic of its own
+// share of the local tiles first, then steals from the tiles of other workers
+class SimThreadWorker : public Runnable
+{
+public:
+   SimThreadWorker();
+   ~SimThreadWorker();
+
+   void spawn(UInt32 worker_id, UInt32 num_workers);
+
+private:
+   void run();
+   void backoff(UInt32 idle_rounds);
+
+   Thread *m_thread;
+   UInt32 m_worker_id;
+   UInt32 m_num_workers;
+};
+
 #endif // SIM_THREAD_H
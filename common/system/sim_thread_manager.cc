@@ -9,19 +9,70 @@
 #include "mcp.h"
 
 SimThreadManager::SimThreadManager()
-   : m_active_threads(0)
+   : m_sim_threads(NULL)
+   , m_num_sim_threads(0)
+   , m_sim_thread_workers(NULL)
+   , m_tile_locks(NULL)
+   , m_tile_active(NULL)
+   , m_num_active_tiles(0)
+   , m_active_threads(0)
 {
+   try
+   {
+      m_num_sim_threads = Sim()->getCfg()->getInt("general/num_sim_threads", 0);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read general/num_sim_threads from the cfg file");
+   }
 }
 
 SimThreadManager::~SimThreadManager()
 {
    LOG_ASSERT_WARNING(m_active_threads == 0,
                       "Threads still active when SimThreadManager exits.");
+
+   delete [] m_sim_thread_workers;
+   delete [] m_tile_active;
+   delete [] m_tile_locks;
 }
 
 void SimThreadManager::spawnSimThreads()
 {
-   UInt32 num_sim_threads = Config::getSingleton()->getNumLocalTiles();
+   UInt32 num_local_tiles = Config::getSingleton()->getNumLocalTiles();
+
+   if ((m_num_sim_threads > 0) && (m_num_sim_threads < num_local_tiles))
+   {
+      LOG_PRINT("Starting %u pooled threads for %u tiles on proc: %d.",
+                m_num_sim_threads, num_local_tiles, Config::getSingleton()->getCurrentProcessNum());
+
+      m_tile_locks = new Lock[num_local_tiles];
+      m_tile_active = new bool[num_local_tiles];
+      m_num_active_tiles = num_local_tiles;
+
+      for (UInt32 i = 0; i < num_local_tiles; i++)
+      {
+         m_tile_active[i] = true;
+         Sim()->getTileManager()->getTileFromIndex(i)->getNetwork()->registerCallback(SIM_THREAD_TERMINATE_THREADS,
+                                                                                      terminateTileFunc,
+                                                                                      this);
+      }
+
+      m_sim_thread_workers = new SimThreadWorker [m_num_sim_threads];
+      for (UInt32 i = 0; i < m_num_sim_threads; i++)
+         m_sim_thread_workers[i].spawn(i, m_num_sim_threads);
+      return;
+   }
+
+   UInt32 num_sim_threads = num_local_tiles;
+
+   // Registered before the threads start, so that no pause request is missed
+   for (UInt32 i = 0; i < num_local_tiles; i++)
+   {
+      Sim()->getTileManager()->getTileFromIndex(i)->getNetwork()->registerCallback(SIM_THREAD_PAUSE_THREADS,
+                                                                                   pauseThreadFunc,
+                                                                                   this);
+   }
 
    LOG_PRINT("Starting %d threads on proc: %d.", num_sim_threads, Config::getSingleton()->getCurrentProcessNum());
 
@@ -74,3 +125,88 @@ void SimThreadManager::simThreadExitCallback()
    --m_active_threads;
    m_active_threads_lock.release();
 }
+
+void SimThreadManager::pauseSimThreads()
+{
+   UInt32 num_local_tiles = Config::getSingleton()->getNumLocalTiles();
+
+   // Pooled workers only serve a tile while holding its lock
+   if (m_sim_thread_workers)
+   {
+      for (UInt32 i = 0; i < num_local_tiles; i++)
+         m_tile_locks[i].acquire();
+      return;
+   }
+
+   // A dedicated sim thread blocks in the transport, so it is sent a pause
+   // packet that it handles after the ones already queued for its tile
+   Transport::Node *global_node = Transport::getSingleton()->getGlobalNode();
+   NetPacket pkt(Time(0), SIM_THREAD_PAUSE_THREADS, (core_id_t) {0,0}, (core_id_t) {0,0}, 0, NULL);
+   const Config::TileList &tile_list = Config::getSingleton()->getTileListForProcess(Config::getSingleton()->getCurrentProcessNum());
+
+   for (UInt32 i = 0; i < num_local_tiles; i++)
+   {
+      core_id_t receiver = Tile::getMainCoreId(tile_list[i]);
+      pkt.receiver.tile_id = receiver.tile_id;
+      pkt.receiver.core_type = receiver.core_type;
+      global_node->send(tile_list[i], &pkt, pkt.bufferSize());
+   }
+
+   for (UInt32 i = 0; i < num_local_tiles; i++)
+      m_paused_sem.wait();
+}
+
+void SimThreadManager::resumeSimThreads()
+{
+   UInt32 num_local_tiles = Config::getSingleton()->getNumLocalTiles();
+
+   if (m_sim_thread_workers)
+   {
+      for (UInt32 i = 0; i < num_local_tiles; i++)
+         m_tile_locks[i].release();
+      return;
+   }
+
+   for (UInt32 i = 0; i < num_local_tiles; i++)
+      m_resume_sem.signal();
+}
+
+void SimThreadManager::pauseThreadFunc(void *vp, NetPacket pkt)
+{
+   SimThreadManager *sim_thread_manager = (SimThreadManager*) vp;
+
+   // Runs on the sim thread of the tile
+   sim_thread_manager->m_paused_sem.signal();
+   sim_thread_manager->m_resume_sem.wait();
+}
+
+bool SimThreadManager::serviceTile(UInt32 tile_index)
+{
+   // Another worker is already serving this tile
+   if (!m_tile_active[tile_index] || !m_tile_locks[tile_index].tryLock())
+      return false;
+
+   bool serviced = false;
+   Network *net = Sim()->getTileManager()->getTileFromIndex(tile_index)->getNetwork();
+
+   // Only pull when a packet is waiting, so that the worker never blocks in the transport
+   if (m_tile_active[tile_index] && net->getTransport()->query())
+   {
+      Sim()->getTileManager()->setSimThreadWorkerTile(tile_index);
+      net->netPullFromTransport();
+      serviced = true;
+   }
+
+   m_tile_locks[tile_index].release();
+   return serviced;
+}
+
+void SimThreadManager::terminateTileFunc(void *vp, NetPacket pkt)
+{
+   SimThreadManager *sim_thread_manager = (SimThreadManager*) vp;
+   UInt32 tile_index = Sim()->getTileManager()->getTileIndexFromID(pkt.receiver.tile_id);
+
+   // Called with the tile lock held
+   sim_thread_manager->m_tile_active[tile_index] = false;
+   __sync_fetch_and_sub(&sim_thread_manager->m_num_active_tiles, 1);
+}
@@ -2,6 +2,8 @@
 #define SIM_THREAD_MANAGER_H
 
 #include "sim_thread.h"
+#include "lock.h"
+#include "semaphore.h"
 
 class SimThreadManager
 {
@@ -14,12 +16,35 @@ public:
 
    void simThreadStartCallback();
    void simThreadExitCallback();
+
+   // Holds every local sim thread between two packets until
+   // resumeSimThreads(), so that the tile state they update is stable
+   void pauseSimThreads();
+   void resumeSimThreads();
+
+   // Sim thread pool
+   bool serviceTile(UInt32 tile_index);
+   UInt32 getNumActiveTiles() const { return m_num_active_tiles; }
    
 private:
+   static void terminateTileFunc(void *vp, NetPacket pkt);
+   static void pauseThreadFunc(void *vp, NetPacket pkt);
+
    SimThread *m_sim_threads;
 
+   // Sim thread pool: used when there are fewer sim threads than local tiles
+   UInt32 m_num_sim_threads;
+   SimThreadWorker *m_sim_thread_workers;
+   Lock *m_tile_locks;
+   volatile bool *m_tile_active;
+   volatile UInt32 m_num_active_tiles;
+
    Lock m_active_threads_lock;
    UInt32 m_active_threads;
+
+   // Dedicated sim threads: paused in a network callback
+   Semaphore m_paused_sem;
+   Semaphore m_resume_sem;
 };
 
 #endif // SIM_THREAD_MANAGER
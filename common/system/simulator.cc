@@ -13,6 +13,7 @@
 #include "thread_manager.h"
 #include "thread_scheduler.h"
 #include "performance_counter_manager.h"
+#include "checkpoint_manager.h"
 #include "sim_thread_manager.h"
 #include "clock_skew_management_object.h"
 #include "statistics_manager.h"
@@ -66,6 +67,7 @@ Simulator::Simulator()
    , m_thread_manager(NULL)
    , m_thread_scheduler(NULL)
    , m_performance_counter_manager(NULL)
+   , m_checkpoint_manager(NULL)
    , m_sim_thread_manager(NULL)
    , m_clock_skew_management_manager(NULL)
    , m_statistics_manager(NULL)
@@ -109,6 +111,7 @@ void Simulator::start()
    m_thread_manager = new ThreadManager(m_tile_manager);
    m_thread_scheduler = ThreadScheduler::create(m_thread_manager, m_tile_manager);
    m_performance_counter_manager = new PerformanceCounterManager();
+   m_checkpoint_manager = new CheckpointManager();
    m_sim_thread_manager = new SimThreadManager();
    m_clock_skew_management_manager = ClockSkewManagementManager::create(getCfg()->getString("clock_skew_management/scheme"));
    
@@ -187,6 +190,7 @@ Simulator::~Simulator()
       delete m_clock_skew_management_manager;
 
    delete m_sim_thread_manager;
+   delete m_checkpoint_manager;
    delete m_performance_counter_manager;
    delete m_thread_manager;
    delete m_thread_scheduler;
@@ -286,6 +290,9 @@ bool Simulator::finished()
 
 void Simulator::enableModels()
 {
+   // Checkpoints are taken before any statistics are collected
+   m_checkpoint_manager->handleModelsEnabled();
+
    startTimer();
    m_enabled = true;
    for (UInt32 i = 0; i < m_config.getNumLocalTiles(); i++)
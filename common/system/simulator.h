@@ -13,6 +13,7 @@ class Thread;
 class ThreadManager;
 class ThreadScheduler;
 class PerformanceCounterManager;
+class CheckpointManager;
 class SimThreadManager;
 class ClockSkewManagementManager;
 class StatisticsManager;
@@ -38,6 +39,7 @@ public:
    ThreadManager *getThreadManager() { return m_thread_manager; }
    ThreadScheduler *getThreadScheduler() { return m_thread_scheduler; }
    PerformanceCounterManager *getPerformanceCounterManager() { return m_performance_counter_manager; }
+   CheckpointManager *getCheckpointManager() { return m_checkpoint_manager; }
    ClockSkewManagementManager *getClockSkewManagementManager() { return m_clock_skew_management_manager; }
    StatisticsManager *getStatisticsManager() { return m_statistics_manager; } 
    StatisticsThread *getStatisticsThread() { return m_statistics_thread; } 
@@ -82,6 +84,7 @@ private:
    ThreadManager *m_thread_manager;
    ThreadScheduler *m_thread_scheduler;
    PerformanceCounterManager *m_performance_counter_manager;
+   CheckpointManager *m_checkpoint_manager;
    SimThreadManager *m_sim_thread_manager;
    ClockSkewManagementManager *m_clock_skew_management_manager;
    StatisticsManager *m_statistics_manager;
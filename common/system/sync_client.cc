@@ -5,6 +5,7 @@
 #include "tile.h"
 #include "packetize.h"
 #include "mcp.h"
+#include "distributed_sync_server.h"
 
 #include "simulator.h"
 #include "thread_scheduler.h"
@@ -17,6 +18,7 @@ using namespace std;
 SyncClient::SyncClient(Core *core)
       : m_core(core)
       , m_network(core->getTile()->getNetwork())
+      , m_distributed_mutexes(DistributedSyncServer::isEnabled())
 {
 }
 
@@ -42,7 +44,7 @@ void SyncClient::mutexInit(carbon_mutex_t *mux)
 
    *mux = *((carbon_mutex_t*)recv_pkt.data);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::mutexLock(carbon_mutex_t *mux)
@@ -58,13 +60,16 @@ void SyncClient::mutexLock(carbon_mutex_t *mux)
    m_send_buff << msg_type << *mux << start_time;
 
    LOG_PRINT("mutexLock(): mux(%u), start_time(%llu ps)", *mux, start_time);
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   if (m_distributed_mutexes)
+      DistributedSyncServer::sendRequest(m_network, DistributedSyncServer::MUTEX_LOCK, m_core->getId(), *mux, start_time);
+   else
+      m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // Set the CoreState to 'STALLED'
    m_core->setState(Core::STALLED);
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), m_core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = recvMutexLockResponse(*mux);
    assert(recv_pkt.length == sizeof(unsigned int) + sizeof(UInt64));
 
    // Set the CoreState to 'RUNNING'
@@ -87,7 +92,7 @@ void SyncClient::mutexLock(carbon_mutex_t *mux)
       }
    }
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::mutexUnlock(carbon_mutex_t *mux)
@@ -103,10 +108,19 @@ void SyncClient::mutexUnlock(carbon_mutex_t *mux)
    m_send_buff << msg_type << *mux << start_time;
 
    LOG_PRINT("mutexUnlock(): mux(%u), start_time(%llu ps)", *mux, start_time);
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   core_id_t server = Config::getSingleton()->getMCPCoreId();
+   if (m_distributed_mutexes)
+   {
+      DistributedSyncServer::sendRequest(m_network, DistributedSyncServer::MUTEX_UNLOCK, m_core->getId(), *mux, start_time);
+      server = DistributedSyncServer::getHome(*mux);
+   }
+   else
+   {
+      m_network->netSend(server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   }
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), m_core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(server, m_core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(unsigned int));
 
    unsigned int dummy;
@@ -114,7 +128,7 @@ void SyncClient::mutexUnlock(carbon_mutex_t *mux)
    m_recv_buff >> dummy;
    assert(dummy == MUTEX_UNLOCK_RESPONSE);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::condInit(carbon_cond_t *cond)
@@ -137,7 +151,7 @@ void SyncClient::condInit(carbon_cond_t *cond)
 
    *cond = *((carbon_cond_t*)recv_pkt.data);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::condWait(carbon_cond_t *cond, carbon_mutex_t *mux)
@@ -159,7 +173,7 @@ void SyncClient::condWait(carbon_cond_t *cond, carbon_mutex_t *mux)
    m_core->setState(Core::STALLED);
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), m_core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = recvMutexLockResponse(*mux);
    assert(recv_pkt.length == sizeof(unsigned int) + sizeof(UInt64));
 
    // Set the CoreState to 'RUNNING'
@@ -182,7 +196,7 @@ void SyncClient::condWait(carbon_cond_t *cond, carbon_mutex_t *mux)
       }
    }
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::condSignal(carbon_cond_t *cond)
@@ -209,7 +223,7 @@ void SyncClient::condSignal(carbon_cond_t *cond)
    m_recv_buff >> dummy;
    assert(dummy == COND_SIGNAL_RESPONSE);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::condBroadcast(carbon_cond_t *cond)
@@ -236,7 +250,7 @@ void SyncClient::condBroadcast(carbon_cond_t *cond)
    m_recv_buff >> dummy;
    assert(dummy == COND_BROADCAST_RESPONSE);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::barrierInit(carbon_barrier_t *barrier, UInt32 count)
@@ -259,7 +273,7 @@ void SyncClient::barrierInit(carbon_barrier_t *barrier, UInt32 count)
 
    *barrier = *((carbon_barrier_t*)recv_pkt.data);
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
 }
 
 void SyncClient::barrierWait(carbon_barrier_t *barrier)
@@ -314,5 +328,17 @@ void SyncClient::barrierWait(carbon_barrier_t *barrier)
       }
    }
 
-   delete [](Byte*) recv_pkt.data;
+   recv_pkt.release();
+}
+
+NetPacket SyncClient::recvMutexLockResponse(carbon_mutex_t mux)
+{
+   NetMatch match;
+   match.senders.push_back(Config::getSingleton()->getMCPCoreId());
+   if (m_distributed_mutexes)
+      match.senders.push_back(DistributedSyncServer::getHome(mux));
+   match.types.push_back(MCP_RESPONSE_TYPE);
+   match.receiver = m_core->getId();
+
+   return m_network->netRecv(match);
 }
@@ -6,6 +6,7 @@
 
 class Core;
 class Network;
+class NetPacket;
 
 class SyncClient
 {
@@ -48,6 +49,14 @@ class SyncClient
       UnstructuredBuffer m_send_buff;
       UnstructuredBuffer m_recv_buff;
 
+      // Mutexes are served by their home tiles (see DistributedSyncServer)
+      bool m_distributed_mutexes;
+
+      // Receives the reply to a mutex lock or condition variable wait, which
+      // comes from the home tile of the mutex or, if the thread had to
+      // wait, from the MCP
+      NetPacket recvMutexLockResponse(carbon_mutex_t mux);
+
 };
 
 #endif
@@ -1,5 +1,6 @@
 #include "sync_server.h"
 #include "sync_client.h"
+#include "distributed_sync_server.h"
 #include "simulator.h"
 #include "thread_manager.h"
 #include "tile_manager.h"
@@ -7,12 +8,6 @@
 
 using namespace std;
 
-struct Reply
-{
-   UInt32 dummy;
-   UInt64 time __attribute__((packed));
-};
-
 // -- SimMutex -- //
 
 SimMutex::SimMutex()
@@ -62,6 +57,7 @@ SimCond::SimCond() {}
 SimCond::~SimCond()
 {
    assert(m_waiting.empty());
+   assert(m_remote_waiting.empty());
 }
 
 core_id_t SimCond::wait(core_id_t core_id, UInt64 time, StableIterator<SimMutex> & simMux)
@@ -118,6 +114,35 @@ void SimCond::broadcast(core_id_t core_id, UInt64 time, WakeupList &woken_list)
    m_waiting.clear();
 }
 
+void SimCond::waitRemote(core_id_t core_id, carbon_mutex_t mux)
+{
+   Sim()->getThreadManager()->stallThread(core_id);
+
+   m_remote_waiting.push_back(RemoteWaiter(core_id, mux));
+}
+
+bool SimCond::signalRemote(RemoteWaiter &woken)
+{
+   if (m_remote_waiting.empty())
+      return false;
+
+   woken = *(m_remote_waiting.begin());
+   m_remote_waiting.erase(m_remote_waiting.begin());
+
+   // The woken up thread stalls again on the home tile if it can not grab the lock
+   Sim()->getThreadManager()->resumeThread(woken.first);
+   return true;
+}
+
+void SimCond::broadcastRemote(RemoteWakeupList &woken_list)
+{
+   for (RemoteWakeupList::iterator i = m_remote_waiting.begin(); i != m_remote_waiting.end(); i++)
+      Sim()->getThreadManager()->resumeThread(i->first);
+
+   woken_list.swap(m_remote_waiting);
+   m_remote_waiting.clear();
+}
+
 // -- SimBarrier -- //
 SimBarrier::SimBarrier(UInt32 count)
       : m_count(count)
@@ -167,7 +192,8 @@ void SimBarrier::wait(core_id_t core_id, UInt64 time, WakeupList &woken_list)
 // -- SyncServer -- //
 
 SyncServer::SyncServer(Network &network, UnstructuredBuffer &recv_buffer)
-      : m_network(network),
+      : m_distributed_mutexes(DistributedSyncServer::isEnabled()),
+      m_network(network),
       m_recv_buffer(recv_buffer)
 { }
 
@@ -176,6 +202,7 @@ SyncServer::~SyncServer()
 
 void SyncServer::mutexInit(core_id_t core_id)
 {
+   // Mutex ids are handed out here even when the mutexes are served by their home tiles
    m_mutexes.push_back(SimMutex());
    UInt32 mux = (UInt32)m_mutexes.size()-1;
 
@@ -239,6 +266,33 @@ void SyncServer::mutexUnlock(core_id_t core_id)
    m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&dummy, sizeof(dummy));
 }
 
+void SyncServer::mutexStall(core_id_t core_id)
+{
+   core_id_t requester;
+   UInt64 time;
+   m_recv_buffer >> requester >> time;
+
+   LOG_PRINT("mutexStall(): core(%i), time(%llu ps), home(%i)", requester.tile_id, time, core_id.tile_id);
+   Sim()->getThreadManager()->stallThread(requester);
+}
+
+void SyncServer::mutexHandOff(core_id_t core_id)
+{
+   core_id_t new_owner;
+   UInt64 time;
+   m_recv_buffer >> new_owner >> time;
+
+   LOG_PRINT("mutexHandOff(): core(%i), time(%llu ps), home(%i)", new_owner.tile_id, time, core_id.tile_id);
+   Sim()->getThreadManager()->resumeThread(new_owner);
+
+   // wake up the new owner
+   // (the reply comes from here, so it is ordered after the resume)
+   Reply r;
+   r.dummy = SyncClient::MUTEX_LOCK_RESPONSE;
+   r.time = time;
+   m_network.netSend(new_owner, MCP_RESPONSE_TYPE, (char*)&r, sizeof(r));
+}
+
 // -- Condition Variable Stuffs -- //
 void SyncServer::condInit(core_id_t core_id)
 {
@@ -263,6 +317,14 @@ void SyncServer::condWait(core_id_t core_id)
 
    SimCond *psimcond = &m_conds[cond];
 
+   if (m_distributed_mutexes)
+   {
+      // The home tile of the mutex wakes up its next owner
+      psimcond->waitRemote(core_id, mux);
+      DistributedSyncServer::sendRequest(&m_network, DistributedSyncServer::MUTEX_RELEASE, core_id, mux, time);
+      return;
+   }
+
    StableIterator<SimMutex> it(m_mutexes, mux);
    core_id_t new_mutex_owner = psimcond->wait(core_id, time, it);
 
@@ -290,6 +352,19 @@ void SyncServer::condSignal(core_id_t core_id)
 
    SimCond *psimcond = &m_conds[cond];
 
+   if (m_distributed_mutexes)
+   {
+      // The woken up thread re-acquires the mutex on its home tile, which
+      // replies to it (note: COND_WAIT_RESPONSE == MUTEX_LOCK_RESPONSE)
+      SimCond::RemoteWaiter woken;
+      if (psimcond->signalRemote(woken))
+         DistributedSyncServer::sendRequest(&m_network, DistributedSyncServer::MUTEX_LOCK, woken.first, woken.second, time);
+
+      UInt32 dummy = SyncClient::COND_SIGNAL_RESPONSE;
+      m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&dummy, sizeof(dummy));
+      return;
+   }
+
    core_id_t woken = psimcond->signal(core_id, time);
 
    if (woken.tile_id != INVALID_TILE_ID)
@@ -323,6 +398,18 @@ void SyncServer::condBroadcast(core_id_t core_id)
 
    SimCond *psimcond = &m_conds[cond];
 
+   if (m_distributed_mutexes)
+   {
+      SimCond::RemoteWakeupList woken_list;
+      psimcond->broadcastRemote(woken_list);
+      for (SimCond::RemoteWakeupList::iterator it = woken_list.begin(); it != woken_list.end(); it++)
+         DistributedSyncServer::sendRequest(&m_network, DistributedSyncServer::MUTEX_LOCK, it->first, it->second, time);
+
+      UInt32 dummy = SyncClient::COND_BROADCAST_RESPONSE;
+      m_network.netSend(core_id, MCP_RESPONSE_TYPE, (char*)&dummy, sizeof(dummy));
+      return;
+   }
+
    SimCond::WakeupList woken_list;
    psimcond->broadcast(core_id, time, woken_list);
 
@@ -12,6 +12,12 @@
 #include "packetize.h"
 #include "stable_iterator.h"
 
+struct Reply
+{
+   UInt32 dummy;
+   UInt64 time __attribute__((packed));
+};
+
 class SimMutex
 {
    public:
@@ -48,6 +54,16 @@ class SimCond
       core_id_t signal(core_id_t core_id, UInt64 time);
       void broadcast(core_id_t core_id, UInt64 time, WakeupList &woken);
 
+      // With general/distributed_sync, the mutex lives on its home tile
+      // and is released and re-acquired there by the server
+      typedef std::pair<core_id_t, carbon_mutex_t> RemoteWaiter;
+      typedef std::vector<RemoteWaiter> RemoteWakeupList;
+
+      void waitRemote(core_id_t core_id, carbon_mutex_t mux);
+      // returns false if no thread was waiting
+      bool signalRemote(RemoteWaiter &woken);
+      void broadcastRemote(RemoteWakeupList &woken);
+
    private:
       class CondWaiter
       {
@@ -61,6 +77,7 @@ class SimCond
 
       typedef std::vector< CondWaiter > ThreadQueue;
       ThreadQueue m_waiting;
+      RemoteWakeupList m_remote_waiting;
 };
 
 class SimBarrier
@@ -93,6 +110,9 @@ class SyncServer
       CondVector m_conds;
       BarrierVector m_barriers;
 
+      // Mutexes are served by their home tiles (see DistributedSyncServer)
+      bool m_distributed_mutexes;
+
       // FIXME: This should be better organized -- too much redundant crap
 
    public:
@@ -104,6 +124,9 @@ class SyncServer
       void mutexInit(core_id_t core_id);
       void mutexLock(core_id_t core_id);
       void mutexUnlock(core_id_t core_id);
+      // Sent by the home tile of a mutex with general/distributed_sync
+      void mutexStall(core_id_t core_id);
+      void mutexHandOff(core_id_t core_id);
 
       void condInit(core_id_t core_id);
       void condWait(core_id_t core_id);
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "syscall_io_service.h"
+#include "packetize.h"
+#include "simulator.h"
+#include "config.h"
+#include "log.h"
+
+// -- SyscallIORequest -- //
+
+SyscallIORequest::SyscallIORequest(core_id_t core_id_, IntPtr syscall_number_, int fd_, UInt64 count_)
+   : core_id(core_id_)
+   , syscall_number(syscall_number_)
+   , fd(fd_)
+   , count(count_)
+   , data(new char[count_])
+   , received(0)
+{}
+
+SyscallIORequest::~SyscallIORequest()
+{
+   delete [] data;
+}
+
+// -- SyscallIOService -- //
+
+SyscallIOService::SyscallIOService(Network& network)
+   : m_network(network)
+   , m_chunk_size(getChunkSize())
+   , m_num_workers(0)
+   , m_workers(NULL)
+   , m_stopping(false)
+   , m_num_running_workers(0)
+{
+   try
+   {
+      m_num_workers = Sim()->getCfg()->getInt("syscall_server/num_io_threads", 0);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read syscall_server/num_io_threads from the cfg file");
+   }
+
+   if (m_num_workers > 0)
+   {
+      LOG_PRINT("Starting %u syscall I/O threads", m_num_workers);
+      m_num_running_workers = m_num_workers;
+      m_workers = new Worker[m_num_workers];
+      for (UInt32 i = 0; i < m_num_workers; i++)
+         m_workers[i].spawn(this);
+   }
+}
+
+SyscallIOService::~SyscallIOService()
+{
+   if (m_num_workers == 0)
+      return;
+
+   // The workers drain the queue before they exit
+   m_lock.acquire();
+   m_stopping = true;
+   m_request_cond.broadcast();
+   while (m_num_running_workers > 0)
+      m_exit_cond.wait(m_lock);
+   m_lock.release();
+
+   delete [] m_workers;
+}
+
+UInt32 SyscallIOService::getChunkSize()
+{
+   UInt32 chunk_size = 0;
+   try
+   {
+      chunk_size = Sim()->getCfg()->getInt("syscall_server/chunk_size", 65536);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read syscall_server/chunk_size from the cfg file");
+   }
+   LOG_ASSERT_ERROR(chunk_size > 0, "syscall_server/chunk_size must be non-zero");
+   return chunk_size;
+}
+
+// Called by the MCP thread
+void SyscallIOService::submit(SyscallIORequest* request)
+{
+   assert(request->isComplete());
+
+   if (m_num_workers == 0)
+   {
+      execute(request);
+      return;
+   }
+
+   ScopedLock sl(m_lock);
+   m_requests.push(request);
+   m_request_cond.signal();
+}
+
+// Called by the I/O threads. Returns NULL once the service stops
+SyscallIORequest* SyscallIOService::dequeue()
+{
+   ScopedLock sl(m_lock);
+   while (m_requests.empty() && !m_stopping)
+      m_request_cond.wait(m_lock);
+
+   if (m_requests.empty())
+      return NULL;
+
+   SyscallIORequest* request = m_requests.front();
+   m_requests.pop();
+   return request;
+}
+
+void SyscallIOService::workerExited()
+{
+   ScopedLock sl(m_lock);
+   m_num_running_workers --;
+   m_exit_cond.signal();
+}
+
+void SyscallIOService::execute(SyscallIORequest* request)
+{
+   switch (request->syscall_number)
+   {
+   case SYS_read:
+      executeRead(request);
+      break;
+
+   case SYS_write:
+   case SYS_writev:
+      executeWrite(request);
+      break;
+
+   case SYS_stat:
+   case SYS_lstat:
+      executeStat(request);
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unhandled I/O syscall number: %i from %i", (int) request->syscall_number, request->core_id.tile_id);
+      break;
+   }
+
+   delete request;
+}
+
+void SyscallIOService::executeRead(SyscallIORequest* request)
+{
+   /*
+       Transmit
+
+       Field               Type
+       -----------------|--------
+       STATUS              int
+       BUFFER              char[]     (first chunk)
+
+       followed by one packet per remaining chunk of BUFFER
+   */
+
+   // Actually do the read call
+   int bytes = syscall(SYS_read, request->fd, (void *) request->data, request->count);
+
+   LOG_PRINT("Read(%i,%llu) returns %i", request->fd, request->count, bytes);
+
+   UInt32 first_chunk = (bytes > 0) ? std::min<UInt64>(bytes, m_chunk_size) : 0;
+
+   UnstructuredBuffer send_buff;
+   send_buff << bytes << make_pair(request->data, first_chunk);
+   m_network.netSend(request->core_id, MCP_RESPONSE_TYPE, send_buff.getBuffer(), send_buff.size());
+
+   for (UInt64 offset = first_chunk; offset < (UInt64) std::max(bytes, 0); offset += m_chunk_size)
+   {
+      UInt32 chunk = std::min<UInt64>(bytes - offset, m_chunk_size);
+      m_network.netSend(request->core_id, MCP_RESPONSE_TYPE, request->data + offset, chunk);
+   }
+}
+
+void SyscallIOService::executeWrite(SyscallIORequest* request)
+{
+   // Since the data of all the iovec's passed to writev has already been
+   // gathered, writev is just a write syscall
+   IntPtr bytes = syscall(SYS_write, request->fd, (void *) request->data, request->count);
+
+   LOG_PRINT("Write(%i,%llu) returns %i", request->fd, request->count, (int) bytes);
+
+   UnstructuredBuffer send_buff;
+   if (request->syscall_number == SYS_write)
+      send_buff << (int) bytes;
+   else
+      send_buff << bytes;
+   m_network.netSend(request->core_id, MCP_RESPONSE_TYPE, send_buff.getBuffer(), send_buff.size());
+}
+
+void SyscallIOService::executeStat(SyscallIORequest* request)
+{
+   struct stat stat_buf;
+
+   // Do the syscall
+   int ret = syscall(request->syscall_number, request->data, &stat_buf);
+
+   // pack the data and send
+   UnstructuredBuffer send_buff;
+   send_buff.put<int>(ret);
+   send_buff << make_pair(&stat_buf, sizeof(struct stat));
+   m_network.netSend(request->core_id, MCP_RESPONSE_TYPE, send_buff.getBuffer(), send_buff.size());
+
+   LOG_PRINT("Finished stat(), path(%s)", request->data);
+}
+
+// -- SyscallIOService::Worker -- //
+
+SyscallIOService::Worker::~Worker()
+{
+   delete m_thread;
+}
+
+void SyscallIOService::Worker::spawn(SyscallIOService* service)
+{
+   m_service = service;
+   m_thread = Thread::create(this);
+   m_thread->run();
+}
+
+void SyscallIOService::Worker::run()
+{
+   SyscallIORequest* request;
+   while ((request = m_service->dequeue()) != NULL)
+      m_service->execute(request);
+
+   m_service->workerExited();
+}
@@ -0,0 +1,87 @@
+#ifndef SYSCALL_IO_SERVICE_H
+#define SYSCALL_IO_SERVICE_H
+
+#include <queue>
+
+#include "fixed_types.h"
+#include "network.h"
+#include "thread.h"
+#include "lock.h"
+#include "cond.h"
+
+// A file I/O syscall (read, write, writev, stat, lstat) whose arguments
+// have been copied out of the MCP's receive buffer
+class SyscallIORequest
+{
+public:
+   SyscallIORequest(core_id_t core_id_, IntPtr syscall_number_, int fd_, UInt64 count_);
+   ~SyscallIORequest();
+
+   bool isComplete() const { return received == count; }
+
+   core_id_t core_id;
+   IntPtr syscall_number;
+   int fd;
+   // Payload (write, writev) or path (stat, lstat)
+   UInt64 count;
+   char* data;
+   // Bytes of a chunked payload received so far
+   UInt64 received;
+};
+
+// Executes file I/O syscalls for the SyscallServer
+//
+// With syscall_server/num_io_threads > 0, the requests are queued to a pool
+// of I/O threads that execute them and reply to the requesting core, so a
+// long file operation does not hold up the MCP. Payloads larger than
+// syscall_server/chunk_size go over the network in several packets: the
+// first one carries the header and the first chunk, the following ones
+// carry the rest of the data.
+class SyscallIOService
+{
+public:
+   SyscallIOService(Network& network);
+   ~SyscallIOService();
+
+   static UInt32 getChunkSize();
+
+   // Takes ownership of the request
+   void submit(SyscallIORequest* request);
+
+private:
+   class Worker : public Runnable
+   {
+   public:
+      Worker() : m_service(NULL), m_thread(NULL) {}
+      ~Worker();
+      void spawn(SyscallIOService* service);
+      void run();
+   private:
+      SyscallIOService* m_service;
+      Thread* m_thread;
+   };
+
+   Network& m_network;
+   UInt32 m_chunk_size;
+
+   UInt32 m_num_workers;
+   Worker* m_workers;
+
+   // Request queue, protected by m_lock
+   Lock m_lock;
+   ConditionVariable m_request_cond;
+   ConditionVariable m_exit_cond;
+   std::queue<SyscallIORequest*> m_requests;
+   bool m_stopping;
+   UInt32 m_num_running_workers;
+
+   SyscallIORequest* dequeue();
+   void workerExited();
+
+   void execute(SyscallIORequest* request);
+   void executeRead(SyscallIORequest* request);
+   void executeWrite(SyscallIORequest* request);
+   void executeStat(SyscallIORequest* request);
+};
+
+#endif // SYSCALL_IO_SERVICE_H
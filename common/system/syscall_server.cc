@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <algorithm>
 
 #include "syscall_server.h"
 #include "sys/syscall.h"
@@ -26,17 +27,22 @@ using namespace std;
 SyscallServer::SyscallServer(Network & network,
                              UnstructuredBuffer & send_buff_, UnstructuredBuffer &recv_buff_,
                              const UInt32 SERVER_MAX_BUFF,
-                             char *scratch_)
+                             char *scratch_,
+                             SInt32 process_num)
    : m_network(network)
    , m_send_buff(send_buff_)
    , m_recv_buff(recv_buff_)
    , m_SYSCALL_SERVER_MAX_BUFF(SERVER_MAX_BUFF)
    , m_scratch(scratch_)
+   , m_process_num(process_num)
+   , m_io_service(network)
 {
 }
 
 SyscallServer::~SyscallServer()
 {
+   for (PendingRequestMap::iterator it = m_pending_requests.begin(); it != m_pending_requests.end(); it++)
+      delete it->second;
 }
 
 
@@ -143,6 +149,79 @@ void SyscallServer::handleSyscall(core_id_t core_id)
    LOG_PRINT("Finished syscall: %d", syscall_number);
 }
 
+bool SyscallServer::isPerProcessEnabled()
+{
+   // Per-process servers are hosted on the thread spawner tiles
+   if (Config::getSingleton()->getSimulationMode() != Config::FULL)
+      return false;
+
+   try
+   {
+      return Sim()->getCfg()->getBool("syscall_server/per_process", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read syscall_server/per_process from the cfg file");
+      return false;
+   }
+}
+
+UInt32 SyscallServer::getFdProcess(int fd)
+{
+   assert(isProcessFd(fd));
+   return (fd - PROCESS_FD_BASE) % Config::getSingleton()->getProcessCount();
+}
+
+int SyscallServer::getHostFd(int fd)
+{
+   assert(isProcessFd(fd));
+   return (fd - PROCESS_FD_BASE) / Config::getSingleton()->getProcessCount();
+}
+
+int SyscallServer::getProcessFd(int host_fd, UInt32 process_num)
+{
+   return PROCESS_FD_BASE + host_fd * Config::getSingleton()->getProcessCount() + process_num;
+}
+
+void SyscallServer::handleSyscallData(core_id_t core_id)
+{
+   PendingRequestMap::iterator it = m_pending_requests.find(core_id.tile_id);
+   LOG_ASSERT_ERROR(it != m_pending_requests.end(), "Unexpected syscall data from core(%i, %i)", core_id.tile_id, core_id.core_type);
+
+   SyscallIORequest* request = it->second;
+   UInt32 chunk = m_recv_buff.size();
+   LOG_ASSERT_ERROR(request->received + chunk <= request->count, "Syscall payload from core(%i, %i) overflows (%llu + %u > %llu)",
+                    core_id.tile_id, core_id.core_type, request->received, chunk, request->count);
+   m_recv_buff >> make_pair(request->data + request->received, chunk);
+   request->received += chunk;
+
+   if (request->isComplete())
+   {
+      m_pending_requests.erase(it);
+      m_io_service.submit(request);
+   }
+}
+
+// The payload arrives in chunks of SyscallIOService::getChunkSize() bytes;
+// the first one is in the request itself
+void SyscallServer::receivePayload(SyscallIORequest* request)
+{
+   UInt64 chunk = std::min<UInt64>(request->count, m_recv_buff.size());
+   m_recv_buff >> make_pair(request->data, chunk);
+   request->received = chunk;
+
+   if (request->isComplete())
+   {
+      m_io_service.submit(request);
+   }
+   else
+   {
+      LOG_ASSERT_ERROR(m_pending_requests.find(request->core_id.tile_id) == m_pending_requests.end(),
+                       "Core(%i, %i) already has a syscall in flight", request->core_id.tile_id, request->core_id.core_type);
+      m_pending_requests[request->core_id.tile_id] = request;
+   }
+}
+
 void SyscallServer::marshallOpenCall(core_id_t core_id)
 {
 
@@ -179,6 +258,14 @@ void SyscallServer::marshallOpenCall(core_id_t core_id)
    // Actually do the open call
    int ret = syscall(SYS_open, path, flags, mode);
 
+   if (ret >= 0)
+   {
+      if (m_process_num >= 0)
+         ret = getProcessFd(ret, m_process_num);
+      else
+         LOG_ASSERT_ERROR(!isProcessFd(ret), "Open(%s) returns fd(%i), which collides with the per-process fds", path, ret);
+   }
+
    m_send_buff << ret;
 
    LOG_PRINT("Open(%s,%i) returns %i", path, flags, ret);
@@ -210,28 +297,13 @@ void SyscallServer::marshallReadCall(core_id_t core_id)
    */
 
    int fd;
-   char *read_buf = (char *) m_scratch;
    size_t count;
 
    assert(m_recv_buff.size() == (sizeof(fd) + sizeof(count)));
    m_recv_buff >> fd >> count;
 
-   if (count > m_SYSCALL_SERVER_MAX_BUFF)
-      read_buf = new char[count];
-
-   // Actually do the read call
-   int bytes = syscall(SYS_read, fd, (void *) read_buf, count);
-
-   m_send_buff << bytes;
-   if (bytes != -1)
-      m_send_buff << make_pair(read_buf, bytes);
-
-   LOG_PRINT("Read(%i,%i) returns %i", fd, count, bytes);
-
-   m_network.netSend(core_id, MCP_RESPONSE_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-
-   if (count > m_SYSCALL_SERVER_MAX_BUFF)
-      delete [] read_buf;
+   // Executed (and answered in chunks) by the I/O service
+   m_io_service.submit(new SyscallIORequest(core_id, SYS_read, fd, count));
 }
 
 
@@ -256,31 +328,14 @@ void SyscallServer::marshallWriteCall(core_id_t core_id)
    */
 
    int fd;
-   char *buf = (char *) m_scratch;
    size_t count;
 
    m_recv_buff >> fd >> count;
 
-   if (count > m_SYSCALL_SERVER_MAX_BUFF)
-      buf = new char[count];
-
    // All data is always passed in the message, even if shared memory is available
    // I think this is a reasonable model and is definitely one less thing to keep
    // track of when you switch between shared-memory/no shared-memory
-   m_recv_buff >> make_pair(buf, count);
-
-   // Actually do the write call
-   int bytes = syscall(SYS_write, fd, (void *) buf, count);
-
-   m_send_buff << bytes;
-
-   LOG_PRINT("Write(%i,%i) returns %i", fd, count, bytes);
-
-   m_network.netSend(core_id, MCP_RESPONSE_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-
-   if (count > m_SYSCALL_SERVER_MAX_BUFF)
-      delete[] buf;
-
+   receivePayload(new SyscallIORequest(core_id, SYS_write, fd, count));
 }
 
 void SyscallServer::marshallWritevCall(core_id_t core_id)
@@ -302,26 +357,10 @@ void SyscallServer::marshallWritevCall(core_id_t core_id)
 
    int fd;
    UInt64 count;
-   char *buf = (char*) m_scratch;
 
    m_recv_buff >> fd >> count;
 
-   if(count > m_SYSCALL_SERVER_MAX_BUFF)
-      buf = new char[count];
-
-   m_recv_buff >> make_pair(buf, count);
-
-   // Write data to the file
-   // Since we have already gathered data from all the various iovec's 
-   // passed to the writev syscall, this is just a write syscall
-   IntPtr bytes = syscall(SYS_write, fd, (void*) buf, count);
-
-   m_send_buff << bytes;
-
-   m_network.netSend(core_id, MCP_RESPONSE_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-
-   if(count > m_SYSCALL_SERVER_MAX_BUFF)
-      delete[] buf;
+   receivePayload(new SyscallIORequest(core_id, SYS_writev, fd, count));
 }
 
 void SyscallServer::marshallCloseCall(core_id_t core_id)
@@ -394,9 +433,6 @@ void SyscallServer::marshallAccessCall(core_id_t core_id)
 
 void SyscallServer::marshallStatCall(IntPtr syscall_number, core_id_t core_id)
 {
-   char *path = (char *) m_scratch;
-   struct stat stat_buf;
-
    UInt32 len_fname;
    // unpack the data
 
@@ -404,21 +440,12 @@ void SyscallServer::marshallStatCall(IntPtr syscall_number, core_id_t core_id)
    
    assert(m_recv_buff.size() == ((SInt32) (len_fname + sizeof(struct stat))));
 
-   if (len_fname > m_SYSCALL_SERVER_MAX_BUFF)
-      path = new char[len_fname];
-
-   m_recv_buff >> make_pair(path, len_fname);
-   m_recv_buff >> make_pair(&stat_buf, sizeof(struct stat));
-
-   // Do the syscall
-   int ret = syscall(syscall_number, path, &stat_buf);
+   // The stat buffer sent along is not needed by the host syscall
+   SyscallIORequest* request = new SyscallIORequest(core_id, syscall_number, -1, len_fname);
+   m_recv_buff >> make_pair(request->data, len_fname);
+   request->received = len_fname;
 
-   // pack the data and send
-   m_send_buff.put<int>(ret);
-   m_send_buff << make_pair(&stat_buf, sizeof(struct stat));
-
-   m_network.netSend(core_id, MCP_RESPONSE_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-   LOG_PRINT("Finished marshallStatCall(), path(%s), send_buf.size(%u)", path, m_send_buff.size());
+   m_io_service.submit(request);
 }
 
 void SyscallServer::marshallFstatCall(core_id_t core_id)
@@ -21,6 +21,7 @@
 #include "transport.h"
 #include "fixed_types.h"
 #include "network.h"
+#include "syscall_io_service.h"
 
 // -- Special Class to Handle Futexes
 class SimFutex
@@ -39,14 +40,30 @@ public:
 class SyscallServer
 {
 public:
+   // process_num is the process whose file I/O a per-process server
+   // handles, or -1 for the MCP
    SyscallServer(Network &network,
                  UnstructuredBuffer &send_buff_, UnstructuredBuffer &recv_buff_,
                  const UInt32 SERVER_MAX_BUFF,
-                 char *scratch_);
+                 char *scratch_,
+                 SInt32 process_num = -1);
    ~SyscallServer();
 
    void handleSyscall(core_id_t core_id);
 
+   // Files opened by a per-process server (syscall_server/per_process) get
+   // fds from PROCESS_FD_BASE on that encode the process that owns them,
+   // so any process can route a call on an fd without a shared fd table
+   static const int PROCESS_FD_BASE = 1 << 16;
+
+   static bool isPerProcessEnabled();
+   static bool isProcessFd(int fd) { return (fd >= PROCESS_FD_BASE); }
+   static UInt32 getFdProcess(int fd);
+   static int getHostFd(int fd);
+   static int getProcessFd(int host_fd, UInt32 process_num);
+   // Remaining chunks of a write/writev payload
+   void handleSyscallData(core_id_t core_id);
+
 private:
    void marshallOpenCall(core_id_t core_id);
    void marshallReadCall(core_id_t core_id);
@@ -90,6 +107,15 @@ private:
    UnstructuredBuffer & m_recv_buff;
    const UInt32 m_SYSCALL_SERVER_MAX_BUFF;
    char * const m_scratch;
+   const SInt32 m_process_num;
+
+   // File I/O (read, write, writev, stat, lstat)
+   SyscallIOService m_io_service;
+   // Chunked write payloads still being received, by tile
+   typedef std::map<tile_id_t, SyscallIORequest*> PendingRequestMap;
+   PendingRequestMap m_pending_requests;
+
+   void receivePayload(SyscallIORequest* request);
 
    // Handling Futexes
    typedef std::map<IntPtr, SimFutex> FutexMap;
@@ -270,7 +270,7 @@ SInt32 ThreadManager::spawnThread(tile_id_t dest_tile_id, thread_func_t func, vo
    LOG_PRINT("Thread: %i spawned on core(%d, %d), idx(%i)", dest_thread_id, dest_tile_id, dest_core_id.core_type, dest_thread_index);
 
    // Delete the data buffer
-   delete [] (Byte*) pkt.data;
+   pkt.release();
 
    return dest_thread_id;
 }
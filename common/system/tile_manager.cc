@@ -341,6 +341,20 @@ tile_id_t TileManager::registerSimThread()
     return tile->getId();
 }
 
+void TileManager::registerSimThreadWorker()
+{
+    // The tile is set by setSimThreadWorkerTile() each time the worker serves a tile
+    m_tile_tls->insert(NULL);
+    m_tile_index_tls->insertInt(0);
+    m_thread_type_tls->insertInt(SIM_THREAD);
+}
+
+void TileManager::setSimThreadWorkerTile(UInt32 tile_index)
+{
+    m_tile_tls->set(m_tiles.at(tile_index));
+    m_tile_index_tls->setInt(tile_index);
+}
+
 bool TileManager::amiSimThread()
 {
     return m_thread_type_tls ? (m_thread_type_tls->getInt() == SIM_THREAD) : false;
@@ -24,6 +24,8 @@ public:
    void initializeThread(core_id_t core_id, thread_id_t thread_index = 0, thread_id_t thread_id = 0);
    void terminateThread();
    tile_id_t registerSimThread();
+   void registerSimThreadWorker();
+   void setSimThreadWorkerTile(UInt32 tile_index);
 
    core_id_t getCurrentCoreID(); // id of currently active core (or INVALID_CORE_ID)
    tile_id_t getCurrentTileID(); // id of currently active core (or INVALID_TILE_ID)
@@ -6,6 +6,7 @@
 #include "simulator.h"
 #include "config.h"
 #include "transport.h"
+#include "packet_buffer_pool.h"
 #include "tile.h"
 #include "tile_manager.h"
 
@@ -41,11 +42,11 @@ static void gatherSummaries(vector<string> &summaries)
 
          buf = global_node->recv();
          assert(*((tile_id_t*)buf) == tl[t]);
-         delete [] buf;
+         PacketBufferPool::release(buf);
 
          buf = global_node->recv();
          summaries[tl[t]] = string((char*)buf);
-         delete [] buf;
+         PacketBufferPool::release(buf);
       }
    }
 
@@ -233,7 +234,7 @@ void TileManager::outputSummary(ostream &os)
    {
       Byte *buf = global_node->recv();
       assert(*((UInt32*)buf) == cfg->getCurrentProcessNum());
-      delete [] buf;
+      PacketBufferPool::release(buf);
    }
 
    // send each summary
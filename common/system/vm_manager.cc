@@ -108,3 +108,32 @@ int VMManager::munmap(void *start, size_t length)
    LOG_PRINT("VMManager: munmap() returned 0");
    return 0;
 }
+
+void VMManager::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_VM_MANAGER);
+   checkpoint << m_start_data_segment << m_end_data_segment
+              << m_start_stack_segment << m_end_stack_segment
+              << m_start_dynamic_segment << m_end_dynamic_segment;
+}
+
+void VMManager::restoreState(CheckpointReader& checkpoint)
+{
+   // The segments describe the live application's memory, so they are only
+   // compared with the checkpoint
+   checkpoint.checkSection(CHECKPOINT_VM_MANAGER);
+   IntPtr start_data_segment, end_data_segment;
+   IntPtr start_stack_segment, end_stack_segment;
+   IntPtr start_dynamic_segment, end_dynamic_segment;
+   checkpoint >> start_data_segment >> end_data_segment
+              >> start_stack_segment >> end_stack_segment
+              >> start_dynamic_segment >> end_dynamic_segment;
+
+   if ((start_data_segment != m_start_data_segment) || (end_data_segment != m_end_data_segment) ||
+       (start_stack_segment != m_start_stack_segment) || (end_stack_segment != m_end_stack_segment) ||
+       (start_dynamic_segment != m_start_dynamic_segment) || (end_dynamic_segment != m_end_dynamic_segment))
+   {
+      LOG_PRINT_WARNING("VM layout differs from the checkpoint (data segment end %#lx vs %#lx, dynamic segment start %#lx vs %#lx), keeping the live one",
+                        m_end_data_segment, end_data_segment, m_start_dynamic_segment, start_dynamic_segment);
+   }
+}
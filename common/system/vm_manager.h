@@ -5,6 +5,7 @@
 #include <sys/mman.h>
 
 #include "fixed_types.h"
+#include "checkpoint_stream.h"
 
 class VMManager
 {
@@ -17,6 +18,9 @@ class VMManager
       void *mmap2(void *start, size_t length, int prot, int flags, int fd, off_t offset);
       int munmap(void *start, size_t length);
 
+      void saveState(CheckpointWriter& checkpoint);
+      void restoreState(CheckpointReader& checkpoint);
+
    private:
       IntPtr m_start_data_segment;
       IntPtr m_end_data_segment;
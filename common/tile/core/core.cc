@@ -91,7 +91,7 @@ Core::coreRecvW(int sender, int receiver, char* buffer, int size, carbon_network
 
    // De-allocate dynamic memory
    // Is this the best place to de-allocate packet.data ??
-   delete [] (Byte*) packet.data;
+   packet.release();
 
    return (unsigned)size == packet.length ? 0 : -1;
 }
@@ -198,7 +198,7 @@ Core::initiateMemoryAccess(MemComponent::Type mem_component, lock_signal_t lock_
             // Instruction buffer hit, so NO need to access ICACHE
             _instruction_buffer_hits ++;
             // 1 cycle to access instruction buffer
-            curr_time += Latency(1, _tile->getFrequency());
+            curr_time += Latency(1, _tile->getFrequencyDomain());
             continue;
          }
          else
@@ -296,6 +296,14 @@ Core::outputSummary(ostream& os)
       << endl;
 }
 
+void
+Core::setState(State state)
+{
+   _state = state;
+   if (_clock_skew_management_client)
+      _clock_skew_management_client->onCoreStateChange();
+}
+
 void
 Core::enableModels()
 {
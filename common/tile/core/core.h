@@ -73,7 +73,7 @@ public:
    PinMemoryManager *getPinMemoryManager()   { return _pin_memory_manager; }
 
    State getState()                          { return _state; }
-   void setState(State state)                { _state = state; }
+   void setState(State state);
   
    void outputSummary(ostream& os);
 
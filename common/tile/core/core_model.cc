@@ -4,6 +4,7 @@
 #include "simple_core_model.h"
 #include "iocoom_core_model.h"
 #include "branch_predictor.h"
+#include "sampling_controller.h"
 #include "simulator.h"
 #include "tile_manager.h"
 #include "config.h"
@@ -30,16 +31,23 @@ CoreModel::CoreModel(Core *core)
    : m_core(core)
    , m_curr_time(0)
    , m_instruction_count(0)
+   , m_frequency_domain(core->getTile()->getFrequency())
    , m_average_frequency(0.0)
    , m_total_time(0)
    , m_checkpointed_time(0)
    , m_total_cycles(0)
    , m_enabled(false)
+   , m_instruction_queue(MAX_QUEUED_INSTRUCTIONS)
+   , m_dynamic_info_queue(MAX_QUEUED_DYNAMIC_INFO)
    , m_bp(0)
+   , m_sampling_controller(0)
 {
    // Create Branch Predictor
    m_bp = BranchPredictor::create();
 
+   // Create Sampling Controller (NULL if sampling is disabled)
+   m_sampling_controller = SamplingController::create();
+
    // Initialize Pipeline Stall Counters
    initializePipelineStallCounters();
 
@@ -50,6 +58,7 @@ CoreModel::CoreModel(Core *core)
 
 CoreModel::~CoreModel()
 {
+   delete m_sampling_controller; m_sampling_controller = 0;
    delete m_bp; m_bp = 0;
 }
 
@@ -82,8 +91,12 @@ Time CoreModel::getCost(InstructionType type)
 
 void CoreModel::outputSummary(ostream& os)
 {
+   UInt64 total_instructions = m_instruction_count;
+   if (m_sampling_controller)
+      total_instructions += m_sampling_controller->getFastForwardedInstructions();
+
    os << "Core Summary:" << endl;
-   os << "    Total Instructions: " << m_instruction_count << endl;
+   os << "    Total Instructions: " << total_instructions << endl;
    os << "    Completion Time (in nanoseconds): " << m_curr_time.toNanosec() << endl;
    os << "    Average Frequency (in GHz): " << m_average_frequency << endl;
    
@@ -94,6 +107,10 @@ void CoreModel::outputSummary(ostream& os)
    os << "    Total Synchronization Stall Time (in nanoseconds): " << m_total_sync_instruction_stall_time.toNanosec() << endl;
    os << "    Total Network Recv Stall Time (in nanoseconds): " << m_total_recv_instruction_stall_time.toNanosec() << endl;
 
+   // Sampling Summary
+   if (m_sampling_controller)
+      m_sampling_controller->outputSummary(os, total_instructions);
+
    // Branch Predictor Summary
    if (m_bp)
       m_bp->outputSummary(os);
@@ -113,11 +130,26 @@ void CoreModel::disable()
    m_enabled = false;
 }
 
+void CoreModel::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_CORE_MODEL);
+   checkpoint << m_curr_time;
+}
+
+void CoreModel::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.checkSection(CHECKPOINT_CORE_MODEL);
+   Time curr_time;
+   checkpoint >> curr_time;
+   setCurrTime(curr_time);
+}
+
 // This function is called:
 // 1) Whenever frequency is changed
 void CoreModel::updateInternalVariablesOnFrequencyChange(float old_frequency, float new_frequency)
 {
    recomputeAverageFrequency(old_frequency);
+   m_frequency_domain.setFrequency(new_frequency);
    updateCoreStaticInstructionModel(new_frequency);
 }
 
@@ -191,37 +223,117 @@ void CoreModel::queueInstruction(Instruction* instruction)
 {
    if (!m_enabled)
       return;
+   if (!updateSamplingPhase(1))
+   {
+      fastForwardInstruction(instruction);
+      return;
+   }
+   LOG_ASSERT_ERROR(!m_instruction_queue.full(), "Instruction queue is growing too big.");
    m_instruction_queue.push(instruction);
 }
 
+void CoreModel::queueBasicBlock(BasicBlock* basic_block)
+{
+   if (!m_enabled)
+      return;
+   if (!updateSamplingPhase(basic_block->size()))
+   {
+      for (BasicBlock::iterator it = basic_block->begin(); it != basic_block->end(); it++)
+         fastForwardInstruction(*it);
+      return;
+   }
+   LOG_ASSERT_ERROR(m_instruction_queue.size() + basic_block->size() <= m_instruction_queue.capacity(),
+                    "Instruction queue is growing too big.");
+   for (BasicBlock::iterator it = basic_block->begin(); it != basic_block->end(); it++)
+      m_instruction_queue.push(*it);
+}
+
 void CoreModel::iterate()
 {
-   // Because we will sometimes not have info available (we will throw
-   // a DynamicInstructionInfoNotAvailable)
+   // An instruction is modeled only once all its dynamic info has been
+   // pushed. Info arrives in program order, so the front instruction is
+   // ready as soon as there are enough entries in the info queue.
 
    while (m_instruction_queue.size() > 1)
    {
-      LOG_PRINT("Instruction Queue Size(%lu)", m_instruction_queue.size());
+      LOG_PRINT("Instruction Queue Size(%u)", m_instruction_queue.size());
       Instruction* instruction = m_instruction_queue.front();
 
-      try
-      {
-         handleInstruction(instruction);
-         m_instruction_queue.pop();
-      }
-      catch (DynamicInstructionInfoNotAvailableException)
+      if (instruction->getNumDynamicInfo() > m_dynamic_info_queue.size())
       {
-         LOG_PRINT("Throwing DynamicInstructionInfoNotAvailable!");
+         LOG_PRINT("Dynamic info not available yet");
          return;
       }
+
+      handleInstruction(instruction);
+      m_instruction_queue.pop();
+   }
+}
+
+bool CoreModel::updateSamplingPhase(UInt32 num_instructions)
+{
+   if (!m_sampling_controller)
+      return true;
+
+   SamplingController::Phase old_phase = m_sampling_controller->getPhase();
+   SamplingController::Phase new_phase = m_sampling_controller->advance(num_instructions);
+   if (new_phase != old_phase)
+   {
+      // Phases change between instructions, so that the measurement windows
+      // start and end on fully modeled instructions
+      drainInstructionQueue();
+
+      if (old_phase == SamplingController::DETAILED_MEASUREMENT)
+         m_sampling_controller->endMeasurement(m_instruction_count, m_curr_time, m_frequency_domain);
+      if (new_phase == SamplingController::DETAILED_MEASUREMENT)
+         m_sampling_controller->startMeasurement(m_instruction_count, m_curr_time);
    }
+
+   return (new_phase != SamplingController::FAST_FORWARD);
+}
+
+void CoreModel::fastForwardInstruction(Instruction* instruction)
+{
+   // Only functional warmup: the instruction fetch keeps the L1-I cache
+   // warm (data accesses are simulated anyway) and the core time advances
+   // by the measured average time per instruction
+   m_core->readInstructionMemory(instruction->getAddress(), instruction->getSize());
+   m_curr_time += m_sampling_controller->getFastForwardTime(1, m_frequency_domain);
+}
+
+void CoreModel::drainInstructionQueue()
+{
+   // Called between two instructions, when every queued instruction has
+   // finished executing and pushed all its dynamic info
+   while (!m_instruction_queue.empty())
+   {
+      Instruction* instruction = m_instruction_queue.front();
+      if (instruction->getNumDynamicInfo() > m_dynamic_info_queue.size())
+         break;
+
+      handleInstruction(instruction);
+      m_instruction_queue.pop();
+   }
+
+   LOG_ASSERT_WARNING(m_instruction_queue.empty() && m_dynamic_info_queue.empty(),
+                      "Discarding %u queued instructions and %u dynamic info entries",
+                      m_instruction_queue.size(), m_dynamic_info_queue.size());
+   while (!m_instruction_queue.empty())
+      m_instruction_queue.pop();
+   while (!m_dynamic_info_queue.empty())
+      m_dynamic_info_queue.pop();
 }
 
 void CoreModel::pushDynamicInstructionInfo(DynamicInstructionInfo &i)
 {
    if (!m_enabled)
       return;
+   // Fast-forwarded instructions are not modeled
+   if (m_sampling_controller && m_sampling_controller->getPhase() == SamplingController::FAST_FORWARD)
+      return;
 
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.full(),
+                    "Dynamic info queue is growing too big.");
    m_dynamic_info_queue.push(i);
 }
 
@@ -230,29 +342,18 @@ void CoreModel::popDynamicInstructionInfo()
    if (!m_enabled)
       return;
 
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() > 0,
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(),
                     "Expected some dynamic info to be available.");
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() < 5000,
-                    "Dynamic info queue is growing too big.");
    LOG_PRINT("Pop Info(%u)", m_dynamic_info_queue.front().type);
    m_dynamic_info_queue.pop();
 }
 
 DynamicInstructionInfo& CoreModel::getDynamicInstructionInfo()
 {
-   // Information is needed to model the instruction, but isn't
-   // available. This is handled in iterate() by returning early and
-   // continuing from that instruction later.
-
-   // FIXME: Note this assumes that either none of the info for an
-   // instruction is available or all of it! This works for
-   // performance modeling in the same thread as functional modeling.
-
-   if (m_dynamic_info_queue.empty())
-      throw DynamicInstructionInfoNotAvailableException();
-
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() < 5000,
-                    "Dynamic info queue is growing too big.");
+   // iterate() only models an instruction once all of its info is
+   // available, so running out here is an error
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(),
+                    "Expected some dynamic info to be available.");
 
    LOG_PRINT("Get Info(%u)", m_dynamic_info_queue.front().type);
    return m_dynamic_info_queue.front();
@@ -9,12 +9,15 @@
 // Forward Decls
 class Core;
 class BranchPredictor;
+class SamplingController;
 
 #include "instruction.h"
 #include "basic_block.h"
 #include "fixed_types.h"
 #include "dynamic_instruction_info.h"
 #include "time_types.h"
+#include "ring_buffer.h"
+#include "checkpoint_stream.h"
 
 class CoreModel
 {
@@ -24,6 +27,7 @@ public:
 
    void processDynamicInstruction(DynamicInstruction* i);
    void queueInstruction(Instruction* instruction);
+   void queueBasicBlock(BasicBlock* basic_block);
    void iterate();
 
    virtual void updateInternalVariablesOnFrequencyChange(float old_frequency, float new_frequency);
@@ -39,17 +43,24 @@ public:
    static CoreModel* create(Core* core);
 
    BranchPredictor *getBranchPredictor() { return m_bp; }
+   SamplingController *getSamplingController() { return m_sampling_controller; }
 
    void enable();
    void disable();
    bool isEnabled() { return m_enabled; }
 
+   // Only the core clock is checkpointed
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
    virtual void outputSummary(std::ostream &os) = 0;
 
    class AbortInstructionException { };
 
    Time getCost(InstructionType type);
 
+   const FrequencyDomain& getFrequencyDomain() const { return m_frequency_domain; }
+
    Core* getCore(){return m_core;};
 
 protected:
@@ -69,13 +80,13 @@ protected:
 
    friend class SpawnInstruction;
 
-   typedef std::queue<DynamicInstructionInfo> DynamicInstructionInfoQueue;
-   typedef std::queue<Instruction*> InstructionQueue;
-
    Core* m_core;
 
    Time m_curr_time;
    UInt64 m_instruction_count;
+
+   // Clock of the core; re-derived in updateInternalVariablesOnFrequencyChange()
+   FrequencyDomain m_frequency_domain;
    
    void updatePipelineStallCounters(Instruction* i, Time memory_stall_time, Time execution_unit_stall_time);
 
@@ -83,10 +94,18 @@ protected:
 
 private:
 
-   class DynamicInstructionInfoNotAvailableException { };
+   // Capacities of the instruction and dynamic info rings
+   static const UInt32 MAX_QUEUED_INSTRUCTIONS = 4096;
+   static const UInt32 MAX_QUEUED_DYNAMIC_INFO = 8192;
 
    virtual void handleInstruction(Instruction *instruction) = 0;
 
+   // Sampling: returns true if the next 'num_instructions' executed
+   // instructions are to be modeled in detail
+   bool updateSamplingPhase(UInt32 num_instructions);
+   void fastForwardInstruction(Instruction *instruction);
+   void drainInstructionQueue();
+
    // Pipeline Stall Counters
    void initializePipelineStallCounters();
 
@@ -97,10 +116,11 @@ private:
 
    bool m_enabled;
 
-   InstructionQueue m_instruction_queue;
-   DynamicInstructionInfoQueue m_dynamic_info_queue;
+   RingBuffer<Instruction*> m_instruction_queue;
+   RingBuffer<DynamicInstructionInfo> m_dynamic_info_queue;
 
    BranchPredictor *m_bp;
+   SamplingController *m_sampling_controller;
 
    // Instruction costs
    typedef std::vector<Time> CoreStaticInstructionCosts;
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "instruction.h"
 #include "simulator.h"
 #include "tile_manager.h"
@@ -16,8 +18,15 @@ Instruction::Instruction(InstructionType type, UInt64 opcode, OperandList &opera
    , m_dynamic(false)
    , m_address(0)
    , m_size(0)
+   , m_num_dynamic_info(0)
    , m_operands(operands)
 {
+   initializeDescriptor();
+
+   // One info per memory operand and one for the outcome of a branch
+   m_num_dynamic_info = m_descriptor.num_memory_operands;
+   if (m_type == INST_BRANCH)
+      m_num_dynamic_info ++;
 }
 
 Instruction::Instruction(InstructionType type, bool dynamic)
@@ -26,6 +35,7 @@ Instruction::Instruction(InstructionType type, bool dynamic)
    , m_dynamic(dynamic)
    , m_address(0)
    , m_size(0)
+   , m_num_dynamic_info(0)
 {
 }
 
@@ -35,30 +45,54 @@ Time Instruction::getCost(CoreModel* perf)
    return perf->getCost(m_type); 
 }
 
-bool Instruction::isSimpleMemoryLoad() const
+void Instruction::initializeDescriptor()
 {
-   if (m_operands.size() > 2)
-      return false;
-
+   vector<UInt16> read_registers;
+   vector<UInt16> write_registers;
    bool memory_read = false;
    bool reg_write = false;
+
    for (unsigned int i = 0; i < m_operands.size(); i++)
    {
       const Operand& o = m_operands[i];
-      if ((o.m_type == Operand::MEMORY) && (o.m_direction == Operand::READ))
-         memory_read = true;
-      if ((o.m_type == Operand::REG) && (o.m_direction == Operand::WRITE))
-         reg_write = true;
+      if (o.m_type == Operand::REG)
+      {
+         LOG_ASSERT_ERROR(o.m_value < (1 << 16), "Register id(%llu) out of range", o.m_value);
+         vector<UInt16>& list = (o.m_direction == Operand::READ) ? read_registers : write_registers;
+         if (find(list.begin(), list.end(), (UInt16) o.m_value) == list.end())
+            list.push_back((UInt16) o.m_value);
+         if (o.m_direction == Operand::WRITE)
+            reg_write = true;
+      }
+      else if (o.m_type == Operand::MEMORY)
+      {
+         LOG_ASSERT_ERROR(m_descriptor.num_memory_operands < InstructionDescriptor::MAX_MEMORY_OPERANDS,
+                          "Too many memory operands(%u)", m_descriptor.num_memory_operands + 1);
+         if (o.m_direction == Operand::WRITE)
+            m_descriptor.memory_write_mask |= (1 << m_descriptor.num_memory_operands);
+         else
+            memory_read = true;
+         m_descriptor.num_memory_operands ++;
+      }
    }
 
+   m_descriptor.num_read_registers = read_registers.size();
+   m_descriptor.num_write_registers = write_registers.size();
+   m_descriptor.registers = read_registers;
+   m_descriptor.registers.insert(m_descriptor.registers.end(), write_registers.begin(), write_registers.end());
+
+   // A load whose only other operand is its destination register
    switch (m_operands.size())
    {
    case 1:
-      return (memory_read);
+      m_descriptor.is_simple_memory_load = memory_read;
+      break;
    case 2:
-      return (memory_read && reg_write);
+      m_descriptor.is_simple_memory_load = (memory_read && reg_write);
+      break;
    default:
-      return false;
+      m_descriptor.is_simple_memory_load = false;
+      break;
    }
 }
 
@@ -82,7 +116,7 @@ BranchInstruction::BranchInstruction(UInt64 opcode, OperandList &l)
 
 Time BranchInstruction::getCost(CoreModel* perf)
 {
-   float frequency = perf->getCore()->getTile()->getFrequency();
+   const FrequencyDomain& frequency_domain = perf->getFrequencyDomain();
    BranchPredictor *bp = perf->getBranchPredictor();
 
    DynamicInstructionInfo &i = perf->getDynamicInstructionInfo();
@@ -92,14 +126,14 @@ Time BranchInstruction::getCost(CoreModel* perf)
    if (bp == NULL)
    {
       perf->popDynamicInstructionInfo();
-      return Time(Latency(1,frequency));
+      return Time(Latency(1,frequency_domain));
    }
 
    bool prediction = bp->predict(getAddress(), i.branch_info.target);
    bool correct = (prediction == i.branch_info.taken);
 
    bp->update(prediction, i.branch_info.taken, getAddress(), i.branch_info.target);
-   Latency cost = correct ? Latency(1,frequency) : Latency(bp->getMispredictPenalty(),frequency);
+   Latency cost = correct ? Latency(1,frequency_domain) : Latency(bp->getMispredictPenalty(),frequency_domain);
       
    perf->popDynamicInstructionInfo();
    return Time(cost);
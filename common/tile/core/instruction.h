@@ -65,6 +65,39 @@ public:
 
 typedef std::vector<Operand> OperandList;
 
+// Operands of a static instruction in the form the core models consume
+// them, extracted once when the instruction is created instead of on every
+// execution
+struct InstructionDescriptor
+{
+   static const UInt32 MAX_MEMORY_OPERANDS = 8;
+
+   InstructionDescriptor()
+      : num_read_registers(0), num_write_registers(0)
+      , num_memory_operands(0), memory_write_mask(0)
+      , is_simple_memory_load(false) {}
+
+   // Distinct register ids, the read registers followed by the write registers
+   std::vector<UInt16> registers;
+   UInt16 num_read_registers;
+   UInt16 num_write_registers;
+
+   // Memory operands in operand order; bit i is set if the i-th one is a write
+   UInt8 num_memory_operands;
+   UInt8 memory_write_mask;
+
+   bool is_simple_memory_load;
+
+   const UInt16* getReadRegisters() const
+   { return registers.empty() ? NULL : &registers[0]; }
+   const UInt16* getWriteRegisters() const
+   { return registers.empty() ? NULL : &registers[num_read_registers]; }
+   bool isMemoryWrite(UInt32 index) const
+   { return (memory_write_mask >> index) & 1; }
+   bool hasMemoryWrite() const
+   { return memory_write_mask != 0; }
+};
+
 class Instruction
 {
 public:
@@ -92,13 +125,19 @@ public:
    { return m_size; }
    const OperandList& getOperands() const
    { return m_operands; }
+   const InstructionDescriptor& getDescriptor() const
+   { return m_descriptor; }
+   // Number of DynamicInstructionInfo entries consumed when modeling this instruction
+   UInt32 getNumDynamicInfo() const
+   { return m_num_dynamic_info; }
 
    void setAddress(IntPtr address)
    { m_address = address; }
    void setSize(UInt32 size)
    { m_size = size; }
 
-   bool isSimpleMemoryLoad() const;
+   bool isSimpleMemoryLoad() const
+   { return m_descriptor.is_simple_memory_load; }
 
    void print() const;
 
@@ -116,6 +155,10 @@ private:
 
    IntPtr m_address;
    UInt32 m_size;
+   UInt32 m_num_dynamic_info;
+   InstructionDescriptor m_descriptor;
+
+   void initializeDescriptor();
 
 protected:
    OperandList m_operands;
@@ -80,7 +80,7 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    // abort further processing (via AbortInstructionException)
    Time cost = instruction->getCost(this);
 
-   Time one_cycle = Latency(1, m_core->getTile()->getFrequency());
+   Time one_cycle = Latency(1, getFrequencyDomain());
 
    // Model Instruction Fetch Stage
    Time instruction_ready = m_curr_time;
@@ -93,43 +93,42 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    // - find when read operations are available
    // - find latency of instruction
    // - update write operands
-   const OperandList &ops = instruction->getOperands();
+   const InstructionDescriptor &descriptor = instruction->getDescriptor();
 
    // buffer write operands to be updated after instruction executes
-   DynamicInstructionInfoQueue write_info;
+   DynamicInstructionInfo write_info[InstructionDescriptor::MAX_MEMORY_OPERANDS];
+   UInt32 num_write_info = 0;
 
    // Time when register operands are ready (waiting for either the load unit or the execution unit)
    Time read_register_operands_ready_load_unit_wait = instruction_ready;
    Time read_register_operands_ready_execution_unit_wait = instruction_ready;
 
    // REG read operands
-   for (unsigned int i = 0; i < ops.size(); i++)
+   const UInt16* read_registers = descriptor.getReadRegisters();
+   for (unsigned int i = 0; i < descriptor.num_read_registers; i++)
    {
-      const Operand &o = ops[i];
+      UInt16 reg = read_registers[i];
 
-      if ( (o.m_direction != Operand::READ) || (o.m_type != Operand::REG) )
-         continue;
-
-      LOG_ASSERT_ERROR(o.m_value < m_register_scoreboard.size(),
-                       "Register value out of range: %llu", o.m_value);
+      LOG_ASSERT_ERROR(reg < m_register_scoreboard.size(),
+                       "Register value out of range: %u", reg);
 
       // Compute the ready time for registers that are waiting on the LOAD_UNIT
       // and on the EXECUTION_UNIT
       // The final ready time is the max of this
-      if (m_register_wait_unit_list[o.m_value] == LOAD_UNIT)
+      if (m_register_wait_unit_list[reg] == LOAD_UNIT)
       {
-         if (read_register_operands_ready_load_unit_wait < m_register_scoreboard[o.m_value])
-            read_register_operands_ready_load_unit_wait = m_register_scoreboard[o.m_value];
+         if (read_register_operands_ready_load_unit_wait < m_register_scoreboard[reg])
+            read_register_operands_ready_load_unit_wait = m_register_scoreboard[reg];
       }
-      else if (m_register_wait_unit_list[o.m_value] == EXECUTION_UNIT)
+      else if (m_register_wait_unit_list[reg] == EXECUTION_UNIT)
       {
-         if (read_register_operands_ready_execution_unit_wait < m_register_scoreboard[o.m_value])
-            read_register_operands_ready_execution_unit_wait = m_register_scoreboard[o.m_value];
+         if (read_register_operands_ready_execution_unit_wait < m_register_scoreboard[reg])
+            read_register_operands_ready_execution_unit_wait = m_register_scoreboard[reg];
       }
       else
       {
-         LOG_ASSERT_ERROR(m_register_scoreboard[o.m_value] <= instruction_ready,
-                          "Unrecognized Core Unit(%u)", m_register_wait_unit_list[o.m_value]);
+         LOG_ASSERT_ERROR(m_register_scoreboard[reg] <= instruction_ready,
+                          "Unrecognized Core Unit(%u)", m_register_wait_unit_list[reg]);
       }
    }
    
@@ -143,16 +142,11 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    Time load_buffer_ready = read_register_operands_ready;
    Time read_memory_operands_ready = read_register_operands_ready;
    // MEMORY read & write operands
-   for (unsigned int i = 0; i < ops.size(); i++)
+   for (unsigned int i = 0; i < descriptor.num_memory_operands; i++)
    {
-      const Operand &o = ops[i];
-
-      if (o.m_type != Operand::MEMORY)
-         continue;
-         
       DynamicInstructionInfo &info = getDynamicInstructionInfo();
 
-      if (o.m_direction == Operand::READ)
+      if (!descriptor.isMemoryWrite(i))
       {
          LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_READ,
                           "Expected memory read info, got: %d.", info.type);
@@ -175,7 +169,7 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
          LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_WRITE,
                           "Expected memory write info, got: %d.", info.type);
 
-         write_info.push(info);
+         write_info[num_write_info++] = info;
       }
       
       popDynamicInstructionInfo();
@@ -198,49 +192,33 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    // for all the read operands of an instruction to be available before
    // we issue it
    // Assume that the register file can be written in one cycle
-   for (unsigned int i = 0; i < ops.size(); i++)
+   const UInt16* write_registers = descriptor.getWriteRegisters();
+   CoreUnit write_unit = descriptor.is_simple_memory_load ? LOAD_UNIT : EXECUTION_UNIT;
+   for (unsigned int i = 0; i < descriptor.num_write_registers; i++)
    {
-      const Operand &o = ops[i];
-
-      // REG write operands
-      if ( (o.m_direction != Operand::WRITE) || (o.m_type != Operand::REG) )
-         continue;
+      UInt16 reg = write_registers[i];
 
       // The only case where this assertion is not true is when the register is written
       // into but is never read before the next write operation. We assume
       // that this never happend
       // LOG_ASSERT_ERROR(write_operands_ready > m_register_scoreboard[o.m_value],
       //       "Write Operands Ready(%llu), Register Scoreboard Value(%llu)",
-      //       write_operands_ready, m_register_scoreboard[o.m_value]);
-      m_register_scoreboard[o.m_value] = write_operands_ready;
+      //       write_operands_ready, m_register_scoreboard[reg]);
+      m_register_scoreboard[reg] = write_operands_ready;
 
       // Update the unit that the register is waiting for
-      if (instruction->isSimpleMemoryLoad())
-         m_register_wait_unit_list[o.m_value] = LOAD_UNIT;
-      else
-         m_register_wait_unit_list[o.m_value] = EXECUTION_UNIT;
+      m_register_wait_unit_list[reg] = write_unit;
    }
 
    Time store_buffer_ready = write_operands_ready;
-   bool has_memory_write_operand = false;
+   bool has_memory_write_operand = descriptor.hasMemoryWrite();
    // MEMORY write operands
    // This is done before doing register
    // operands to make sure the scoreboard is updated correctly
-   for (unsigned int i = 0; i < ops.size(); i++)
+   for (unsigned int i = 0; i < num_write_info; i++)
    {
-      const Operand &o = ops[i];
-
-      // MEMORY write operands
-      if ( (o.m_direction != Operand::WRITE) || (o.m_type != Operand::MEMORY) )
-         continue;
-
-      // Instruction has a MEMORY WRITE operand
-      has_memory_write_operand = true;
-
-      const DynamicInstructionInfo &info = write_info.front();
       // This just updates the contents of the store buffer
-      Time store_time = executeStore(write_operands_ready, info);
-      write_info.pop();
+      Time store_time = executeStore(write_operands_ready, write_info[i]);
 
       if (store_buffer_ready < store_time)
          store_buffer_ready = store_time;
@@ -280,7 +258,7 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
       
       m_curr_time = load_buffer_ready + one_cycle;
 
-      if (!instruction->isSimpleMemoryLoad())
+      if (!descriptor.is_simple_memory_load)
       {
          // Memory Read Operands - Wait for L1-D Cache
          memory_stall_time += (read_memory_operands_ready - load_buffer_ready);
@@ -303,8 +281,6 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
       }
    }
 
-   LOG_ASSERT_ERROR(write_info.empty(), "Some write info left over?");
-
    // Update Statistics
    m_instruction_count++;
 
@@ -312,7 +288,7 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    updatePipelineStallCounters(instruction, memory_stall_time, execution_unit_stall_time);
 
    // Update Event Counters
-   m_mcpat_core_interface->updateEventCounters(instruction, m_curr_time.toCycles(m_core->getTile()->getFrequency()));
+   m_mcpat_core_interface->updateEventCounters(instruction, m_curr_time.toCycles(getFrequencyDomain()));
 }
 
 pair<Time,Time>
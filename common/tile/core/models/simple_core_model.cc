@@ -48,38 +48,33 @@ void SimpleCoreModel::handleInstruction(Instruction *instruction)
    memory_stall_time += instruction_memory_access_time;
    m_total_l1icache_stall_time += instruction_memory_access_time;
 
-   const OperandList &ops = instruction->getOperands();
-   for (unsigned int i = 0; i < ops.size(); i++)
+   const InstructionDescriptor &descriptor = instruction->getDescriptor();
+   for (unsigned int i = 0; i < descriptor.num_memory_operands; i++)
    {
-      const Operand &o = ops[i];
+      DynamicInstructionInfo &info = getDynamicInstructionInfo();
 
-      if (o.m_type == Operand::MEMORY)
+      if (!descriptor.isMemoryWrite(i))
       {
-         DynamicInstructionInfo &info = getDynamicInstructionInfo();
-
-         if (o.m_direction == Operand::READ)
-         {
-            LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_READ,
-                             "Expected memory read info, got: %d.", info.type);
-
-            Time access_time(info.memory_info.latency);
-            memory_stall_time += access_time;
-            m_total_l1dcache_read_stall_time += access_time;
-            // ignore address
-         }
-         else
-         {
-            LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_WRITE,
-                             "Expected memory write info, got: %d.", info.type);
-
-            Time access_time(info.memory_info.latency);
-            memory_stall_time += access_time;
-            m_total_l1dcache_write_stall_time += access_time;
-            // ignore address
-         }
-
-         popDynamicInstructionInfo();
+         LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_READ,
+                          "Expected memory read info, got: %d.", info.type);
+
+         Time access_time(info.memory_info.latency);
+         memory_stall_time += access_time;
+         m_total_l1dcache_read_stall_time += access_time;
+         // ignore address
       }
+      else
+      {
+         LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_WRITE,
+                          "Expected memory write info, got: %d.", info.type);
+
+         Time access_time(info.memory_info.latency);
+         memory_stall_time += access_time;
+         m_total_l1dcache_write_stall_time += access_time;
+         // ignore address
+      }
+
+      popDynamicInstructionInfo();
    }
 
    if (instruction->isDynamic())
@@ -0,0 +1,130 @@
+#include <cmath>
+
+#include "simulator.h"
+#include "config.h"
+#include "sampling_controller.h"
+#include "log.h"
+
+using std::endl;
+
+const double SamplingController::CONFIDENCE_Z = 1.96;
+
+SamplingController::SamplingController(UInt64 detailed_warmup_interval, UInt64 detailed_interval, UInt64 fast_forward_interval)
+   : m_phase(DETAILED_WARMUP)
+   , m_instructions_left_in_phase(detailed_warmup_interval)
+   , m_fast_forwarded_instructions(0)
+   , m_window_start_instruction_count(0)
+   , m_window_start_time(0)
+   , m_measured_instructions(0)
+   , m_measured_time(0)
+   , m_num_samples(0)
+   , m_cpi_sum(0.0)
+   , m_cpi_sum_of_squares(0.0)
+{
+   m_phase_intervals[DETAILED_WARMUP] = detailed_warmup_interval;
+   m_phase_intervals[DETAILED_MEASUREMENT] = detailed_interval;
+   m_phase_intervals[FAST_FORWARD] = fast_forward_interval;
+}
+
+SamplingController::~SamplingController()
+{}
+
+SamplingController* SamplingController::create()
+{
+   UInt64 detailed_warmup_interval = 0;
+   UInt64 detailed_interval = 0;
+   UInt64 fast_forward_interval = 0;
+   try
+   {
+      if (!Sim()->getCfg()->getBool("core/sampling/enabled", false))
+         return NULL;
+
+      detailed_warmup_interval = Sim()->getCfg()->getInt("core/sampling/detailed_warmup_interval");
+      detailed_interval = Sim()->getCfg()->getInt("core/sampling/detailed_interval");
+      fast_forward_interval = Sim()->getCfg()->getInt("core/sampling/fast_forward_interval");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read core/sampling parameters from the cfg file");
+   }
+
+   LOG_ASSERT_ERROR(detailed_interval > 0 && fast_forward_interval > 0,
+                    "core/sampling/detailed_interval(%llu) and core/sampling/fast_forward_interval(%llu) must be non-zero",
+                    detailed_interval, fast_forward_interval);
+
+   return new SamplingController(detailed_warmup_interval, detailed_interval, fast_forward_interval);
+}
+
+SamplingController::Phase SamplingController::advance(UInt32 num_instructions)
+{
+   // A phase ends only between two calls, so with basic block granularity
+   // a phase can overshoot its interval by up to one basic block
+   while (m_instructions_left_in_phase == 0)
+   {
+      m_phase = (Phase) ((m_phase + 1) % NUM_PHASES);
+      m_instructions_left_in_phase = m_phase_intervals[m_phase];
+   }
+
+   m_instructions_left_in_phase -= std::min<UInt64>(m_instructions_left_in_phase, num_instructions);
+   if (m_phase == FAST_FORWARD)
+      m_fast_forwarded_instructions += num_instructions;
+
+   return m_phase;
+}
+
+void SamplingController::startMeasurement(UInt64 instruction_count, Time curr_time)
+{
+   m_window_start_instruction_count = instruction_count;
+   m_window_start_time = curr_time;
+}
+
+void SamplingController::endMeasurement(UInt64 instruction_count, Time curr_time, const FrequencyDomain& frequency_domain)
+{
+   UInt64 window_instructions = instruction_count - m_window_start_instruction_count;
+   if (window_instructions == 0)
+      return;
+
+   Time window_time = curr_time - m_window_start_time;
+   double cpi = ((double) frequency_domain.toCycles(window_time.getTime())) / window_instructions;
+
+   m_measured_instructions += window_instructions;
+   m_measured_time += window_time;
+   m_num_samples ++;
+   m_cpi_sum += cpi;
+   m_cpi_sum_of_squares += cpi * cpi;
+}
+
+Time SamplingController::getFastForwardTime(UInt32 num_instructions, const FrequencyDomain& frequency_domain)
+{
+   // Until the first window has been measured, assume one cycle per instruction
+   if (m_measured_instructions == 0)
+      return Time(frequency_domain.toPicosec(num_instructions));
+
+   double time_per_instruction = ((double) m_measured_time.getTime()) / m_measured_instructions;
+   return Time((UInt64) (time_per_instruction * num_instructions + 0.5));
+}
+
+void SamplingController::outputSummary(std::ostream &os, UInt64 total_instructions)
+{
+   os << "  Sampling Summary:" << endl;
+   os << "    Fast-Forwarded Instructions: " << m_fast_forwarded_instructions << endl;
+   os << "    Measured Instructions: " << m_measured_instructions << endl;
+   os << "    Number of Samples: " << m_num_samples << endl;
+
+   if (m_num_samples == 0)
+      return;
+
+   double mean_cpi = m_cpi_sum / m_num_samples;
+   double cpi_error = 0.0;
+   if (m_num_samples > 1)
+   {
+      double variance = (m_cpi_sum_of_squares - m_num_samples * mean_cpi * mean_cpi) / (m_num_samples - 1);
+      cpi_error = CONFIDENCE_Z * sqrt(std::max(variance, 0.0) / m_num_samples);
+   }
+
+   os << "    Mean CPI: " << mean_cpi << endl;
+   os << "    Mean CPI 95% Confidence Interval: +/- " << cpi_error << endl;
+   os << "    Extrapolated Cycles: " << (UInt64) (mean_cpi * total_instructions) << endl;
+   os << "    Extrapolated Cycles 95% Confidence Interval: +/- " << (UInt64) (cpi_error * total_instructions) << endl;
+   os << "    Relative Error (in %): " << (100.0 * cpi_error / mean_cpi) << endl;
+}
@@ -0,0 +1,76 @@
+#ifndef SAMPLING_CONTROLLER_H
+#define SAMPLING_CONTROLLER_H
+
+#include <iostream>
+
+#include "fixed_types.h"
+#include "time_types.h"
+
+// Periodic sampling of a core's instruction stream (SMARTS-style)
+//
+// The instruction stream is split into repeating periods of
+//    [detailed warmup][detailed measurement][fast-forward]
+// Only the detailed phases go through the core timing model. During
+// fast-forward every memory access is still simulated, so caches and
+// directories stay warm, and the core time is advanced by the average time
+// per instruction measured so far. Each measurement window gives one CPI
+// sample; the whole-run cycle count is extrapolated from their mean.
+
+class SamplingController
+{
+public:
+   enum Phase
+   {
+      DETAILED_WARMUP = 0,
+      DETAILED_MEASUREMENT,
+      FAST_FORWARD,
+      NUM_PHASES
+   };
+
+   SamplingController(UInt64 detailed_warmup_interval, UInt64 detailed_interval, UInt64 fast_forward_interval);
+   ~SamplingController();
+
+   // Returns NULL if sampling is disabled
+   static SamplingController* create();
+
+   Phase getPhase() const { return m_phase; }
+
+   // Accounts for the next 'num_instructions' executed instructions and
+   // returns the phase they belong to
+   Phase advance(UInt32 num_instructions);
+
+   // Called at the boundaries of a measurement window with the number of
+   // instructions modeled so far and the current core time
+   void startMeasurement(UInt64 instruction_count, Time curr_time);
+   void endMeasurement(UInt64 instruction_count, Time curr_time, const FrequencyDomain& frequency_domain);
+
+   // Time by which the core advances for 'num_instructions' fast-forwarded instructions
+   Time getFastForwardTime(UInt32 num_instructions, const FrequencyDomain& frequency_domain);
+
+   UInt64 getFastForwardedInstructions() const { return m_fast_forwarded_instructions; }
+
+   void outputSummary(std::ostream &os, UInt64 total_instructions);
+
+private:
+   // Normal quantile of the reported two-sided 95% confidence interval
+   static const double CONFIDENCE_Z;
+
+   UInt64 m_phase_intervals[NUM_PHASES];
+   Phase m_phase;
+   UInt64 m_instructions_left_in_phase;
+
+   UInt64 m_fast_forwarded_instructions;
+
+   // Current measurement window
+   UInt64 m_window_start_instruction_count;
+   Time m_window_start_time;
+
+   // All measurement windows
+   UInt64 m_measured_instructions;
+   Time m_measured_time;
+   UInt64 m_num_samples;
+   double m_cpi_sum;
+   double m_cpi_sum_of_squares;
+};
+
+#endif /* SAMPLING_CONTROLLER_H */
@@ -15,6 +15,8 @@
 #include "tile.h"
 #include "tile_manager.h"
 #include "vm_manager.h"
+#include "syscall_io_service.h"
+#include "syscall_server.h"
 
 #include <errno.h>
 #include <string>
@@ -45,6 +47,10 @@ SyscallMdl::SyscallMdl(Core *core)
    : m_called_enter(false)
    , m_ret_val(0)
    , m_network(core->getTile()->getNetwork())
+   , m_chunk_size(SyscallIOService::getChunkSize())
+   , m_per_process_server(SyscallServer::isPerProcessEnabled())
+   , m_server(INVALID_CORE_ID)
+   , m_pid(0)
 {
 }
 
@@ -123,6 +129,9 @@ IntPtr SyscallMdl::runEnter(IntPtr syscall_number, syscall_args_t &args)
    m_recv_buff.clear();
    m_send_buff.clear();
 
+   // Syscalls are served by the MCP unless routed to a process server
+   m_server = Config::getSingleton()->getMCPCoreId();
+
    int msg_type = MCP_MESSAGE_SYS_CALL;
 
    m_send_buff << msg_type << syscall_number;
@@ -246,6 +255,28 @@ IntPtr SyscallMdl::runEnter(IntPtr syscall_number, syscall_args_t &args)
       m_ret_val = marshallSchedGetAffinityCall(args);
       break;
 
+   // Run natively, so they only know the host fds of this process
+   case SYS_fcntl:
+   case SYS_pread64:
+   case SYS_pwrite64:
+   case SYS_readv:
+   case SYS_dup:
+   case SYS_dup2:
+   case SYS_getdents:
+   case SYS_getdents64:
+   case SYS_fsync:
+   case SYS_fdatasync:
+   case SYS_ftruncate:
+   case SYS_fchdir:
+   case SYS_fstatfs:
+   case SYS_flock:
+      if (rejectProcessFd(syscall_number, (int) args.arg0))
+      {
+         m_called_enter = true;
+         m_ret_val = -EBADF;
+      }
+      break;
+
    case -1:
    default:
       break;
@@ -280,6 +311,8 @@ IntPtr SyscallMdl::marshallOpenCall(syscall_args_t &args)
 
    */
 
+   routeToProcessServer();
+
    char *path = (char *)args.arg0;
    int flags = (int)args.arg1;
    UInt64 mode = (UInt64) args.arg2;
@@ -292,10 +325,10 @@ IntPtr SyscallMdl::marshallOpenCall(syscall_args_t &args)
 
 
    m_send_buff << len_fname << make_pair(path_buf, len_fname) << flags << mode;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
@@ -303,7 +336,7 @@ IntPtr SyscallMdl::marshallOpenCall(syscall_args_t &args)
    m_recv_buff >> status;
 
    delete [] path_buf;
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return status;
 }
@@ -333,17 +366,17 @@ IntPtr SyscallMdl::marshallReadCall(syscall_args_t &args)
 
    */
 
-   int fd = (int)args.arg0;
+   int fd = routeFd((int)args.arg0);
    void *buf = (void *)args.arg1;
    size_t count = (size_t)args.arg2;
    Core *core = Sim()->getTileManager()->getCurrentCore();
 
    // if shared mem, provide the buf to read into
    m_send_buff << fd << count;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    assert(recv_pkt.length >= sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -353,22 +386,15 @@ IntPtr SyscallMdl::marshallReadCall(syscall_args_t &args)
    
    if (bytes != -1)
    {
-      assert(m_recv_buff.size() == bytes);
-
-      // Read data from MCP into a local buffer
-      char* read_buf = new char[bytes];
-      m_recv_buff >> make_pair(read_buf, bytes);
-      
-      // Write the data to memory
-      Core* core = Sim()->getTileManager()->getCurrentCore();
-      core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) buf, read_buf, bytes);
+      // Write the data to memory as it arrives
+      recvPayload((IntPtr) buf, bytes);
    }
    else
    {
       assert(m_recv_buff.size() == 0);
    }
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return bytes;
 }
@@ -396,7 +422,7 @@ IntPtr SyscallMdl::marshallWriteCall(syscall_args_t &args)
 
    */
 
-   int fd = (int)args.arg0;
+   int fd = routeFd((int)args.arg0);
    void *buf = (void *)args.arg1;
    size_t count = (size_t)args.arg2;
 
@@ -407,21 +433,20 @@ IntPtr SyscallMdl::marshallWriteCall(syscall_args_t &args)
    Core *core = Sim()->getTileManager()->getCurrentCore();
    core->accessMemory (Core::NONE, Core::READ, (IntPtr) buf, (char*) write_buf, count);
 
-   m_send_buff << fd << count << make_pair(write_buf, count);
+   m_send_buff << fd << count;
+   sendPayload(write_buf, count);
 
    delete [] write_buf;
 
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
    int status;
    m_recv_buff >> status;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return status;
 }
@@ -446,7 +471,7 @@ IntPtr SyscallMdl::marshallWritevCall(syscall_args_t &args)
    // ------------------|---------
    // BYTES               IntPtr
 
-   int fd = (int) args.arg0;
+   int fd = routeFd((int) args.arg0);
    struct iovec *iov = (struct iovec*) args.arg1;
    int iovcnt = (int) args.arg2;
 
@@ -470,21 +495,20 @@ IntPtr SyscallMdl::marshallWritevCall(syscall_args_t &args)
       head = &buf[running_count];
    }
 
-   m_send_buff << fd << count << make_pair(buf, count);
+   m_send_buff << fd << count;
+   sendPayload(buf, count);
 
    delete [] buf;
 
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
-
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(IntPtr));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
    IntPtr status;
    m_recv_buff >> status;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return status;
 }
@@ -510,50 +534,52 @@ IntPtr SyscallMdl::marshallCloseCall(syscall_args_t &args)
 
    */
 
-   int fd = (int)args.arg0;
+   int fd = routeFd((int)args.arg0);
 
    m_send_buff << fd;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
    int status;
    m_recv_buff >> status;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return status;
 }
 
 IntPtr SyscallMdl::marshallLseekCall(syscall_args_t &args)
 {
-   int fd = (int) args.arg0;
+   int fd = routeFd((int) args.arg0);
    off_t offset = (off_t) args.arg1;
    int whence = (int) args.arg2;
 
    m_send_buff << fd << offset << whence ;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    LOG_ASSERT_ERROR(recv_pkt.length == sizeof(off_t), "Recv Pkt length: expected(%u), got(%u)", sizeof(off_t), recv_pkt.length);
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
    off_t ret_val;
    m_recv_buff >> ret_val;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return ret_val;
 }
 
 IntPtr SyscallMdl::marshallAccessCall(syscall_args_t &args)
 {
+   routeToProcessServer();
+
    char *path = (char *)args.arg0;
    int mode = (int)args.arg1;
 
@@ -567,11 +593,11 @@ IntPtr SyscallMdl::marshallAccessCall(syscall_args_t &args)
    m_send_buff << len_fname << make_pair(path_buf, len_fname) << mode;
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get a result
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -580,7 +606,7 @@ IntPtr SyscallMdl::marshallAccessCall(syscall_args_t &args)
    int result;
    m_recv_buff >> result;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    delete [] path_buf;
 
    return result;
@@ -588,6 +614,8 @@ IntPtr SyscallMdl::marshallAccessCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::marshallStatCall(syscall_args_t &args)
 {
+   routeToProcessServer();
+
    char *path = (char*) args.arg0;
    struct stat stat_buf;
 
@@ -604,11 +632,11 @@ IntPtr SyscallMdl::marshallStatCall(syscall_args_t &args)
    m_send_buff << make_pair(&stat_buf, sizeof(struct stat));
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get the result
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -623,7 +651,7 @@ IntPtr SyscallMdl::marshallStatCall(syscall_args_t &args)
    // Write the data to memory
    core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) args.arg1, (char*) &stat_buf, sizeof(struct stat));
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    delete [] path_buf;
    
    return result;
@@ -631,7 +659,7 @@ IntPtr SyscallMdl::marshallStatCall(syscall_args_t &args)
 
 IntPtr SyscallMdl::marshallFstatCall(syscall_args_t &args)
 {
-   int fd = (int) args.arg0;
+   int fd = routeFd((int) args.arg0);
    struct stat buf;
 
    Core* core = Sim()->getTileManager()->getCurrentCore();
@@ -643,11 +671,11 @@ IntPtr SyscallMdl::marshallFstatCall(syscall_args_t &args)
    m_send_buff << make_pair(&buf, sizeof(struct stat));
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get the result
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -662,14 +690,14 @@ IntPtr SyscallMdl::marshallFstatCall(syscall_args_t &args)
    // Write the data to memory
    core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) args.arg1, (char*) &buf, sizeof(struct stat));
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    
    return result;
 }
 
 IntPtr SyscallMdl::marshallIoctlCall(syscall_args_t &args)
 {
-   int fd = (int) args.arg0;
+   int fd = routeFd((int) args.arg0);
    int request = (int) args.arg1;
 
    LOG_ASSERT_ERROR(request == TCGETS, "ioctl() system call, only TCGETS request supported, request(0x%x)", request);
@@ -686,11 +714,11 @@ IntPtr SyscallMdl::marshallIoctlCall(syscall_args_t &args)
    m_send_buff << make_pair(&buf, sizeof(struct termios));
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get the result
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -703,20 +731,25 @@ IntPtr SyscallMdl::marshallIoctlCall(syscall_args_t &args)
    // Write the data to memory
    core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) args.arg2, (char*) &buf, sizeof(struct termios));
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    
    return result;
 }
 
 IntPtr SyscallMdl::marshallGetpidCall (syscall_args_t &args)
 {
+   // The pid is fetched once from the MCP so that every process of the
+   // simulation reports the same pid
+   if (m_pid != 0)
+      return m_pid;
+
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get a result
    NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -725,14 +758,15 @@ IntPtr SyscallMdl::marshallGetpidCall (syscall_args_t &args)
    int result;
    m_recv_buff >> result;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
+   m_pid = result;
    return result;
 }
 
 IntPtr SyscallMdl::marshallReadaheadCall(syscall_args_t &args)
 {
-   int fd = (int) args.arg0;
+   int fd = routeFd((int) args.arg0);
    UInt32 offset_msb = (UInt32) args.arg1;
    UInt32 offset_lsb = (UInt32) args.arg2;
    size_t count = (size_t) args.arg3;
@@ -745,12 +779,12 @@ IntPtr SyscallMdl::marshallReadaheadCall(syscall_args_t &args)
    m_send_buff << fd << offset << count;
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get a result
    NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -759,7 +793,7 @@ IntPtr SyscallMdl::marshallReadaheadCall(syscall_args_t &args)
    int result;
    m_recv_buff >> result;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return result;
 }
@@ -771,11 +805,11 @@ IntPtr SyscallMdl::marshallPipeCall (syscall_args_t &args)
    Core *core = Sim()->getTileManager()->getCurrentCore();
 
    // send the data
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    // get a result
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    // Create a buffer out of the result
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -792,7 +826,7 @@ IntPtr SyscallMdl::marshallPipeCall (syscall_args_t &args)
    
    core->accessMemory (Core::NONE, Core::WRITE, (IntPtr) fd, (char*) fd_buff, 2 * sizeof(int));
       
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return result;
 }
@@ -854,6 +888,9 @@ IntPtr SyscallMdl::marshallMmapCall (syscall_args_t &args)
    LOG_PRINT("start(%p), length(0x%x), prot(0x%x), flags(0x%x), fd(%i), pgoffset(%u)",
          start, length, prot, flags, fd, pgoffset);
 
+   if (!(flags & MAP_ANONYMOUS) && rejectProcessFd(SYS_mmap, fd))
+      return (carbon_reg_t) -EBADF;
+
    if (Config::getSingleton()->isSimulatingSharedMemory())
    {
       m_send_buff.put(start);
@@ -864,12 +901,12 @@ IntPtr SyscallMdl::marshallMmapCall (syscall_args_t &args)
       m_send_buff.put(pgoffset);
 
       // send the data
-      m_network->netSend (Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+      m_network->netSend (m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
       // get a result
       NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-      recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+      recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
       // Create a buffer out of the result
       m_recv_buff << make_pair (recv_pkt.data, recv_pkt.length);
@@ -879,7 +916,7 @@ IntPtr SyscallMdl::marshallMmapCall (syscall_args_t &args)
       m_recv_buff.get(addr);
 
       // Delete the data buffer
-      delete [] (Byte*) recv_pkt.data;
+      recv_pkt.release();
 
       return (carbon_reg_t) addr;
    }
@@ -922,12 +959,12 @@ IntPtr SyscallMdl::marshallMunmapCall (syscall_args_t &args)
       m_send_buff.put (length);
 
       // send the data
-      m_network->netSend (Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer (), m_send_buff.size ());
+      m_network->netSend (m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer (), m_send_buff.size ());
 
       // get a result
       NetPacket recv_pkt;
       Core *core = Sim()->getTileManager()->getCurrentCore();
-      recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+      recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
       // Create a buffer out of the result
       m_recv_buff << make_pair (recv_pkt.data, recv_pkt.length);
@@ -937,7 +974,7 @@ IntPtr SyscallMdl::marshallMunmapCall (syscall_args_t &args)
       m_recv_buff.get(ret_val);
 
       // Delete the data buffer
-      delete [] (Byte*) recv_pkt.data;
+      recv_pkt.release();
 
       return (carbon_reg_t) ret_val;
    }
@@ -974,12 +1011,12 @@ IntPtr SyscallMdl::marshallBrkCall (syscall_args_t &args)
       m_send_buff.put (end_data_segment);
 
       // send the data
-      m_network->netSend (Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+      m_network->netSend (m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
       // get a result
       NetPacket recv_pkt;
       Core *core = Sim()->getTileManager()->getCurrentCore();
-      recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+      recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
       // Create a buffer out of the result
       m_recv_buff << make_pair (recv_pkt.data, recv_pkt.length);
@@ -989,7 +1026,7 @@ IntPtr SyscallMdl::marshallBrkCall (syscall_args_t &args)
       m_recv_buff.get (new_end_data_segment);
 
       // Delete the data buffer
-      delete [] (Byte*) recv_pkt.data;
+      recv_pkt.release();
 
       return (carbon_reg_t) new_end_data_segment;
    }
@@ -1029,14 +1066,14 @@ IntPtr SyscallMdl::marshallFutexCall (syscall_args_t &args)
       m_send_buff.put(start_time);
 
       // send the data
-      m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+      m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
       // Set the CoreState to 'STALLED'
       core->setState(Core::STALLED);
 
       // get a result
       NetPacket recv_pkt;
-      recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+      recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
       // Set the CoreState to 'RUNNING'
       core->setState(Core::WAKING_UP);
@@ -1061,7 +1098,7 @@ IntPtr SyscallMdl::marshallFutexCall (syscall_args_t &args)
       }
 
       // Delete the data buffer
-      delete [] (Byte*) recv_pkt.data;
+      recv_pkt.release();
 
       return (carbon_reg_t) ret_val;
    }
@@ -1102,10 +1139,10 @@ IntPtr SyscallMdl::marshallUnlinkCall(syscall_args_t &args)
    core->accessMemory (Core::NONE, Core::READ, (IntPtr) path, (char*) path_buf, len_fname);
 
    m_send_buff << len_fname << make_pair(path_buf, len_fname);
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
    assert(recv_pkt.length == sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
@@ -1113,7 +1150,7 @@ IntPtr SyscallMdl::marshallUnlinkCall(syscall_args_t &args)
    m_recv_buff >> status;
 
    delete [] path_buf;
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return status;
 }
@@ -1193,15 +1230,17 @@ IntPtr SyscallMdl::marshallGetCwdCall(syscall_args_t &args)
 
    */
 
+   routeToProcessServer();
+
    char* buf = (char *)args.arg0;
    size_t size = (size_t)args.arg1;
 
    m_send_buff << size;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    assert(recv_pkt.length >= sizeof(int));
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
@@ -1226,7 +1265,7 @@ IntPtr SyscallMdl::marshallGetCwdCall(syscall_args_t &args)
       assert(m_recv_buff.size() == 0);
    }
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
 
    return (carbon_reg_t) buf;
 }
@@ -1265,15 +1304,15 @@ IntPtr SyscallMdl::marshallSchedSetAffinityCall(syscall_args_t &args)
    core->accessMemory (Core::NONE, Core::READ, (IntPtr) mask, (char*) write_buf, CPU_ALLOC_SIZE(cpusetsize));
 
    m_send_buff << pid << cpusetsize << write_buf;
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
    m_recv_buff >> status;
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    delete [] write_buf;
 
    return status;
@@ -1308,10 +1347,10 @@ IntPtr SyscallMdl::marshallSchedGetAffinityCall(syscall_args_t &args)
 
    m_send_buff << pid << cpusetsize;
    Core *core = Sim()->getTileManager()->getCurrentCore();
-   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
 
    NetPacket recv_pkt;
-   recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), core->getId(), MCP_RESPONSE_TYPE);
+   recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
 
    m_recv_buff << make_pair(recv_pkt.data, recv_pkt.length);
 
@@ -1324,13 +1363,43 @@ IntPtr SyscallMdl::marshallSchedGetAffinityCall(syscall_args_t &args)
    // Write the data to memory
    core->accessMemory(Core::NONE, Core::WRITE, (IntPtr) mask, read_buf, CPU_ALLOC_SIZE(cpusetsize));
 
-   delete [] (Byte*) recv_pkt.data;
+   recv_pkt.release();
    delete [] read_buf;
 
    return status;
 }
 
 // Helper functions
+// Sends a path-based syscall (open, access, stat, getcwd) to the server of this process
+void SyscallMdl::routeToProcessServer()
+{
+   if (m_per_process_server)
+      m_server = Config::getSingleton()->getCurrentThreadSpawnerCoreId();
+}
+
+// Sends a syscall on fd to the server that opened it and returns the fd
+// that server knows it by
+int SyscallMdl::routeFd(int fd)
+{
+   if (!SyscallServer::isProcessFd(fd))
+      return fd;
+
+   m_server = Config::getSingleton()->getThreadSpawnerCoreId(SyscallServer::getFdProcess(fd));
+   return SyscallServer::getHostFd(fd);
+}
+
+// Fds of per-process servers cannot be used by the syscalls that are not
+// marshalled to a server; these fail with EBADF instead of reaching the host
+bool SyscallMdl::rejectProcessFd(IntPtr syscall_number, int fd)
+{
+   if (!m_per_process_server || !SyscallServer::isProcessFd(fd))
+      return false;
+
+   LOG_PRINT_WARNING("Syscall(%i) is not supported on fd(%i) opened by a per-process syscall server",
+                     (SInt32) syscall_number, fd);
+   return true;
+}
+
 UInt32 SyscallMdl::getStrLen (char *str)
 {
    UInt32 len = 0;
@@ -1350,3 +1419,49 @@ UInt32 SyscallMdl::getStrLen (char *str)
    }
    return len;
 }
+
+// Sends the request in m_send_buff with the first chunk of the payload,
+// followed by one MCP_MESSAGE_SYS_CALL_DATA message per remaining chunk
+void SyscallMdl::sendPayload(const char *buf, UInt64 count)
+{
+   UInt64 first_chunk = min<UInt64>(count, m_chunk_size);
+   m_send_buff << make_pair(buf, first_chunk);
+   m_network->netSend(m_server, MCP_REQUEST_TYPE, m_send_buff.getBuffer(), m_send_buff.size());
+
+   for (UInt64 offset = first_chunk; offset < count; offset += m_chunk_size)
+   {
+      UInt64 chunk = min<UInt64>(count - offset, m_chunk_size);
+
+      UnstructuredBuffer chunk_buff;
+      chunk_buff << (int) MCP_MESSAGE_SYS_CALL_DATA << make_pair(buf + offset, chunk);
+      m_network->netSend(m_server, MCP_REQUEST_TYPE, chunk_buff.getBuffer(), chunk_buff.size());
+   }
+}
+
+// The first chunk of the payload is left in m_recv_buff, the remaining
+// chunks follow in separate packets
+void SyscallMdl::recvPayload(IntPtr address, UInt64 count)
+{
+   Core *core = Sim()->getTileManager()->getCurrentCore();
+
+   UInt64 first_chunk = m_recv_buff.size();
+   assert(first_chunk == min<UInt64>(count, m_chunk_size));
+
+   char *chunk_buf = new char[first_chunk];
+   m_recv_buff >> make_pair(chunk_buf, first_chunk);
+   core->accessMemory(Core::NONE, Core::WRITE, address, chunk_buf, first_chunk);
+
+   for (UInt64 offset = first_chunk; offset < count; )
+   {
+      NetPacket recv_pkt;
+      recv_pkt = m_network->netRecv(m_server, core->getId(), MCP_RESPONSE_TYPE);
+      assert(recv_pkt.length <= first_chunk && offset + recv_pkt.length <= count);
+
+      core->accessMemory(Core::NONE, Core::WRITE, address + offset, (char*) recv_pkt.data, recv_pkt.length);
+      offset += recv_pkt.length;
+
+      recv_pkt.release();
+   }
+
+   delete [] chunk_buf;
+}
@@ -58,6 +58,14 @@ class SyscallMdl
       UnstructuredBuffer m_send_buff;
       UnstructuredBuffer m_recv_buff;
       Network *m_network;
+      // Large read/write payloads go over the network in chunks of this size
+      UInt32 m_chunk_size;
+      // syscall_server/per_process
+      bool m_per_process_server;
+      // Server of the syscall in progress (the MCP or a process server)
+      core_id_t m_server;
+      // Cached result of getpid, 0 until the first call
+      int m_pid;
 
       IntPtr marshallOpenCall(syscall_args_t &args);
       IntPtr marshallReadCall(syscall_args_t &args);
@@ -87,6 +95,11 @@ class SyscallMdl
 
       // Helper functions
       UInt32 getStrLen (char *str);
+      void routeToProcessServer();
+      int routeFd(int fd);
+      bool rejectProcessFd(IntPtr syscall_number, int fd);
+      void sendPayload(const char *buf, UInt64 count);
+      void recvPayload(IntPtr address, UInt64 count);
 
       struct mmap_arg_struct
       {
@@ -1,9 +1,13 @@
+#include <cstring>
+#include <algorithm>
+#include <new>
 #include "simulator.h"
 #include "cache.h"
 #include "cache_set.h"
 #include "cache_line_info.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "miss_type_tracker.h"
 #include "utils.h"
 #include "log.h"
 
@@ -25,12 +29,15 @@ Cache::Cache(string name,
    : _enabled(false)
    , _name(name)
    , _cache_category(cache_category)
+   , _caching_protocol_type(caching_protocol_type)
+   , _cache_level(cache_level)
    , _write_policy(write_policy)
    , _cache_size(k_KILO * cache_size)
    , _associativity(associativity)
    , _line_size(line_size)
    , _replacement_policy(replacement_policy)
    , _hash_fn(hash_fn)
+   , _miss_type_tracker(NULL)
    , _power_model(NULL)
    , _area_model(NULL)
    , _track_miss_types(track_miss_types)
@@ -38,10 +45,21 @@ Cache::Cache(string name,
    _num_sets = _cache_size / (_associativity * _line_size);
    _log_line_size = floorLog2(_line_size);
    
-   _sets = new CacheSet*[_num_sets];
+   UInt32 num_lines = _num_sets * _associativity;
+   _cache_line_info_array = new CacheLineInfo*[num_lines];
+   CacheLineInfo::createArray(caching_protocol_type, cache_level, num_lines, _cache_line_info_array);
+   _tags = new IntPtr[num_lines];
+   for (UInt32 i = 0; i < num_lines; i++)
+      _tags[i] = _cache_line_info_array[i]->getTag();
+   _lines = new char[num_lines * _line_size];
+   memset(_lines, 0x00, num_lines * _line_size);
+
+   _sets = (CacheSet*) ::operator new(_num_sets * sizeof(CacheSet));
    for (UInt32 i = 0; i < _num_sets; i++)
    {
-      _sets[i] = new CacheSet(i, caching_protocol_type, cache_level, _replacement_policy, _associativity, _line_size);
+      UInt32 first_line = i * _associativity;
+      new (&_sets[i]) CacheSet(i, &_tags[first_line], &_cache_line_info_array[first_line],
+                               &_lines[first_line * _line_size], _replacement_policy, _associativity, _line_size);
    }
 
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -55,6 +73,10 @@ Cache::Cache(string name,
             associativity, access_delay, frequency);
    }
 
+   if (_track_miss_types)
+      _miss_type_tracker = MissTypeTracker::create(Sim()->getCfg()->getString("miss_type_tracking/engine", "exact"),
+                                                    num_lines, _line_size);
+
    // Initialize Cache Counters
    // Hit/miss counters
    initializeMissCounters();
@@ -68,9 +90,17 @@ Cache::Cache(string name,
 
 Cache::~Cache()
 {
-   for (SInt32 i = 0; i < (SInt32) _num_sets; i++)
-      delete _sets[i];
-   delete [] _sets;
+   if (_miss_type_tracker)
+      delete _miss_type_tracker;
+
+   for (UInt32 i = 0; i < _num_sets; i++)
+      _sets[i].~CacheSet();
+   ::operator delete(_sets);
+
+   CacheLineInfo::destroyArray(_cache_line_info_array, _num_sets * _associativity);
+   delete [] _cache_line_info_array;
+   delete [] _tags;
+   delete [] _lines;
 }
 
 void
@@ -129,19 +159,15 @@ Cache::insertCacheLine(IntPtr inserted_address, CacheLineInfo* inserted_cache_li
       assert(*evicted_address != INVALID_ADDRESS);
 
       if (_track_miss_types)
-         _evicted_address_set.insert(*evicted_address);
+         _miss_type_tracker->recordEviction(*evicted_address);
 
       // Update exclusive/sharing counters
       updateCacheLineStateCounters(evicted_cache_line_info->getCState(), CacheState::INVALID);
    }
 
-   // Clear the miss type tracking sets for this address
-   if (_track_miss_types)
-      clearMissTypeTrackingSets(inserted_address);
-
-   // Add to fetched set for tracking miss type
+   // Clear the miss type tracking state for this address and add it to the fetched addresses
    if (_track_miss_types)
-      _fetched_address_set.insert(inserted_address);
+      _miss_type_tracker->recordFetch(inserted_address);
 
    // Update exclusive/sharing counters
    updateCacheLineStateCounters(CacheState::INVALID, inserted_cache_line_info->getCState());
@@ -236,18 +262,20 @@ void
 Cache::setCacheLineInfo(IntPtr address, CacheLineInfo* updated_cache_line_info)
 {
    LOG_PRINT("setCacheLineInfo: Address(%#lx) start", address);
-   CacheLineInfo* cache_line_info = getCacheLineInfo(address);
+   CacheSet* set = getSet(address);
+   UInt32 line_index = -1;
+   CacheLineInfo* cache_line_info = set->find(getTag(address), &line_index);
    LOG_ASSERT_ERROR(cache_line_info, "Address(%#lx)", address);
 
    // Update exclusive/shared counters
    updateCacheLineStateCounters(cache_line_info->getCState(), updated_cache_line_info->getCState());
   
-   // Update _invalidated_address_set
+   // Update the invalidated addresses
    if ( (updated_cache_line_info->getCState() == CacheState::INVALID) && (_track_miss_types) )
-      _invalidated_address_set.insert(address);
+      _miss_type_tracker->recordInvalidation(address);
 
-   // Update the cache line info   
-   cache_line_info->assign(updated_cache_line_info);
+   // Update the cache line info (and the tag array)
+   set->update(line_index, updated_cache_line_info);
    
    if (_enabled)
    {
@@ -335,7 +363,7 @@ Cache::updateMissCounters(IntPtr address, Core::mem_op_t mem_op_type, bool cache
          // Compute the miss type counters for the inserted line
          if (_track_miss_types)
          {
-            miss_type = getMissType(address);
+            miss_type = _miss_type_tracker->getMissType(address);
             updateMissTypeCounters(address, miss_type);
          }
       }
@@ -344,20 +372,6 @@ Cache::updateMissCounters(IntPtr address, Core::mem_op_t mem_op_type, bool cache
    return miss_type;
 }
 
-Cache::MissType
-Cache::getMissType(IntPtr address) const
-{
-   // We maintain three address sets to keep track of miss types
-   if (_evicted_address_set.find(address) != _evicted_address_set.end())
-      return CAPACITY_MISS;
-   else if (_invalidated_address_set.find(address) != _invalidated_address_set.end())
-      return SHARING_MISS;
-   else if (_fetched_address_set.find(address) != _fetched_address_set.end())
-      return SHARING_MISS;
-   else
-      return COLD_MISS;
-}
-
 void
 Cache::updateMissTypeCounters(IntPtr address, MissType miss_type)
 {
@@ -379,14 +393,6 @@ Cache::updateMissTypeCounters(IntPtr address, MissType miss_type)
    }
 }
 
-void
-Cache::clearMissTypeTrackingSets(IntPtr address)
-{
-   if (_evicted_address_set.erase(address));
-   else if (_invalidated_address_set.erase(address));
-   else if (_fetched_address_set.erase(address));
-}
-
 void
 Cache::updateCacheLineStateCounters(CacheState::Type old_cstate, CacheState::Type new_cstate)
 {
@@ -400,6 +406,91 @@ Cache::getCacheLineStateCounters(vector<UInt64>& cache_line_state_counters) cons
    cache_line_state_counters = _cache_line_state_counters;
 }
 
+void
+Cache::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_CACHE);
+   checkpoint << _num_sets << _associativity << _line_size;
+
+   UInt32 num_lines = _num_sets * _associativity;
+   for (UInt32 i = 0; i < num_lines; i++)
+      _cache_line_info_array[i]->saveState(checkpoint);
+   checkpoint.put(_lines, num_lines * _line_size);
+   _replacement_policy->saveState(checkpoint);
+
+   checkpoint.put(_cache_line_state_counters);
+   checkpoint << _track_miss_types;
+   if (_track_miss_types)
+   {
+      checkpoint << _miss_type_tracker->getType();
+      _miss_type_tracker->saveState(checkpoint);
+   }
+}
+
+void
+Cache::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.checkSection(CHECKPOINT_CACHE);
+   UInt32 num_sets, associativity, line_size;
+   checkpoint >> num_sets >> associativity >> line_size;
+   LOG_ASSERT_ERROR((num_sets == _num_sets) && (associativity == _associativity) && (line_size == _line_size),
+                    "%s: checkpointed geometry (%u sets, %u ways, %u byte lines) does not match (%u sets, %u ways, %u byte lines)",
+                    _name.c_str(), num_sets, associativity, line_size, _num_sets, _associativity, _line_size);
+
+   // The lines hold the live application's data, so they are only compared
+   // against the checkpoint
+   UInt32 num_lines = _num_sets * _associativity;
+   vector<bool> mismatched_lines(num_lines, false);
+   CacheLineInfo* saved_line_info = CacheLineInfo::create(_caching_protocol_type, _cache_level);
+   for (UInt32 i = 0; i < num_lines; i++)
+   {
+      saved_line_info->restoreState(checkpoint);
+      if ((saved_line_info->getTag() != _cache_line_info_array[i]->getTag()) ||
+          (saved_line_info->getCState() != _cache_line_info_array[i]->getCState()))
+         mismatched_lines[i] = true;
+   }
+   delete saved_line_info;
+
+   char* saved_lines = new char[num_lines * _line_size];
+   checkpoint.get(saved_lines, num_lines * _line_size);
+   UInt32 num_mismatched_lines = 0;
+   for (UInt32 i = 0; i < num_lines; i++)
+   {
+      if (memcmp(&saved_lines[i * _line_size], &_lines[i * _line_size], _line_size) != 0)
+         mismatched_lines[i] = true;
+      if (mismatched_lines[i])
+         num_mismatched_lines ++;
+   }
+   delete [] saved_lines;
+
+   if (num_mismatched_lines > 0)
+   {
+      LOG_PRINT_WARNING("%s: %u of %u lines differ from the checkpoint, keeping the live ones",
+                        _name.c_str(), num_mismatched_lines, num_lines);
+   }
+
+   _replacement_policy->restoreState(checkpoint);
+
+   // The state counters describe the live lines
+   vector<UInt64> saved_cache_line_state_counters;
+   checkpoint.get(saved_cache_line_state_counters);
+
+   bool saved_miss_types;
+   checkpoint >> saved_miss_types;
+   if (saved_miss_types)
+   {
+      // Restored into a tracker of the saved engine, which is kept only
+      // if it is the engine this cache uses
+      MissTypeTracker::Type engine;
+      checkpoint >> engine;
+      MissTypeTracker* miss_type_tracker = MissTypeTracker::create(engine, num_lines, _line_size);
+      miss_type_tracker->restoreState(checkpoint);
+      if (_track_miss_types && (engine == _miss_type_tracker->getType()))
+         std::swap(miss_type_tracker, _miss_type_tracker);
+      delete miss_type_tracker;
+   }
+}
+
 void
 Cache::outputSummary(ostream& out)
 {
@@ -470,7 +561,7 @@ CacheSet*
 Cache::getSet(IntPtr address) const
 {
    UInt32 set_num = _hash_fn->compute(address);
-   return _sets[set_num];
+   return &_sets[set_num];
 }
 
 UInt32
@@ -1,10 +1,8 @@
 #pragma once
 
 #include <string>
-#include <set>
 #include <cassert>
 using std::string;
-using std::set;
 
 #include "core.h"
 #include "cache_state.h"
@@ -16,12 +14,14 @@ using std::set;
 #include "fixed_types.h"
 #include "caching_protocol_type.h"
 #include "constants.h"
+#include "checkpoint_stream.h"
 
 // Forwards Decls
 class CacheSet;
 class CacheLineInfo;
 class CacheReplacementPolicy;
 class CacheHashFn;
+class MissTypeTracker;
 
 class Cache
 {
@@ -110,6 +110,12 @@ public:
    
    virtual void outputSummary(ostream& out);
 
+   // Line states, data and replacement state (not the statistics). The
+   // lines hold the live application's data, so a restore only compares
+   // them against the checkpoint and restores the replacement state
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
 private:
    // Is enabled?
    bool _enabled;
@@ -117,8 +123,15 @@ private:
    // Generic Cache Info
    string _name;
    CacheCategory _cache_category;
+   CachingProtocolType _caching_protocol_type;
+   SInt32 _cache_level;
    WritePolicy _write_policy;
-   CacheSet** _sets;
+
+   // Tag store - contiguous arrays indexed by (set_num * associativity + way)
+   IntPtr* _tags;
+   CacheLineInfo** _cache_line_info_array;
+   char* _lines;
+   CacheSet* _sets;
 
    // Cache params
    UInt32 _cache_size;
@@ -143,10 +156,8 @@ private:
    UInt64 _total_cold_misses;
    UInt64 _total_capacity_misses;
    UInt64 _total_sharing_misses;
-   // State for tracking type of cache misses
-   set<IntPtr> _fetched_address_set;
-   set<IntPtr> _evicted_address_set;
-   set<IntPtr> _invalidated_address_set;
+   // State for tracking type of cache misses (NULL unless _track_miss_types)
+   MissTypeTracker* _miss_type_tracker;
 
    // Evictions
    UInt64 _total_evictions;
@@ -185,9 +196,7 @@ private:
    CacheLineInfo* getCacheLineInfo(IntPtr address);
 
    // Update miss type counters
-   MissType getMissType(IntPtr address) const;
    void updateMissTypeCounters(IntPtr address, MissType miss_type);
-   void clearMissTypeTrackingSets(IntPtr address);
    
    // Update counters that record the state of cache lines
    void updateCacheLineStateCounters(CacheState::Type old_cstate, CacheState::Type new_cstate);
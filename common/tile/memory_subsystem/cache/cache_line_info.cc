@@ -32,6 +32,43 @@ CacheLineInfo::create(CachingProtocolType caching_protocol_type, SInt32 cache_le
    }
 }
 
+void
+CacheLineInfo::createArray(CachingProtocolType caching_protocol_type, SInt32 cache_level,
+                           UInt32 num_lines, CacheLineInfo** cache_line_info_array)
+{
+   switch (caching_protocol_type)
+   {
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MSI:
+      PrL1PrL2DramDirectoryMSI::createCacheLineInfoArray(cache_level, num_lines, cache_line_info_array);
+      break;
+
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MOSI:
+      PrL1PrL2DramDirectoryMOSI::createCacheLineInfoArray(cache_level, num_lines, cache_line_info_array);
+      break;
+
+   case PR_L1_SH_L2_MSI:
+      PrL1ShL2MSI::createCacheLineInfoArray(cache_level, num_lines, cache_line_info_array);
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized caching protocol type(%u)", caching_protocol_type);
+      break;
+   }
+}
+
+void
+CacheLineInfo::destroyArray(CacheLineInfo** cache_line_info_array, UInt32 num_lines)
+{
+   if (num_lines == 0)
+      return;
+
+   // The first line info starts the contiguous block allocated in constructArray()
+   void* storage = dynamic_cast<void*>(cache_line_info_array[0]);
+   for (UInt32 i = 0; i < num_lines; i++)
+      cache_line_info_array[i]->~CacheLineInfo();
+   ::operator delete(storage);
+}
+
 void
 CacheLineInfo::invalidate()
 {
@@ -45,3 +82,15 @@ CacheLineInfo::assign(CacheLineInfo* cache_line_info)
    _tag = cache_line_info->getTag();
    _cstate = cache_line_info->getCState();
 }
+
+void
+CacheLineInfo::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint << _tag << _cstate;
+}
+
+void
+CacheLineInfo::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint >> _tag >> _cstate;
+}
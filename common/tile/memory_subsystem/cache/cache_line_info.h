@@ -1,9 +1,12 @@
 #pragma once
 
+#include <new>
+
 #include "fixed_types.h"
 #include "cache.h"
 #include "cache_utils.h"
 #include "caching_protocol_type.h"
+#include "checkpoint_stream.h"
 
 class CacheLineInfo
 {
@@ -14,10 +17,20 @@ public:
    virtual ~CacheLineInfo();
 
    static CacheLineInfo* create(CachingProtocolType caching_protocol_type, SInt32 cache_level);
+   // Create/destroy 'num_lines' protocol-specific line infos laid out in one contiguous block
+   static void createArray(CachingProtocolType caching_protocol_type, SInt32 cache_level,
+                           UInt32 num_lines, CacheLineInfo** cache_line_info_array);
+   static void destroyArray(CacheLineInfo** cache_line_info_array, UInt32 num_lines);
+
+   template <class LineInfoType>
+   static void constructArray(UInt32 num_lines, CacheLineInfo** cache_line_info_array);
 
    virtual void invalidate();
    virtual void assign(CacheLineInfo* cache_line_info);
 
+   virtual void saveState(CheckpointWriter& checkpoint);
+   virtual void restoreState(CheckpointReader& checkpoint);
+
    bool isValid() const                        
    { return (_tag != ((IntPtr) ~0)); }
    IntPtr getTag() const                        
@@ -34,3 +47,12 @@ protected:
    IntPtr _tag;
    CacheState::Type _cstate;
 };
+
+template <class LineInfoType>
+void
+CacheLineInfo::constructArray(UInt32 num_lines, CacheLineInfo** cache_line_info_array)
+{
+   char* storage = (char*) ::operator new(num_lines * sizeof(LineInfoType));
+   for (UInt32 i = 0; i < num_lines; i++)
+      cache_line_info_array[i] = new (storage + i * sizeof(LineInfoType)) LineInfoType();
+}
@@ -1,6 +1,8 @@
 #include "cache_replacement_policy.h"
 #include "round_robin_replacement_policy.h"
 #include "lru_replacement_policy.h"
+#include "tree_plru_replacement_policy.h"
+#include "packed_lru_replacement_policy.h"
 #include "cache_line_info.h"
 #include "log.h"
 
@@ -24,6 +26,10 @@ CacheReplacementPolicy::create(string policy_str, UInt32 cache_size, UInt32 asso
       return new RoundRobinReplacementPolicy(cache_size, associativity, cache_line_size);
    case LRU:
       return new LRUReplacementPolicy(cache_size, associativity, cache_line_size);
+   case TREE_PLRU:
+      return new TreePLRUReplacementPolicy(cache_size, associativity, cache_line_size);
+   case PACKED_LRU:
+      return new PackedLRUReplacementPolicy(cache_size, associativity, cache_line_size);
    default:
       LOG_PRINT_ERROR("Unrecognized Replacement Policy(%u)", policy);
       return (CacheReplacementPolicy*) NULL;
@@ -37,6 +43,10 @@ CacheReplacementPolicy::parse(string policy_str)
       return ROUND_ROBIN;
    if (policy_str == "lru")
       return LRU;
+   if (policy_str == "tree_plru")
+      return TREE_PLRU;
+   if (policy_str == "packed_lru")
+      return PACKED_LRU;
    else
    {
       LOG_PRINT_ERROR("Unrecognized Cache Replacement Policy(%s)", policy_str.c_str());
@@ -5,6 +5,7 @@ using std::string;
 
 #include "fixed_types.h"
 #include "caching_protocol_type.h"
+#include "checkpoint_stream.h"
 
 class CacheLineInfo;
 
@@ -15,6 +16,8 @@ public:
    {
       ROUND_ROBIN = 0,
       LRU,
+      TREE_PLRU,
+      PACKED_LRU,
       NUM_TYPES
    };
 
@@ -26,6 +29,13 @@ public:
    
    virtual UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num) = 0;
    virtual void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way) = 0;
+   // Called when a line of the set is invalidated in place
+   virtual void invalidate(UInt32 set_num, UInt32 way) {}
+
+   // Policies that keep replacement state of their own save it here. The
+   // valid ways follow the live lines and are not part of it
+   virtual void saveState(CheckpointWriter& checkpoint) {}
+   virtual void restoreState(CheckpointReader& checkpoint) {}
 
 protected:
    UInt32 _num_sets;
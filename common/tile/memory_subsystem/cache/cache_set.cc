@@ -3,30 +3,20 @@
 #include "cache.h"
 #include "log.h"
 
-CacheSet::CacheSet(UInt32 set_num, CachingProtocolType caching_protocol_type, SInt32 cache_level,
+CacheSet::CacheSet(UInt32 set_num, IntPtr* tags, CacheLineInfo** cache_line_info_array, char* lines,
                    CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size)
-   : _set_num(set_num)
+   : _tags(tags)
+   , _cache_line_info_array(cache_line_info_array)
+   , _lines(lines)
+   , _set_num(set_num)
    , _replacement_policy(replacement_policy)
    , _associativity(associativity)
    , _line_size(line_size)
-{
-   _cache_line_info_array = new CacheLineInfo*[_associativity];
-   for (UInt32 i = 0; i < _associativity; i++)
-   {
-      _cache_line_info_array[i] = CacheLineInfo::create(caching_protocol_type, cache_level);
-   }
-   _lines = new char[_associativity * _line_size];
-   
-   memset(_lines, 0x00, _associativity * _line_size);
-}
+   , _tag_match(associativity)
+{}
 
 CacheSet::~CacheSet()
-{
-   for (UInt32 i = 0; i < _associativity; i++)
-      delete _cache_line_info_array[i];
-   delete [] _cache_line_info_array;
-   delete [] _lines;
-}
+{}
 
 void 
 CacheSet::read_line(UInt32 line_index, UInt32 offset, Byte *out_buf, UInt32 bytes)
@@ -57,16 +47,13 @@ CacheSet::write_line(UInt32 line_index, UInt32 offset, Byte *in_buf, UInt32 byte
 CacheLineInfo* 
 CacheSet::find(IntPtr tag, UInt32* line_index)
 {
-   for (SInt32 index = _associativity-1; index >= 0; index--)
-   {
-      if (_cache_line_info_array[index]->getTag() == tag)
-      {
-         if (line_index != NULL)
-            *line_index = index;
-         return (_cache_line_info_array[index]);
-      }
-   }
-   return NULL;
+   SInt32 index = _tag_match.findHighest(_tags, tag);
+   if (index < 0)
+      return NULL;
+
+   if (line_index != NULL)
+      *line_index = index;
+   return (_cache_line_info_array[index]);
 }
 
 void 
@@ -95,9 +82,21 @@ CacheSet::insert(CacheLineInfo* inserted_cache_line_info, Byte* fill_buf,
    }
 
    _cache_line_info_array[index]->assign(inserted_cache_line_info);
+   _tags[index] = inserted_cache_line_info->getTag();
    if (fill_buf != NULL)
       memcpy(&_lines[index * _line_size], (void*) fill_buf, _line_size);
 
    // Update replacement policy
    _replacement_policy->update(_cache_line_info_array, _set_num, index);
 }
+
+void
+CacheSet::update(UInt32 line_index, CacheLineInfo* updated_cache_line_info)
+{
+   assert(line_index < _associativity);
+   _cache_line_info_array[line_index]->assign(updated_cache_line_info);
+   _tags[line_index] = updated_cache_line_info->getTag();
+
+   if (!updated_cache_line_info->isValid())
+      _replacement_policy->invalidate(_set_num, line_index);
+}
@@ -3,12 +3,15 @@
 #include "fixed_types.h"
 #include "cache_line_info.h"
 #include "cache_replacement_policy.h"
+#include "tag_match.h"
 
 // Everything related to cache sets
+// A CacheSet is a view over one set's slice of the contiguous tag, line info and
+// data arrays owned by the Cache (indexed by set_num * associativity + way)
 class CacheSet
 {
 public:
-   CacheSet(UInt32 set_num, CachingProtocolType caching_protocol_type, SInt32 cache_level,
+   CacheSet(UInt32 set_num, IntPtr* tags, CacheLineInfo** cache_line_info_array, char* lines,
             CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size);
    ~CacheSet();
 
@@ -17,12 +20,15 @@ public:
    CacheLineInfo* find(IntPtr tag, UInt32* line_index = NULL);
    void insert(CacheLineInfo* inserted_cache_line_info, Byte* fill_buf,
                bool* eviction, CacheLineInfo* evicted_cache_line_info, Byte* writeback_buf);
+   void update(UInt32 line_index, CacheLineInfo* updated_cache_line_info);
 
 private:
+   IntPtr* _tags;
    CacheLineInfo** _cache_line_info_array;
    char* _lines;
    UInt32 _set_num;
    CacheReplacementPolicy* _replacement_policy;
    UInt32 _associativity;
    UInt32 _line_size;
+   TagMatch _tag_match;
 };
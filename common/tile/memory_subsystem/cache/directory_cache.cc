@@ -22,12 +22,14 @@ DirectoryCache::DirectoryCache(Tile* tile,
    , _max_num_sharers(max_num_sharers)
    , _total_entries_str(total_entries_str)
    , _associativity(associativity)
+   , _tag_match(associativity)
    , _cache_line_size(cache_line_size)
    , _num_directory_slices(num_directory_slices)
    , _directory_access_time_str(directory_access_time_str)
    , _power_model(NULL)
    , _area_model(NULL)
    , _enabled(false)
+   , _statistics(NULL)
 {
    LOG_PRINT("Directory Cache ctor enter");
  
@@ -40,6 +42,9 @@ DirectoryCache::DirectoryCache(Tile* tile,
 
    // Instantiate the directory
    _directory = new Directory(caching_protocol_type, _directory_type, _total_entries, max_hw_sharers, max_num_sharers);
+   _addresses = new IntPtr[_total_entries];
+   for (UInt32 i = 0; i < _total_entries; i++)
+      _addresses[i] = INVALID_ADDRESS;
 
    // Get frequency
    float frequency = _tile->getFrequency();
@@ -72,11 +77,17 @@ DirectoryCache::DirectoryCache(Tile* tile,
    
    initializeEventCounters();
 
+   if (DirectoryStatistics::isEnabled())
+      _statistics = new DirectoryStatistics(_num_sets);
+
    LOG_PRINT("Directory Cache ctor exit");
 }
 
 DirectoryCache::~DirectoryCache()
 {
+   if (_statistics)
+      delete _statistics;
+   delete [] _addresses;
    delete _directory;
 }
 
@@ -119,31 +130,31 @@ DirectoryCache::getDirectoryEntry(IntPtr address)
    
    // Assume that it always hit in the Dram Directory Cache for now
    splitAddress(address, tag, set_index);
+
+   if (_enabled && _statistics)
+      _statistics->recordAccess(address, set_index);
    
    // Find the relevant directory entry
-   for (UInt32 i = 0; i < _associativity; i++)
+   IntPtr* set_addresses = &_addresses[set_index * _associativity];
+   SInt32 way = _tag_match.findLowest(set_addresses, address);
+   if (way >= 0)
    {
-      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + i);
-
-      if (directory_entry->getAddress() == address)
-      {
-         if (getShmemPerfModel())
-            getShmemPerfModel()->incrCurrTime(Latency(directory_entry->getLatency(),_tile->getFrequency()));
-         // Simple check for now. Make sophisticated later
-         return directory_entry;
-      }
+      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + way);
+      if (getShmemPerfModel())
+         getShmemPerfModel()->incrCurrTime(Latency(directory_entry->getLatency(),_tile->getFrequencyDomain()));
+      // Simple check for now. Make sophisticated later
+      return directory_entry;
    }
 
    // Find a free directory entry if one does not currently exist
-   for (UInt32 i = 0; i < _associativity; i++)
+   way = _tag_match.findLowest(set_addresses, INVALID_ADDRESS);
+   if (way >= 0)
    {
-      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + i);
-      if (directory_entry->getAddress() == INVALID_ADDRESS)
-      {
-         // Simple check for now. Make sophisticated later
-         directory_entry->setAddress(address);
-         return directory_entry;
-      }
+      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + way);
+      // Simple check for now. Make sophisticated later
+      directory_entry->setAddress(address);
+      set_addresses[way] = address;
+      return directory_entry;
    }
 
    // Check in the _replaced_directory_entry_list
@@ -182,18 +193,15 @@ DirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr address)
    splitAddress(replaced_address, tag, set_index);
 
    DirectoryEntry* replaced_directory_entry = NULL;
-   DirectoryEntry* new_directory_entry = DirectoryEntry::create(_caching_protocol_type, _directory_type, _max_hw_sharers, _max_num_sharers);
+   DirectoryEntry* new_directory_entry = _directory->createDirectoryEntry();
    new_directory_entry->setAddress(address);
 
-   for (UInt32 i = 0; i < _associativity; i++)
+   SInt32 way = _tag_match.findLowest(&_addresses[set_index * _associativity], replaced_address);
+   if (way >= 0)
    {
-      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + i);
-      if (directory_entry->getAddress() == replaced_address)
-      {
-         replaced_directory_entry = directory_entry;
-         _directory->setDirectoryEntry(set_index * _associativity + i, new_directory_entry);
-         break;
-      }
+      replaced_directory_entry = _directory->getDirectoryEntry(set_index * _associativity + way);
+      _directory->setDirectoryEntry(set_index * _associativity + way, new_directory_entry);
+      _addresses[set_index * _associativity + way] = address;
    }
 
    LOG_ASSERT_ERROR(replaced_directory_entry, "Could not find address(%#lx) to replace", replaced_address);
@@ -211,6 +219,9 @@ DirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr address)
       DirectoryState::Type replaced_dstate = replaced_directory_entry->getDirectoryBlockInfo()->getDState();
       if (replaced_dstate != DirectoryState::UNCACHED)
          _total_back_invalidations ++;
+
+      if (_statistics)
+         _statistics->recordEviction(replaced_address, set_index);
    }
 
    return new_directory_entry;
@@ -224,7 +235,7 @@ DirectoryCache::invalidateDirectoryEntry(IntPtr address)
    {
       if ((*it)->getAddress() == address)
       {
-         delete (*it);
+         _directory->destroyDirectoryEntry(*it);
          _replaced_directory_entry_list.erase(it);
 
          return;
@@ -235,6 +246,49 @@ DirectoryCache::invalidateDirectoryEntry(IntPtr address)
    LOG_PRINT_ERROR("Address(%#lx) not found for invalidation", address);
 }
 
+void
+DirectoryCache::saveState(CheckpointWriter& checkpoint)
+{
+   LOG_ASSERT_ERROR(_replaced_directory_entry_list.empty(),
+                    "Cannot checkpoint with %u directory evictions in flight", _replaced_directory_entry_list.size());
+
+   checkpoint.putSection(CHECKPOINT_DIRECTORY_CACHE);
+   checkpoint << _total_entries;
+   for (UInt32 i = 0; i < _total_entries; i++)
+      _directory->getDirectoryEntry(i)->saveState(checkpoint);
+}
+
+void
+DirectoryCache::restoreState(CheckpointReader& checkpoint)
+{
+   LOG_ASSERT_ERROR(_replaced_directory_entry_list.empty(),
+                    "Cannot restore with %u directory evictions in flight", _replaced_directory_entry_list.size());
+
+   checkpoint.checkSection(CHECKPOINT_DIRECTORY_CACHE);
+   UInt32 total_entries;
+   checkpoint >> total_entries;
+   LOG_ASSERT_ERROR(total_entries == _total_entries, "Checkpointed directory has %u entries, this one has %u",
+                    total_entries, _total_entries);
+
+   // The entries track the live cache contents, so they are only compared
+   // against the checkpoint
+   UInt32 num_mismatched_entries = 0;
+   for (UInt32 i = 0; i < _total_entries; i++)
+   {
+      DirectoryEntry* saved_directory_entry = _directory->createDirectoryEntry();
+      saved_directory_entry->restoreState(checkpoint);
+      if (!saved_directory_entry->matches(_directory->getDirectoryEntry(i)))
+         num_mismatched_entries ++;
+      _directory->destroyDirectoryEntry(saved_directory_entry);
+   }
+
+   if (num_mismatched_entries > 0)
+   {
+      LOG_PRINT_WARNING("%u of %u directory entries differ from the checkpoint, keeping the live ones",
+                        num_mismatched_entries, _total_entries);
+   }
+}
+
 void
 DirectoryCache::splitAddress(IntPtr address, IntPtr& tag, UInt32& set_index)
 {
@@ -357,6 +411,8 @@ DirectoryCache::outputSummary(ostream& out)
    out << "    Total Accesses: " << _total_directory_accesses << endl;
    out << "    Total Evictions: " << _total_evictions << endl;
    out << "    Total Back-Invalidations: " << _total_back_invalidations << endl;
+   if (_statistics)
+      _statistics->outputSummary(out);
 
    // The power and area model summary
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -372,6 +428,8 @@ DirectoryCache::dummyOutputSummary(ostream& out, tile_id_t tile_id)
    out << "    Total Accesses: " << endl;
    out << "    Total Evictions: " << endl;
    out << "    Total Back-Invalidations: " << endl;
+   if (DirectoryStatistics::isEnabled())
+      DirectoryStatistics::dummyOutputSummary(out);
 
    // The power and area model summary
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -1,9 +1,7 @@
 #pragma once
 
 #include <string>
-#include <map>
 using std::string;
-using std::map;
 using std::ostream;
 
 #include "tile.h"
@@ -12,8 +10,11 @@ using std::ostream;
 #include "cache_power_model.h"
 #include "cache_area_model.h"
 #include "directory_entry.h"
+#include "directory_statistics.h"
+#include "tag_match.h"
 #include "directory_type.h"
 #include "caching_protocol_type.h"
+#include "checkpoint_stream.h"
 
 class DirectoryCache
 {
@@ -44,15 +45,15 @@ public:
 
    void updateInternalVariablesOnFrequencyChange(float old_frequency, float new_frequency);
 
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
 private:
    Tile* _tile;
    Directory* _directory;
+   // Address of every directory entry, for matching a whole set at once
+   IntPtr* _addresses;
    vector<DirectoryEntry*> _replaced_directory_entry_list;
-   
-   map<IntPtr,UInt64> _address_map;
-   vector<map<IntPtr,UInt64> > _set_specific_address_map;
-   map<IntPtr,UInt64> _replaced_address_map;
-   vector<UInt64> _set_replacement_histogram;
 
    CachingProtocolType _caching_protocol_type;
    DirectoryType _directory_type;
@@ -62,6 +63,7 @@ private:
    string _total_entries_str;
    UInt32 _total_entries;
    UInt32 _associativity;
+   TagMatch _tag_match;
    UInt32 _directory_size; // In bytes
 
    UInt32 _num_sets;
@@ -88,6 +90,9 @@ private:
 
    bool _enabled;
 
+   // NULL unless dram_directory/statistics/enabled is set
+   DirectoryStatistics* _statistics;
+
    // Auto(-matically) determine total number of entries in the directory
    UInt32 computeDirectoryTotalEntries();
    // Get the max L2 cache size (in KB)
@@ -0,0 +1,111 @@
+#include <algorithm>
+
+#include "directory_statistics.h"
+#include "simulator.h"
+#include "config.h"
+#include "log.h"
+
+using namespace std;
+
+DirectoryStatistics::DirectoryStatistics(UInt32 num_sets)
+   : _set_sampling_interval(1)
+   , _address_estimator(NULL)
+   , _evicted_address_estimator(NULL)
+   , _sampled_evictions(0)
+{
+   UInt32 hll_precision = 0;
+   try
+   {
+      _set_sampling_interval = Sim()->getCfg()->getInt("dram_directory/statistics/set_sampling_interval", 32);
+      hll_precision = Sim()->getCfg()->getInt("dram_directory/statistics/hll_precision", 12);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [dram_directory/statistics] parameters from the cfg file");
+   }
+   LOG_ASSERT_ERROR(_set_sampling_interval > 0, "dram_directory/statistics/set_sampling_interval must be non-zero");
+
+   _address_estimator = new HyperLogLog(hll_precision);
+   _evicted_address_estimator = new HyperLogLog(hll_precision);
+
+   _set_accesses.resize(num_sets, 0);
+   _set_evictions.resize(num_sets, 0);
+}
+
+DirectoryStatistics::~DirectoryStatistics()
+{
+   delete _address_estimator;
+   delete _evicted_address_estimator;
+}
+
+bool
+DirectoryStatistics::isEnabled()
+{
+   try
+   {
+      return Sim()->getCfg()->getBool("dram_directory/statistics/enabled", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read dram_directory/statistics/enabled from the cfg file");
+      return false;
+   }
+}
+
+void
+DirectoryStatistics::recordAccess(IntPtr address, UInt32 set_index)
+{
+   _set_accesses[set_index] ++;
+
+   if (isSampled(set_index))
+      _address_estimator->insert(address);
+}
+
+void
+DirectoryStatistics::recordEviction(IntPtr address, UInt32 set_index)
+{
+   _set_evictions[set_index] ++;
+
+   if (isSampled(set_index))
+   {
+      _evicted_address_estimator->insert(address);
+      _sampled_evictions ++;
+   }
+}
+
+void
+DirectoryStatistics::outputSummary(ostream& out)
+{
+   UInt64 max_set_accesses = 0;
+   UInt64 max_set_evictions = 0;
+   UInt32 unused_sets = 0;
+   for (UInt32 i = 0; i < _set_accesses.size(); i++)
+   {
+      max_set_accesses = max<UInt64>(max_set_accesses, _set_accesses[i]);
+      max_set_evictions = max<UInt64>(max_set_evictions, _set_evictions[i]);
+      if (_set_accesses[i] == 0)
+         unused_sets ++;
+   }
+
+   // Every eviction beyond the first of an address is a repeat
+   UInt64 sampled_distinct_evicted_addresses = min<UInt64>(_evicted_address_estimator->estimate(), _sampled_evictions);
+   UInt64 sampled_repeat_evictions = _sampled_evictions - sampled_distinct_evicted_addresses;
+
+   out << "    Distinct Addresses [sampled]: " << _address_estimator->estimate() * _set_sampling_interval << endl;
+   out << "    Distinct Evicted Addresses [sampled]: " << sampled_distinct_evicted_addresses * _set_sampling_interval << endl;
+   out << "    Repeat Evictions [sampled]: " << sampled_repeat_evictions * _set_sampling_interval << endl;
+   out << "    Max Accesses per Set: " << max_set_accesses << endl;
+   out << "    Max Evictions per Set: " << max_set_evictions << endl;
+   out << "    Unused Sets: " << unused_sets << endl;
+}
+
+void
+DirectoryStatistics::dummyOutputSummary(ostream& out)
+{
+   out << "    Distinct Addresses [sampled]: " << endl;
+   out << "    Distinct Evicted Addresses [sampled]: " << endl;
+   out << "    Repeat Evictions [sampled]: " << endl;
+   out << "    Max Accesses per Set: " << endl;
+   out << "    Max Evictions per Set: " << endl;
+   out << "    Unused Sets: " << endl;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+using std::ostream;
+using std::vector;
+
+#include "fixed_types.h"
+#include "hyperloglog.h"
+
+// Address statistics of a DirectoryCache (dram_directory/statistics/enabled)
+//
+// Sets are sampled: only the addresses that map to every
+// 'set_sampling_interval'-th set are tracked, and the counts are scaled back
+// up for the summary. Distinct addresses are counted with HyperLogLog
+// estimators of 2^'hll_precision' registers, whose relative standard error
+// is 1.04 / sqrt(2^'hll_precision') (1.6% for the default of 12) on the
+// sampled sets, on top of the sampling error. The memory used is fixed at
+// construction, and an access costs one register update in a sampled set
+// and nothing in the others. Per-set access and eviction counts are exact.
+class DirectoryStatistics
+{
+public:
+   DirectoryStatistics(UInt32 num_sets);
+   ~DirectoryStatistics();
+
+   static bool isEnabled();
+
+   void recordAccess(IntPtr address, UInt32 set_index);
+   void recordEviction(IntPtr address, UInt32 set_index);
+
+   void outputSummary(ostream& out);
+   static void dummyOutputSummary(ostream& out);
+
+private:
+   UInt32 _set_sampling_interval;
+
+   // Sampled sets
+   HyperLogLog* _address_estimator;
+   HyperLogLog* _evicted_address_estimator;
+   UInt64 _sampled_evictions;
+
+   // All sets
+   vector<UInt64> _set_accesses;
+   vector<UInt64> _set_evictions;
+
+   bool isSampled(UInt32 set_index)
+   { return (set_index % _set_sampling_interval) == 0; }
+};
@@ -0,0 +1,60 @@
+#include "exact_miss_type_tracker.h"
+
+ExactMissTypeTracker::ExactMissTypeTracker()
+{}
+
+ExactMissTypeTracker::~ExactMissTypeTracker()
+{}
+
+void
+ExactMissTypeTracker::recordFetch(IntPtr address)
+{
+   // Clear the miss type tracking sets for this address
+   if (_evicted_address_set.erase(address));
+   else if (_invalidated_address_set.erase(address));
+   else if (_fetched_address_set.erase(address));
+
+   _fetched_address_set.insert(address);
+}
+
+void
+ExactMissTypeTracker::recordEviction(IntPtr address)
+{
+   _evicted_address_set.insert(address);
+}
+
+void
+ExactMissTypeTracker::recordInvalidation(IntPtr address)
+{
+   _invalidated_address_set.insert(address);
+}
+
+Cache::MissType
+ExactMissTypeTracker::getMissType(IntPtr address) const
+{
+   // We maintain three address sets to keep track of miss types
+   if (_evicted_address_set.find(address) != _evicted_address_set.end())
+      return Cache::CAPACITY_MISS;
+   else if (_invalidated_address_set.find(address) != _invalidated_address_set.end())
+      return Cache::SHARING_MISS;
+   else if (_fetched_address_set.find(address) != _fetched_address_set.end())
+      return Cache::SHARING_MISS;
+   else
+      return Cache::COLD_MISS;
+}
+
+void
+ExactMissTypeTracker::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.put(_fetched_address_set);
+   checkpoint.put(_evicted_address_set);
+   checkpoint.put(_invalidated_address_set);
+}
+
+void
+ExactMissTypeTracker::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.get(_fetched_address_set);
+   checkpoint.get(_evicted_address_set);
+   checkpoint.get(_invalidated_address_set);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <set>
+using std::set;
+
+#include "miss_type_tracker.h"
+
+// Keeps every fetched, evicted and invalidated address
+class ExactMissTypeTracker : public MissTypeTracker
+{
+public:
+   ExactMissTypeTracker();
+   ~ExactMissTypeTracker();
+
+   Type getType() const { return EXACT; }
+
+   void recordFetch(IntPtr address);
+   void recordEviction(IntPtr address);
+   void recordInvalidation(IntPtr address);
+   Cache::MissType getMissType(IntPtr address) const;
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
+private:
+   set<IntPtr> _fetched_address_set;
+   set<IntPtr> _evicted_address_set;
+   set<IntPtr> _invalidated_address_set;
+};
@@ -0,0 +1,234 @@
+#include <cmath>
+#include <algorithm>
+
+#include "hashed_miss_type_tracker.h"
+#include "simulator.h"
+#include "log.h"
+
+HashedMissTypeTracker::HashedMissTypeTracker(UInt32 num_cache_lines, UInt64 expected_footprint_lines,
+                                             double false_positive_rate,
+                                             UInt32 history_entries_per_line, UInt32 history_associativity)
+   : _filter_bits(0)
+   , _num_hash_functions(0)
+   , _expected_lines(std::max<UInt64>(expected_footprint_lines, num_cache_lines))
+   , _num_fetched_lines(0)
+{
+   LOG_ASSERT_ERROR(false_positive_rate > 0.0 && false_positive_rate < 1.0,
+                    "Bloom filter false positive rate(%g) must be between 0 and 1", false_positive_rate);
+   LOG_ASSERT_ERROR(history_entries_per_line > 0 && history_associativity > 0,
+                    "History entries per line(%u) and history associativity(%u) must be non-zero",
+                    history_entries_per_line, history_associativity);
+
+   // Optimal bloom filter for the expected number of lines:
+   // m = -n * ln(p) / ln(2)^2 bits and k = log2(1/p) hash functions
+   double bits_per_line = -log(false_positive_rate) / (M_LN2 * M_LN2);
+   _filter_bits = (((UInt64) ceil(_expected_lines * bits_per_line) + 63) / 64) * 64;
+   _num_hash_functions = std::max<UInt32>(1, (UInt32) (-log(false_positive_rate) / M_LN2 + 0.5));
+   _fetched_filter.resize(_filter_bits / 64, 0);
+
+   UInt32 num_history_sets = (num_cache_lines * history_entries_per_line + history_associativity - 1) / history_associativity;
+   _evicted_table.resize(num_history_sets, history_associativity);
+   _invalidated_table.resize(num_history_sets, history_associativity);
+}
+
+HashedMissTypeTracker*
+HashedMissTypeTracker::create(UInt32 num_cache_lines, UInt32 line_size)
+{
+   UInt32 expected_footprint = 0;
+   double false_positive_rate = 0.0;
+   UInt32 history_entries_per_line = 0;
+   UInt32 history_associativity = 0;
+   try
+   {
+      expected_footprint = Sim()->getCfg()->getInt("miss_type_tracking/expected_footprint", 64);
+      false_positive_rate = Sim()->getCfg()->getFloat("miss_type_tracking/false_positive_rate", 0.01);
+      history_entries_per_line = Sim()->getCfg()->getInt("miss_type_tracking/history_entries_per_line", 4);
+      history_associativity = Sim()->getCfg()->getInt("miss_type_tracking/history_associativity", 4);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [miss_type_tracking] parameters from the cfg file");
+   }
+
+   UInt64 expected_footprint_lines = ((UInt64) expected_footprint << 20) / line_size;
+   return new HashedMissTypeTracker(num_cache_lines, expected_footprint_lines, false_positive_rate,
+                                    history_entries_per_line, history_associativity);
+}
+
+HashedMissTypeTracker::~HashedMissTypeTracker()
+{}
+
+void
+HashedMissTypeTracker::recordFetch(IntPtr address)
+{
+   // Clear the miss type tracking tables for this address
+   if (!_evicted_table.erase(address))
+      _invalidated_table.erase(address);
+
+   // Double hashing: the k bit positions are h1 + i*h2
+   UInt64 h = hash(address);
+   UInt64 h1 = h & 0xffffffff;
+   UInt64 h2 = (h >> 32) | 1;
+   bool new_line = false;
+   for (UInt32 i = 0; i < _num_hash_functions; i++)
+   {
+      UInt64 bit = (h1 + i * h2) % _filter_bits;
+      UInt64 mask = 1ULL << (bit & 63);
+      if (!(_fetched_filter[bit >> 6] & mask))
+      {
+         _fetched_filter[bit >> 6] |= mask;
+         new_line = true;
+      }
+   }
+
+   if (new_line)
+   {
+      _num_fetched_lines ++;
+      if (_num_fetched_lines == _expected_lines + 1)
+      {
+         LOG_PRINT_WARNING("Miss type tracking has seen more than the %llu lines of miss_type_tracking/expected_footprint, "
+                           "cold misses will increasingly be counted as sharing misses", _expected_lines);
+      }
+   }
+}
+
+void
+HashedMissTypeTracker::recordEviction(IntPtr address)
+{
+   _evicted_table.insert(address);
+}
+
+void
+HashedMissTypeTracker::recordInvalidation(IntPtr address)
+{
+   _invalidated_table.insert(address);
+}
+
+Cache::MissType
+HashedMissTypeTracker::getMissType(IntPtr address) const
+{
+   if (_evicted_table.contains(address))
+      return Cache::CAPACITY_MISS;
+   else if (_invalidated_table.contains(address))
+      return Cache::SHARING_MISS;
+
+   UInt64 h = hash(address);
+   UInt64 h1 = h & 0xffffffff;
+   UInt64 h2 = (h >> 32) | 1;
+   for (UInt32 i = 0; i < _num_hash_functions; i++)
+   {
+      UInt64 bit = (h1 + i * h2) % _filter_bits;
+      if (!((_fetched_filter[bit >> 6] >> (bit & 63)) & 1))
+         return Cache::COLD_MISS;
+   }
+   return Cache::SHARING_MISS;
+}
+
+void
+HashedMissTypeTracker::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint << _filter_bits << _num_hash_functions << _expected_lines << _num_fetched_lines;
+   checkpoint.put(_fetched_filter);
+   _evicted_table.saveState(checkpoint);
+   _invalidated_table.saveState(checkpoint);
+}
+
+void
+HashedMissTypeTracker::restoreState(CheckpointReader& checkpoint)
+{
+   // The checkpointed sizes replace the configured ones
+   checkpoint >> _filter_bits >> _num_hash_functions >> _expected_lines >> _num_fetched_lines;
+   checkpoint.get(_fetched_filter);
+   _evicted_table.restoreState(checkpoint);
+   _invalidated_table.restoreState(checkpoint);
+}
+
+UInt64
+HashedMissTypeTracker::hash(IntPtr address)
+{
+   // 64-bit finalizer of MurmurHash3
+   UInt64 h = (UInt64) address;
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return h;
+}
+
+// -- HashedMissTypeTracker::AddressTable -- //
+
+void
+HashedMissTypeTracker::AddressTable::resize(UInt32 num_sets, UInt32 associativity)
+{
+   _num_sets = num_sets;
+   _associativity = associativity;
+   _addresses.assign(num_sets * associativity, INVALID_ADDRESS);
+   _next_way.assign(num_sets, 0);
+}
+
+UInt32
+HashedMissTypeTracker::AddressTable::find(IntPtr address) const
+{
+   UInt32 first = (hash(address) % _num_sets) * _associativity;
+   for (UInt32 i = first; i < first + _associativity; i++)
+   {
+      if (_addresses[i] == address)
+         return i;
+   }
+   return _addresses.size();
+}
+
+void
+HashedMissTypeTracker::AddressTable::insert(IntPtr address)
+{
+   if (find(address) != _addresses.size())
+      return;
+
+   // Entries erased on a refetch are reused before replacing the oldest one
+   UInt32 set_num = hash(address) % _num_sets;
+   UInt32 first = set_num * _associativity;
+   for (UInt32 i = first; i < first + _associativity; i++)
+   {
+      if (_addresses[i] == INVALID_ADDRESS)
+      {
+         _addresses[i] = address;
+         return;
+      }
+   }
+   _addresses[first + _next_way[set_num]] = address;
+   _next_way[set_num] = (_next_way[set_num] + 1) % _associativity;
+}
+
+bool
+HashedMissTypeTracker::AddressTable::erase(IntPtr address)
+{
+   UInt32 index = find(address);
+   if (index == _addresses.size())
+      return false;
+
+   _addresses[index] = INVALID_ADDRESS;
+   return true;
+}
+
+bool
+HashedMissTypeTracker::AddressTable::contains(IntPtr address) const
+{
+   return (find(address) != _addresses.size());
+}
+
+void
+HashedMissTypeTracker::AddressTable::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint << _num_sets << _associativity;
+   checkpoint.put(_addresses);
+   checkpoint.put(_next_way);
+}
+
+void
+HashedMissTypeTracker::AddressTable::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint >> _num_sets >> _associativity;
+   checkpoint.get(_addresses);
+   checkpoint.get(_next_way);
+}
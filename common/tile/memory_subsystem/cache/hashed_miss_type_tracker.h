@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "miss_type_tracker.h"
+
+// Tracks miss types in a fixed amount of memory
+//
+// Fetched addresses go in a bloom filter sized for 'expected_footprint' MB of
+// distinct lines (or the cache size, if larger) at a 'false_positive_rate',
+// and evicted and invalidated addresses in tables of
+// 'history_entries_per_line' entries per cache line that are
+// 'history_associativity'-way set associative and FIFO replaced (entries
+// erased when their line is fetched again are reused first).
+//
+// Error bounds:
+// - A cold miss is counted as a sharing miss if the bloom filter reports a
+//   false positive, which happens with probability (1 - e^(-k*n/m))^k for
+//   n distinct fetched lines, k hash functions and m bits. This stays below
+//   'false_positive_rate' while n is within the expected footprint, and
+//   grows quickly beyond it (to about 16% at twice the footprint with the
+//   default rate of 1%), so a warning is printed once the filter holds more
+//   lines than it was sized for
+// - A capacity miss is counted as a sharing miss once 'history_associativity'
+//   later evictions have mapped to the same table set. The tables keep full
+//   addresses, so misses are never counted as capacity misses by mistake
+// Hence the cold and capacity miss counts are lower bounds and the sharing
+// miss count is an upper bound
+class HashedMissTypeTracker : public MissTypeTracker
+{
+public:
+   HashedMissTypeTracker(UInt32 num_cache_lines, UInt64 expected_footprint_lines, double false_positive_rate,
+                         UInt32 history_entries_per_line, UInt32 history_associativity);
+   ~HashedMissTypeTracker();
+
+   // Sized from [miss_type_tracking]
+   static HashedMissTypeTracker* create(UInt32 num_cache_lines, UInt32 line_size);
+
+   Type getType() const { return HASHED; }
+
+   void recordFetch(IntPtr address);
+   void recordEviction(IntPtr address);
+   void recordInvalidation(IntPtr address);
+   Cache::MissType getMissType(IntPtr address) const;
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
+private:
+   // Set associative table of addresses with FIFO replacement of valid entries
+   class AddressTable
+   {
+   public:
+      void resize(UInt32 num_sets, UInt32 associativity);
+      void insert(IntPtr address);
+      bool erase(IntPtr address);
+      bool contains(IntPtr address) const;
+
+      void saveState(CheckpointWriter& checkpoint);
+      void restoreState(CheckpointReader& checkpoint);
+
+   private:
+      UInt32 _num_sets;
+      UInt32 _associativity;
+      vector<IntPtr> _addresses;
+      vector<UInt32> _next_way;
+
+      UInt32 find(IntPtr address) const;
+   };
+
+   // Bloom filter of fetched addresses
+   vector<UInt64> _fetched_filter;
+   UInt64 _filter_bits;
+   UInt32 _num_hash_functions;
+   // Lines the filter was sized for, and lines that set new bits in it
+   UInt64 _expected_lines;
+   UInt64 _num_fetched_lines;
+
+   AddressTable _evicted_table;
+   AddressTable _invalidated_table;
+
+   static UInt64 hash(IntPtr address);
+};
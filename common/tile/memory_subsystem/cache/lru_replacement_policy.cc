@@ -5,11 +5,10 @@
 LRUReplacementPolicy::LRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
    : CacheReplacementPolicy(cache_size, associativity, cache_line_size)
 {
-   _lru_bits_vec.resize(_num_sets);
+   _lru_bits_vec.resize(_num_sets * _associativity);
    for (UInt32 set_num = 0; set_num < _num_sets; set_num ++)
    {
-      vector<UInt8>& lru_bits = _lru_bits_vec[set_num];
-      lru_bits.resize(_associativity);
+      UInt8* lru_bits = &_lru_bits_vec[set_num * _associativity];
       for (UInt32 way_num = 0; way_num < _associativity; way_num ++)
       {
          lru_bits[way_num] = way_num;
@@ -23,7 +22,7 @@ LRUReplacementPolicy::~LRUReplacementPolicy()
 UInt32 
 LRUReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
 {
-   const vector<UInt8>& lru_bits = _lru_bits_vec[set_num];
+   const UInt8* lru_bits = &_lru_bits_vec[set_num * _associativity];
    // Invalidations may mess up the LRU bits
    UInt32 way = _associativity;
    for (UInt32 i = 0; i < _associativity; i++)
@@ -40,7 +39,7 @@ LRUReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, U
 void
 LRUReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way)
 {
-   vector<UInt8>& lru_bits = _lru_bits_vec[set_num];
+   UInt8* lru_bits = &_lru_bits_vec[set_num * _associativity];
    for (UInt32 i = 0; i < _associativity; i++)
    {
       if (lru_bits[i] < lru_bits[accessed_way])
@@ -48,3 +47,18 @@ LRUReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_n
    }
    lru_bits[accessed_way] = 0;
 }
+
+void
+LRUReplacementPolicy::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.put(_lru_bits_vec);
+}
+
+void
+LRUReplacementPolicy::restoreState(CheckpointReader& checkpoint)
+{
+   __attribute(__unused__) size_t size = _lru_bits_vec.size();
+   checkpoint.get(_lru_bits_vec);
+   LOG_ASSERT_ERROR(_lru_bits_vec.size() == size, "Checkpointed replacement state has %zu entries, expected %zu",
+                    _lru_bits_vec.size(), size);
+}
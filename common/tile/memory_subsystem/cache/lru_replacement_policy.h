@@ -13,7 +13,11 @@ public:
 
    UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
    void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
   
 private: 
-   vector<vector<UInt8> > _lru_bits_vec;
+   // LRU ages for all sets, indexed by (set_num * associativity + way)
+   vector<UInt8> _lru_bits_vec;
 };
@@ -0,0 +1,45 @@
+#include "miss_type_tracker.h"
+#include "exact_miss_type_tracker.h"
+#include "hashed_miss_type_tracker.h"
+#include "log.h"
+
+MissTypeTracker::MissTypeTracker()
+{}
+
+MissTypeTracker::~MissTypeTracker()
+{}
+
+MissTypeTracker*
+MissTypeTracker::create(string engine_str, UInt32 num_cache_lines, UInt32 line_size)
+{
+   return create(parse(engine_str), num_cache_lines, line_size);
+}
+
+MissTypeTracker*
+MissTypeTracker::create(Type engine, UInt32 num_cache_lines, UInt32 line_size)
+{
+   switch (engine)
+   {
+   case EXACT:
+      return new ExactMissTypeTracker();
+   case HASHED:
+      return HashedMissTypeTracker::create(num_cache_lines, line_size);
+   default:
+      LOG_PRINT_ERROR("Unrecognized Miss Type Tracking Engine(%u)", engine);
+      return (MissTypeTracker*) NULL;
+   }
+}
+
+MissTypeTracker::Type
+MissTypeTracker::parse(string engine_str)
+{
+   if (engine_str == "exact")
+      return EXACT;
+   if (engine_str == "hashed")
+      return HASHED;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Miss Type Tracking Engine(%s)", engine_str.c_str());
+      return NUM_TYPES;
+   }
+}
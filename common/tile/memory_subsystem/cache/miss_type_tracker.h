@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+using std::string;
+
+#include "cache.h"
+#include "fixed_types.h"
+#include "checkpoint_stream.h"
+
+// Remembers which addresses a cache has fetched, evicted and invalidated,
+// to classify its misses as cold, capacity or sharing misses
+// (track_miss_types). The engine is set by [miss_type_tracking] engine
+class MissTypeTracker
+{
+public:
+   enum Type
+   {
+      EXACT = 0,
+      HASHED,
+      NUM_TYPES
+   };
+
+   MissTypeTracker();
+   virtual ~MissTypeTracker();
+
+   static MissTypeTracker* create(string engine_str, UInt32 num_cache_lines, UInt32 line_size);
+   static MissTypeTracker* create(Type engine, UInt32 num_cache_lines, UInt32 line_size);
+   static Type parse(string engine_str);
+
+   virtual Type getType() const = 0;
+
+   virtual void recordFetch(IntPtr address) = 0;
+   virtual void recordEviction(IntPtr address) = 0;
+   virtual void recordInvalidation(IntPtr address) = 0;
+   virtual Cache::MissType getMissType(IntPtr address) const = 0;
+
+   virtual void saveState(CheckpointWriter& checkpoint) = 0;
+   virtual void restoreState(CheckpointReader& checkpoint) = 0;
+};
@@ -0,0 +1,75 @@
+#include "packed_lru_replacement_policy.h"
+#include "cache_line_info.h"
+#include "log.h"
+
+static const UInt64 NIBBLE_ONES = 0x1111111111111111ULL;
+static const UInt64 NIBBLE_HIGH_BITS = 0x8888888888888888ULL;
+
+PackedLRUReplacementPolicy::PackedLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : CacheReplacementPolicy(cache_size, associativity, cache_line_size)
+{
+   LOG_ASSERT_ERROR(_associativity <= 16, "Packed LRU supports associativity <= 16, got(%u)", _associativity);
+
+   // Same initial order as LRUReplacementPolicy: way 'i' at position 'i'
+   UInt64 lru_stack = 0;
+   for (UInt32 way_num = 0; way_num < _associativity; way_num ++)
+      lru_stack |= ((UInt64) way_num) << (4 * way_num);
+   _lru_stack_vec.resize(_num_sets, lru_stack);
+   _valid_ways_vec.resize(_num_sets, 0);
+   _all_ways_valid = (UInt16) ((1U << _associativity) - 1);
+}
+
+PackedLRUReplacementPolicy::~PackedLRUReplacementPolicy()
+{}
+
+UInt32 
+PackedLRUReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   // Fill invalid ways first, lowest way first
+   UInt16 valid_ways = _valid_ways_vec[set_num];
+   if (valid_ways != _all_ways_valid)
+      return __builtin_ctz(~((UInt32) valid_ways));
+   return (_lru_stack_vec[set_num] >> (4 * (_associativity-1))) & 0xf;
+}
+
+void
+PackedLRUReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way)
+{
+   _valid_ways_vec[set_num] |= (UInt16) (1U << accessed_way);
+
+   UInt64& lru_stack = _lru_stack_vec[set_num];
+
+   // Locate the accessed way: the lowest zero nibble of (stack ^ way)
+   // Unused positions above the associativity are never reached since every way is in the stack
+   UInt64 diff = lru_stack ^ (NIBBLE_ONES * accessed_way);
+   UInt64 zero_nibbles = (diff - NIBBLE_ONES) & ~diff & NIBBLE_HIGH_BITS;
+   UInt32 position = __builtin_ctzll(zero_nibbles) / 4;
+   assert(position < _associativity);
+
+   // Shift the more recently used ways down one position and put the accessed way on top
+   UInt64 younger_mask = (((UInt64) 1) << (4 * position)) - 1;
+   UInt64 older_mask = (position == 15) ? 0 : ~((((UInt64) 1) << (4 * (position+1))) - 1);
+   lru_stack = (lru_stack & older_mask) | ((lru_stack & younger_mask) << 4) | accessed_way;
+}
+
+void
+PackedLRUReplacementPolicy::invalidate(UInt32 set_num, UInt32 way)
+{
+   _valid_ways_vec[set_num] &= (UInt16) ~(1U << way);
+}
+
+void
+PackedLRUReplacementPolicy::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.put(_lru_stack_vec);
+}
+
+void
+PackedLRUReplacementPolicy::restoreState(CheckpointReader& checkpoint)
+{
+   __attribute(__unused__) size_t size = _lru_stack_vec.size();
+   checkpoint.get(_lru_stack_vec);
+   LOG_ASSERT_ERROR(_lru_stack_vec.size() == size,
+                    "Checkpointed replacement state has %zu entries, expected %zu",
+                    _lru_stack_vec.size(), size);
+}
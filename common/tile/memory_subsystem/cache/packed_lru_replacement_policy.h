@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "cache_replacement_policy.h"
+
+// True LRU with the recency stack of a set packed into one 64-bit word:
+// 4 bits per position, position 0 is the MRU way and position (associativity-1) the LRU way
+class PackedLRUReplacementPolicy : public CacheReplacementPolicy
+{
+public:
+   PackedLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~PackedLRUReplacementPolicy();
+
+   UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+   void invalidate(UInt32 set_num, UInt32 way);
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+  
+private: 
+   vector<UInt64> _lru_stack_vec;
+   // Bit 'w' is set while way 'w' holds a valid line
+   vector<UInt16> _valid_ways_vec;
+   UInt16 _all_ways_valid;
+};
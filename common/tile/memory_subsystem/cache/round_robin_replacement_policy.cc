@@ -25,3 +25,18 @@ RoundRobinReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt3
 {
    return;
 }
+
+void
+RoundRobinReplacementPolicy::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.put(_replacement_index_vec);
+}
+
+void
+RoundRobinReplacementPolicy::restoreState(CheckpointReader& checkpoint)
+{
+   __attribute(__unused__) size_t size = _replacement_index_vec.size();
+   checkpoint.get(_replacement_index_vec);
+   LOG_ASSERT_ERROR(_replacement_index_vec.size() == size, "Checkpointed replacement state has %zu entries, expected %zu",
+                    _replacement_index_vec.size(), size);
+}
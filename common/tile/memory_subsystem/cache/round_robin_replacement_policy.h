@@ -13,6 +13,9 @@ public:
 
    UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
    void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
   
 private: 
    vector<UInt32> _replacement_index_vec;
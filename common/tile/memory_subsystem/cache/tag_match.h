@@ -0,0 +1,108 @@
+#pragma once
+
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define VECTOR_TAG_MATCH
+#endif
+
+#include "fixed_types.h"
+
+// Finds a tag in one set of a contiguous tag array (indexed by way)
+// Sets of 4, 8 or 16 ways compare all their tags at once with SSE2; the others
+// are scanned. Invalid ways hold the tag ~0, which is never a real tag, so
+// a compare alone also acts as the valid-way mask, and looking up ~0 finds
+// the invalid ways.
+class TagMatch
+{
+public:
+   // Bit i of the result is set if tags[i] == tag
+   typedef UInt32 (*MatchMaskFn)(const IntPtr* tags, IntPtr tag);
+
+   TagMatch(UInt32 associativity)
+      : _associativity(associativity)
+      , _match_mask_fn(getVectorMatchMaskFn(associativity))
+   {}
+
+   // Highest (lowest) way holding 'tag', or -1
+   SInt32 findHighest(const IntPtr* tags, IntPtr tag) const
+   {
+      if (_match_mask_fn)
+      {
+         UInt32 match_mask = _match_mask_fn(tags, tag);
+         return (match_mask == 0) ? -1 : (31 - __builtin_clz(match_mask));
+      }
+      for (SInt32 way = _associativity-1; way >= 0; way--)
+      {
+         if (tags[way] == tag)
+            return way;
+      }
+      return -1;
+   }
+
+   SInt32 findLowest(const IntPtr* tags, IntPtr tag) const
+   {
+      if (_match_mask_fn)
+      {
+         UInt32 match_mask = _match_mask_fn(tags, tag);
+         return (match_mask == 0) ? -1 : __builtin_ctz(match_mask);
+      }
+      for (UInt32 way = 0; way < _associativity; way++)
+      {
+         if (tags[way] == tag)
+            return way;
+      }
+      return -1;
+   }
+
+   static UInt32 scalarMatchMask(const IntPtr* tags, UInt32 associativity, IntPtr tag)
+   {
+      UInt32 match_mask = 0;
+      for (UInt32 way = 0; way < associativity; way++)
+      {
+         if (tags[way] == tag)
+            match_mask |= (1U << way);
+      }
+      return match_mask;
+   }
+
+#ifdef VECTOR_TAG_MATCH
+   template <UInt32 ASSOCIATIVITY>
+   static UInt32 vectorMatchMask(const IntPtr* tags, IntPtr tag)
+   {
+      // SSE2 has no 64-bit compare: AND the two 32-bit halves of each compare result
+      UInt32 match_mask = 0;
+      __m128i key = _mm_set1_epi64x(tag);
+      for (UInt32 i = 0; i < ASSOCIATIVITY; i += 2)
+      {
+         __m128i way_tags = _mm_loadu_si128((const __m128i*) &tags[i]);
+         __m128i eq32 = _mm_cmpeq_epi32(way_tags, key);
+         __m128i eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2,3,0,1)));
+         match_mask |= ((UInt32) _mm_movemask_pd(_mm_castsi128_pd(eq))) << i;
+      }
+      return match_mask;
+   }
+#endif
+
+   // NULL if sets of 'associativity' ways are scanned
+   static MatchMaskFn getVectorMatchMaskFn(UInt32 associativity)
+   {
+#ifdef VECTOR_TAG_MATCH
+      switch (associativity)
+      {
+      case 4:
+         return vectorMatchMask<4>;
+      case 8:
+         return vectorMatchMask<8>;
+      case 16:
+         return vectorMatchMask<16>;
+      default:
+         break;
+      }
+#endif
+      return NULL;
+   }
+
+private:
+   UInt32 _associativity;
+   MatchMaskFn _match_mask_fn;
+};
@@ -0,0 +1,80 @@
+#include "tree_plru_replacement_policy.h"
+#include "cache_line_info.h"
+#include "utils.h"
+#include "log.h"
+
+TreePLRUReplacementPolicy::TreePLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size)
+   : CacheReplacementPolicy(cache_size, associativity, cache_line_size)
+{
+   LOG_ASSERT_ERROR(isPower2(_associativity) && (_associativity <= 32),
+                    "Tree PLRU needs a power-of-2 associativity <= 32, got(%u)", _associativity);
+   _log_associativity = floorLog2(_associativity);
+   _plru_bits_vec.resize(_num_sets, 0);
+   _valid_ways_vec.resize(_num_sets, 0);
+   _all_ways_valid = (_associativity == 32) ? ~0U : ((1U << _associativity) - 1);
+}
+
+TreePLRUReplacementPolicy::~TreePLRUReplacementPolicy()
+{}
+
+UInt32
+TreePLRUReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num)
+{
+   // Fill invalid ways first, lowest way first
+   UInt32 valid_ways = _valid_ways_vec[set_num];
+   if (valid_ways != _all_ways_valid)
+      return __builtin_ctz(~valid_ways);
+
+   // Follow the tree bits from the root down to a leaf
+   UInt32 plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = 1;
+   UInt32 way = 0;
+   for (UInt32 level = 0; level < _log_associativity; level++)
+   {
+      UInt32 direction = (plru_bits >> node) & 1;
+      way = (way << 1) | direction;
+      node = (node << 1) | direction;
+   }
+   return way;
+}
+
+void
+TreePLRUReplacementPolicy::update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way)
+{
+   // Point every node on the path to the accessed way towards the other half
+   _valid_ways_vec[set_num] |= (1U << accessed_way);
+
+   UInt32& plru_bits = _plru_bits_vec[set_num];
+   UInt32 node = 1;
+   for (SInt32 level = _log_associativity-1; level >= 0; level--)
+   {
+      UInt32 direction = (accessed_way >> level) & 1;
+      if (direction)
+         plru_bits &= ~(1U << node);
+      else
+         plru_bits |= (1U << node);
+      node = (node << 1) | direction;
+   }
+}
+
+void
+TreePLRUReplacementPolicy::invalidate(UInt32 set_num, UInt32 way)
+{
+   _valid_ways_vec[set_num] &= ~(1U << way);
+}
+
+void
+TreePLRUReplacementPolicy::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.put(_plru_bits_vec);
+}
+
+void
+TreePLRUReplacementPolicy::restoreState(CheckpointReader& checkpoint)
+{
+   __attribute(__unused__) size_t size = _plru_bits_vec.size();
+   checkpoint.get(_plru_bits_vec);
+   LOG_ASSERT_ERROR(_plru_bits_vec.size() == size,
+                    "Checkpointed replacement state has %zu entries, expected %zu",
+                    _plru_bits_vec.size(), size);
+}
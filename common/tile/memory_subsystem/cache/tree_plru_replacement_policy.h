@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "cache_replacement_policy.h"
+
+// Tree pseudo-LRU: (associativity-1) bits per set arranged as a binary tree
+// Each bit points towards the half of the set to be replaced next
+class TreePLRUReplacementPolicy : public CacheReplacementPolicy
+{
+public:
+   TreePLRUReplacementPolicy(UInt32 cache_size, UInt32 associativity, UInt32 cache_line_size);
+   ~TreePLRUReplacementPolicy();
+
+   UInt32 getReplacementWay(CacheLineInfo** cache_line_info_array, UInt32 set_num);
+   void update(CacheLineInfo** cache_line_info_array, UInt32 set_num, UInt32 accessed_way);
+   void invalidate(UInt32 set_num, UInt32 way);
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+  
+private: 
+   // Tree nodes are numbered from 1 (root); node 'n' has children '2n' and '2n+1'
+   vector<UInt32> _plru_bits_vec;
+   // Bit 'w' is set while way 'w' holds a valid line
+   vector<UInt32> _valid_ways_vec;
+   UInt32 _all_ways_valid;
+   UInt32 _log_associativity;
+};
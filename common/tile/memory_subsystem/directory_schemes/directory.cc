@@ -7,14 +7,19 @@ Directory::Directory(CachingProtocolType caching_protocol_type, DirectoryType di
                      SInt32 total_entries, SInt32 max_hw_sharers, SInt32 max_num_sharers)
    : _total_entries(total_entries)
    , _directory_type(directory_type)
+   , _max_hw_sharers(max_hw_sharers)
+   , _max_num_sharers(max_num_sharers)
 {
+   _entry_size = DirectoryEntry::getObjectSize(_directory_type);
+   _storage_words = DirectoryEntry::getStorageWords(_directory_type, _max_hw_sharers, _max_num_sharers);
+
    // Look at the type of directory and create 
+   allocateSlab(_total_entries);
    _directory_entry_list.resize(_total_entries);
   
    for (SInt32 i = 0; i < _total_entries; i++)
    {
-      _directory_entry_list[i] = DirectoryEntry::create(caching_protocol_type, _directory_type,
-                                                        max_hw_sharers, max_num_sharers);
+      _directory_entry_list[i] = createDirectoryEntry();
    }
 
    if (_directory_type == FULL_MAP)
@@ -28,10 +33,54 @@ Directory::~Directory()
 {
    for (SInt32 i = 0; i < _total_entries; i++)
    {
-      delete _directory_entry_list[i];
+      destroyDirectoryEntry(_directory_entry_list[i]);
+   }
+   for (UInt32 i = 0; i < _entry_slabs.size(); i++)
+   {
+      delete [] _entry_slabs[i];
+      delete [] _storage_slabs[i];
+   }
+}
+
+void
+Directory::allocateSlab(UInt32 num_entries)
+{
+   char* entry_slab = new char[num_entries * _entry_size];
+   UInt64* storage_slab = new UInt64[num_entries * _storage_words];
+   _entry_slabs.push_back(entry_slab);
+   _storage_slabs.push_back(storage_slab);
+
+   // Handed out lowest address first
+   for (SInt32 i = num_entries - 1; i >= 0; i--)
+   {
+      Slot slot;
+      slot._memory = entry_slab + i * _entry_size;
+      slot._storage = storage_slab + i * _storage_words;
+      _free_slots.push_back(slot);
    }
 }
 
+DirectoryEntry*
+Directory::createDirectoryEntry()
+{
+   if (_free_slots.empty())
+      allocateSlab(SLAB_GROWTH);
+
+   Slot slot = _free_slots.back();
+   _free_slots.pop_back();
+   return DirectoryEntry::create(_directory_type, _max_hw_sharers, _max_num_sharers, slot._memory, slot._storage);
+}
+
+void
+Directory::destroyDirectoryEntry(DirectoryEntry* directory_entry)
+{
+   Slot slot;
+   slot._memory = (char*) dynamic_cast<void*>(directory_entry);
+   slot._storage = directory_entry->getStorage();
+   directory_entry->~DirectoryEntry();
+   _free_slots.push_back(slot);
+}
+
 DirectoryEntry*
 Directory::getDirectoryEntry(SInt32 entry_num)
 {
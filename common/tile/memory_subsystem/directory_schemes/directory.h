@@ -21,17 +21,41 @@ public:
 
    DirectoryEntry* getDirectoryEntry(SInt32 entry_num);
    void setDirectoryEntry(SInt32 entry_num, DirectoryEntry* directory_entry);
+
+   // Entries come from a pool of contiguous slabs that holds the entries
+   // together with their sharers. Entries replaced in a slot stay allocated
+   // until their invalidation completes, so the pool grows past
+   // total_entries if needed
+   DirectoryEntry* createDirectoryEntry();
+   void destroyDirectoryEntry(DirectoryEntry* directory_entry);
    
    // Sharer Stats
    void updateSharerStats(SInt32 old_sharer_count, SInt32 new_sharer_count);
    void getSharerStats(vector<UInt64>& sharer_count_vec);
 
 private:
+   struct Slot
+   {
+      char* _memory;
+      UInt64* _storage;
+   };
+
    SInt32 _total_entries;
    DirectoryType _directory_type;
+   SInt32 _max_hw_sharers;
+   SInt32 _max_num_sharers;
+
+   // Entry pool
+   UInt32 _entry_size;
+   UInt32 _storage_words;
+   vector<char*> _entry_slabs;
+   vector<UInt64*> _storage_slabs;
+   vector<Slot> _free_slots;
+   static const UInt32 SLAB_GROWTH = 64;
 
    vector<DirectoryEntry*> _directory_entry_list;
    vector<UInt64> _sharer_count_vec;
    
    void initializeSharerStats();
+   void allocateSlab(UInt32 num_entries);
 };
@@ -1,3 +1,6 @@
+#include <new>
+#include <algorithm>
+
 #include "directory_type.h"
 #include "directory_entry.h"
 #include "directory_entry_full_map.h"
@@ -5,20 +8,26 @@
 #include "directory_entry_limited_no_broadcast.h"
 #include "directory_entry_ackwise.h"
 #include "directory_entry_limitless.h"
+#include "sharer_bitset.h"
 #include "utils.h"
 #include "log.h"
 
-DirectoryEntry::DirectoryEntry(SInt32 max_hw_sharers)
+DirectoryEntry::DirectoryEntry(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
    : _address(INVALID_ADDRESS)
    , _owner_id(INVALID_TILE_ID)
    , _max_hw_sharers(max_hw_sharers)
+   , _directory_type(directory_type)
+   , _storage(storage)
+   , _owns_storage(storage == NULL)
 {
-   _directory_block_info = new DirectoryBlockInfo();
+   if (_owns_storage)
+      _storage = new UInt64[getStorageWords(directory_type, max_hw_sharers, max_num_sharers)];
 }
 
 DirectoryEntry::~DirectoryEntry()
 {
-   delete _directory_block_info;
+   if (_owns_storage)
+      delete [] _storage;
 }
 
 DirectoryType
@@ -39,31 +48,42 @@ DirectoryEntry::parseDirectoryType(string directory_type)
    return (DirectoryType) -1;
 }
 
+template <class Entry>
+static DirectoryEntry*
+constructEntry(SInt32 max_hw_sharers, SInt32 max_num_sharers, void* memory, UInt64* storage)
+{
+   if (memory)
+      return new (memory) Entry(max_hw_sharers, max_num_sharers, storage);
+   else
+      return new Entry(max_hw_sharers, max_num_sharers, storage);
+}
+
 DirectoryEntry*
 DirectoryEntry::create(CachingProtocolType caching_protocol_type, DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers)
 {
-   return create(directory_type, max_hw_sharers, max_num_sharers);
+   return create(directory_type, max_hw_sharers, max_num_sharers, NULL, NULL);
 }
 
 DirectoryEntry*
-DirectoryEntry::create(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers)
+DirectoryEntry::create(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers,
+                       void* memory, UInt64* storage)
 {
    switch (directory_type)
    {
    case FULL_MAP:
-      return new DirectoryEntryFullMap(max_num_sharers);
+      return constructEntry<DirectoryEntryFullMap>(max_hw_sharers, max_num_sharers, memory, storage);
 
    case LIMITED_NO_BROADCAST:
-      return new DirectoryEntryLimitedNoBroadcast(max_hw_sharers);
+      return constructEntry<DirectoryEntryLimitedNoBroadcast>(max_hw_sharers, max_num_sharers, memory, storage);
 
    case LIMITED_BROADCAST:
-      return new DirectoryEntryLimitedBroadcast(max_hw_sharers);
+      return constructEntry<DirectoryEntryLimitedBroadcast>(max_hw_sharers, max_num_sharers, memory, storage);
 
    case ACKWISE:
-      return new DirectoryEntryAckwise(max_hw_sharers);
+      return constructEntry<DirectoryEntryAckwise>(max_hw_sharers, max_num_sharers, memory, storage);
 
    case LIMITLESS:
-      return new DirectoryEntryLimitless(max_hw_sharers, max_num_sharers);
+      return constructEntry<DirectoryEntryLimitless>(max_hw_sharers, max_num_sharers, memory, storage);
 
    default:
       LOG_PRINT_ERROR("Unrecognized Directory Type: %u", directory_type);
@@ -90,12 +110,97 @@ DirectoryEntry::getSize(DirectoryType directory_type, SInt32 max_hw_sharers, SIn
    }
 }
 
-DirectoryBlockInfo*
-DirectoryEntry::getDirectoryBlockInfo()
+UInt32
+DirectoryEntry::getObjectSize(DirectoryType directory_type)
 {
-   return _directory_block_info;
+   switch (directory_type)
+   {
+   case FULL_MAP:
+      return sizeof(DirectoryEntryFullMap);
+   case LIMITED_NO_BROADCAST:
+      return sizeof(DirectoryEntryLimitedNoBroadcast);
+   case LIMITED_BROADCAST:
+      return sizeof(DirectoryEntryLimitedBroadcast);
+   case ACKWISE:
+      return sizeof(DirectoryEntryAckwise);
+   case LIMITLESS:
+      return sizeof(DirectoryEntryLimitless);
+   default:
+      LOG_PRINT_ERROR("Unrecognized directory type(%u)", directory_type);
+      return 0;
+   }
 }
-   
+
+UInt32
+DirectoryEntry::getStorageWords(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers)
+{
+   switch (directory_type)
+   {
+   case FULL_MAP:
+      return SharerBitset::getNumWords(max_num_sharers);
+   case LIMITED_NO_BROADCAST:
+   case LIMITED_BROADCAST:
+   case ACKWISE:
+      return getHWSharerWords(max_hw_sharers);
+   case LIMITLESS:
+      // Hardware pointers, then the bitset the sharers move to on a software trap
+      return getHWSharerWords(max_hw_sharers) + SharerBitset::getNumWords(max_num_sharers);
+   default:
+      LOG_PRINT_ERROR("Unrecognized directory type(%u)", directory_type);
+      return 0;
+   }
+}
+
+bool
+DirectoryEntry::hasSharer(tile_id_t sharer_id)
+{
+   switch (_directory_type)
+   {
+   case FULL_MAP:
+      return static_cast<DirectoryEntryFullMap*>(this)->hasSharer(sharer_id);
+   case LIMITLESS:
+      return static_cast<DirectoryEntryLimitless*>(this)->hasSharer(sharer_id);
+   default:
+      return static_cast<DirectoryEntryLimited*>(this)->hasSharer(sharer_id);
+   }
+}
+
+bool
+DirectoryEntry::addSharer(tile_id_t sharer_id)
+{
+   switch (_directory_type)
+   {
+   case FULL_MAP:
+      return static_cast<DirectoryEntryFullMap*>(this)->addSharer(sharer_id);
+   case LIMITED_BROADCAST:
+      return static_cast<DirectoryEntryLimitedBroadcast*>(this)->addSharer(sharer_id);
+   case ACKWISE:
+      return static_cast<DirectoryEntryAckwise*>(this)->addSharer(sharer_id);
+   case LIMITLESS:
+      return static_cast<DirectoryEntryLimitless*>(this)->addSharer(sharer_id);
+   default:
+      return static_cast<DirectoryEntryLimited*>(this)->addSharer(sharer_id);
+   }
+}
+
+SInt32
+DirectoryEntry::getNumSharers()
+{
+   switch (_directory_type)
+   {
+   case FULL_MAP:
+      return static_cast<DirectoryEntryFullMap*>(this)->getNumSharers();
+   case LIMITED_BROADCAST:
+      return static_cast<DirectoryEntryLimitedBroadcast*>(this)->getNumSharers();
+   case ACKWISE:
+      return static_cast<DirectoryEntryAckwise*>(this)->getNumSharers();
+   case LIMITLESS:
+      return static_cast<DirectoryEntryLimitless*>(this)->getNumSharers();
+   default:
+      return static_cast<DirectoryEntryLimited*>(this)->getNumSharers();
+   }
+}
+
 tile_id_t
 DirectoryEntry::getOwner()
 {
@@ -109,3 +214,69 @@ DirectoryEntry::setOwner(tile_id_t owner_id)
       LOG_ASSERT_ERROR(hasSharer(owner_id), "Owner Id(%i) not a sharer", owner_id);
    _owner_id = owner_id;
 }
+
+void
+DirectoryEntry::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint << _address;
+   if (_address == INVALID_ADDRESS)
+      return;
+
+   checkpoint << _directory_block_info.getDState() << _owner_id;
+   saveSharers(checkpoint);
+}
+
+void
+DirectoryEntry::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint >> _address;
+   if (_address == INVALID_ADDRESS)
+      return;
+
+   DirectoryState::Type dstate;
+   checkpoint >> dstate >> _owner_id;
+   _directory_block_info.setDState(dstate);
+   restoreSharers(checkpoint);
+}
+
+bool
+DirectoryEntry::matches(DirectoryEntry* directory_entry)
+{
+   if (_address != directory_entry->getAddress())
+      return false;
+   if (_address == INVALID_ADDRESS)
+      return true;
+   if ((_directory_block_info.getDState() != directory_entry->getDirectoryBlockInfo()->getDState()) ||
+       (_owner_id != directory_entry->getOwner()) ||
+       (inBroadcastMode() != directory_entry->inBroadcastMode()) ||
+       (getNumSharers() != directory_entry->getNumSharers()))
+      return false;
+
+   vector<tile_id_t> sharers_list;
+   vector<tile_id_t> other_sharers_list;
+   getSharersList(sharers_list);
+   directory_entry->getSharersList(other_sharers_list);
+   std::sort(sharers_list.begin(), sharers_list.end());
+   std::sort(other_sharers_list.begin(), other_sharers_list.end());
+   return (sharers_list == other_sharers_list);
+}
+
+void
+DirectoryEntry::saveSharers(CheckpointWriter& checkpoint)
+{
+   vector<tile_id_t> sharers_list;
+   getSharersList(sharers_list);
+   checkpoint.put(sharers_list);
+}
+
+void
+DirectoryEntry::restoreSharers(CheckpointReader& checkpoint)
+{
+   vector<tile_id_t> sharers_list;
+   checkpoint.get(sharers_list);
+   for (vector<tile_id_t>::iterator it = sharers_list.begin(); it != sharers_list.end(); it++)
+   {
+      __attribute(__unused__) bool added = addSharer(*it);
+      LOG_ASSERT_ERROR(added, "Could not restore sharer(%i) of address(%#lx)", *it, _address);
+   }
+}
@@ -9,22 +9,36 @@ using std::string;
 #include "directory_block_info.h"
 #include "directory_type.h"
 #include "caching_protocol_type.h"
+#include "checkpoint_stream.h"
 
 class DirectoryEntry
 {
 public:
-   DirectoryEntry(SInt32 max_hw_sharers);
+   // The sharers are kept in 'storage' (getStorageWords() words). If NULL,
+   // the entry allocates its own
+   DirectoryEntry(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    virtual ~DirectoryEntry();
 
    static DirectoryType parseDirectoryType(string directory_type);
    static DirectoryEntry* create(CachingProtocolType caching_protocol_type, DirectoryType directory_type,
                                  SInt32 max_hw_sharers, SInt32 max_num_sharers);
+   // Constructs the entry in 'memory' (getObjectSize() bytes) with its sharers in 'storage'.
+   // The entry must then be destroyed by calling its destructor instead of deleting it
+   static DirectoryEntry* create(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers,
+                                 void* memory, UInt64* storage);
    static UInt32 getSize(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers);
+   static UInt32 getObjectSize(DirectoryType directory_type);
+   static UInt32 getStorageWords(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers);
 
-   DirectoryBlockInfo* getDirectoryBlockInfo();
+   DirectoryBlockInfo* getDirectoryBlockInfo() { return &_directory_block_info; }
+   UInt64* getStorage() { return _storage; }
+
+   // Called on every coherence request, so these dispatch on the
+   // directory type instead of going through the vtable
+   bool hasSharer(tile_id_t sharer_id);
+   bool addSharer(tile_id_t sharer_id);
+   SInt32 getNumSharers();
 
-   virtual bool hasSharer(tile_id_t sharer_id) = 0;
-   virtual bool addSharer(tile_id_t sharer_id) = 0;
    virtual void removeSharer(tile_id_t sharer_id, bool reply_expected = false) = 0;
 
    tile_id_t getOwner();
@@ -36,16 +50,30 @@ public:
    virtual bool inBroadcastMode() { return false; }
    virtual bool getSharersList(vector<tile_id_t>& sharers_list) = 0;
    virtual tile_id_t getOneSharer() = 0;
-   virtual SInt32 getNumSharers() = 0;
 
    virtual UInt32 getLatency() = 0;
 
+   // Must be restored into a newly created entry of the same type
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+   // Same address, state, owner and sharers
+   bool matches(DirectoryEntry* directory_entry);
+
 protected:
    IntPtr _address;
-   DirectoryBlockInfo* _directory_block_info;
+   DirectoryBlockInfo _directory_block_info;
    tile_id_t _owner_id;
    SInt32 _max_hw_sharers;
+   DirectoryType _directory_type;
+   UInt64* _storage;
+   bool _owns_storage;
+
+   // Hardware sharer pointers come first in the storage
+   static UInt32 getHWSharerWords(SInt32 max_hw_sharers)
+   { return (max_hw_sharers * sizeof(SInt16) + sizeof(UInt64) - 1) / sizeof(UInt64); }
 
-private:
-   static DirectoryEntry* create(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers);
+   // Sharers are restored by adding them again; entries that also count
+   // sharers they do not track save those counts on top
+   virtual void saveSharers(CheckpointWriter& checkpoint);
+   virtual void restoreSharers(CheckpointReader& checkpoint);
 };
@@ -1,8 +1,8 @@
 #include "directory_entry_ackwise.h"
 #include "log.h"
 
-DirectoryEntryAckwise::DirectoryEntryAckwise(SInt32 max_hw_sharers)
-   : DirectoryEntryLimited(max_hw_sharers)
+DirectoryEntryAckwise::DirectoryEntryAckwise(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntryLimited(ACKWISE, max_hw_sharers, max_num_sharers, storage)
    , _global_enabled(false)
    , _num_untracked_sharers(0)
 {}
@@ -90,3 +90,19 @@ DirectoryEntryAckwise::getLatency()
 {
    return 0;
 }
+
+void
+DirectoryEntryAckwise::saveSharers(CheckpointWriter& checkpoint)
+{
+   DirectoryEntryLimited::saveSharers(checkpoint);
+   checkpoint << _global_enabled << _num_untracked_sharers;
+}
+
+void
+DirectoryEntryAckwise::restoreSharers(CheckpointReader& checkpoint)
+{
+   // The tracked sharers fit in hardware, so adding them never switches
+   // to broadcast mode
+   DirectoryEntryLimited::restoreSharers(checkpoint);
+   checkpoint >> _global_enabled >> _num_untracked_sharers;
+}
@@ -5,7 +5,7 @@
 class DirectoryEntryAckwise : public DirectoryEntryLimited
 {
 public:
-   DirectoryEntryAckwise(SInt32 max_hw_sharers);
+   DirectoryEntryAckwise(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryAckwise();
   
    bool addSharer(tile_id_t sharer_id); 
@@ -17,6 +17,10 @@ public:
 
    UInt32 getLatency();
 
+protected:
+   void saveSharers(CheckpointWriter& checkpoint);
+   void restoreSharers(CheckpointReader& checkpoint);
+
 private:
    bool _global_enabled;
    SInt32 _num_untracked_sharers;
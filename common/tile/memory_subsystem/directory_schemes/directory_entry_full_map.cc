@@ -1,23 +1,22 @@
+#include <cassert>
+
 #include "directory_entry_full_map.h"
 #include "log.h"
 
 using namespace std;
 
-DirectoryEntryFullMap::DirectoryEntryFullMap(SInt32 max_hw_sharers)
-   : DirectoryEntry(max_hw_sharers)
-{
-   _sharers = new BitVector(_max_hw_sharers);
-}
+DirectoryEntryFullMap::DirectoryEntryFullMap(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntry(FULL_MAP, max_hw_sharers, max_num_sharers, storage)
+   , _sharers(max_num_sharers, _storage)
+{}
 
 DirectoryEntryFullMap::~DirectoryEntryFullMap()
-{
-   delete _sharers;
-}
+{}
 
 bool
 DirectoryEntryFullMap::hasSharer(tile_id_t sharer_id)
 {
-   return _sharers->at(sharer_id);
+   return _sharers.at(sharer_id);
 }
 
 // Return value says whether the sharer was successfully added
@@ -26,8 +25,8 @@ DirectoryEntryFullMap::hasSharer(tile_id_t sharer_id)
 bool
 DirectoryEntryFullMap::addSharer(tile_id_t sharer_id)
 {
-   LOG_ASSERT_ERROR(!_sharers->at(sharer_id), "Could not add sharer(%i)", sharer_id);
-   _sharers->set(sharer_id);
+   LOG_ASSERT_ERROR(!_sharers.at(sharer_id), "Could not add sharer(%i)", sharer_id);
+   _sharers.set(sharer_id);
    return true;;
 }
 
@@ -36,8 +35,8 @@ DirectoryEntryFullMap::removeSharer(tile_id_t sharer_id, bool reply_expected)
 {
    assert(!reply_expected);
 
-   assert(_sharers->at(sharer_id));
-   _sharers->clear(sharer_id);
+   assert(_sharers.at(sharer_id));
+   _sharers.clear(sharer_id);
 }
 
 // Return a pair:
@@ -47,18 +46,8 @@ DirectoryEntryFullMap::removeSharer(tile_id_t sharer_id, bool reply_expected)
 bool
 DirectoryEntryFullMap::getSharersList(vector<tile_id_t>& sharers_list)
 {
-   sharers_list.resize(_sharers->size());
-
-   _sharers->resetFind();
-
-   tile_id_t new_sharer = -1;
-   SInt32 i = 0;
-   while ((new_sharer = _sharers->find()) != -1)
-   {
-      sharers_list[i] = new_sharer;
-      i++;
-      assert (i <= (tile_id_t) _sharers->size());
-   }
+   sharers_list.clear();
+   _sharers.getList(sharers_list);
 
    return false;
 }
@@ -76,7 +65,7 @@ DirectoryEntryFullMap::getOneSharer()
 SInt32
 DirectoryEntryFullMap::getNumSharers()
 {
-   return _sharers->size();
+   return _sharers.size();
 }
 
 UInt32
@@ -1,13 +1,13 @@
 #pragma once
 
 #include "directory_entry.h"
-#include "bit_vector.h"
+#include "sharer_bitset.h"
 #include "random.h"
 
 class DirectoryEntryFullMap : public DirectoryEntry
 {
 public:
-   DirectoryEntryFullMap(SInt32 max_hw_sharers);
+   DirectoryEntryFullMap(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryFullMap();
    
    bool hasSharer(tile_id_t sharer_id);
@@ -24,6 +24,6 @@ public:
    UInt32 getLatency();
 
 private:
-   BitVector* _sharers;
+   SharerBitset _sharers;
    Random _rand_num;
 };
@@ -3,11 +3,11 @@
 
 using namespace std;
 
-DirectoryEntryLimited::DirectoryEntryLimited(SInt32 max_hw_sharers)
-   : DirectoryEntry(max_hw_sharers)
+DirectoryEntryLimited::DirectoryEntryLimited(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntry(directory_type, max_hw_sharers, max_num_sharers, storage)
+   , _sharers((SInt16*) _storage)
    , _num_tracked_sharers(0)
 {
-   _sharers.resize(_max_hw_sharers);
    for (SInt32 i = 0; i < _max_hw_sharers; i++)
       _sharers[i] = INVALID_SHARER;
 }
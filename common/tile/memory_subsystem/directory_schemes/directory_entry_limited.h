@@ -6,7 +6,7 @@
 class DirectoryEntryLimited : public DirectoryEntry
 {
 public:
-   DirectoryEntryLimited(SInt32 max_hw_sharers);
+   DirectoryEntryLimited(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryLimited();
 
    bool hasSharer(tile_id_t sharer_id);
@@ -18,7 +18,8 @@ public:
    SInt32 getNumSharers();
 
 protected:
-   vector<SInt16> _sharers;
+   // Hardware sharer pointers, at the start of the entry storage
+   SInt16* _sharers;
    SInt32 _num_tracked_sharers;
    static const SInt16 INVALID_SHARER = 0xffff;
 
@@ -4,8 +4,8 @@
 
 using namespace std;
 
-DirectoryEntryLimitedBroadcast::DirectoryEntryLimitedBroadcast(SInt32 max_hw_sharers)
-   : DirectoryEntryLimited(max_hw_sharers)
+DirectoryEntryLimitedBroadcast::DirectoryEntryLimitedBroadcast(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntryLimited(LIMITED_BROADCAST, max_hw_sharers, max_num_sharers, storage)
    , _global_enabled(false)
    , _num_sharers(0)
 {}
@@ -88,3 +88,18 @@ DirectoryEntryLimitedBroadcast::getLatency()
    return 0;
 }
 
+void
+DirectoryEntryLimitedBroadcast::saveSharers(CheckpointWriter& checkpoint)
+{
+   DirectoryEntryLimited::saveSharers(checkpoint);
+   checkpoint << _global_enabled << _num_sharers;
+}
+
+void
+DirectoryEntryLimitedBroadcast::restoreSharers(CheckpointReader& checkpoint)
+{
+   // The tracked sharers fit in hardware, so adding them never switches
+   // to broadcast mode
+   DirectoryEntryLimited::restoreSharers(checkpoint);
+   checkpoint >> _global_enabled >> _num_sharers;
+}
@@ -5,7 +5,7 @@
 class DirectoryEntryLimitedBroadcast : public DirectoryEntryLimited
 {
 public:
-   DirectoryEntryLimitedBroadcast(SInt32 max_hw_sharers);
+   DirectoryEntryLimitedBroadcast(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryLimitedBroadcast();
    
    bool addSharer(tile_id_t sharer_id);
@@ -17,6 +17,10 @@ public:
 
    UInt32 getLatency();
 
+protected:
+   void saveSharers(CheckpointWriter& checkpoint);
+   void restoreSharers(CheckpointReader& checkpoint);
+
 private:
    bool _global_enabled;
    UInt32 _num_sharers;
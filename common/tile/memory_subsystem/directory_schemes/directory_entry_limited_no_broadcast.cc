@@ -1,8 +1,8 @@
 #include "directory_entry_limited_no_broadcast.h"
 #include "log.h"
 
-DirectoryEntryLimitedNoBroadcast::DirectoryEntryLimitedNoBroadcast(SInt32 max_hw_sharers)
-   : DirectoryEntryLimited(max_hw_sharers)
+DirectoryEntryLimitedNoBroadcast::DirectoryEntryLimitedNoBroadcast(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntryLimited(LIMITED_NO_BROADCAST, max_hw_sharers, max_num_sharers, storage)
 {}
 
 DirectoryEntryLimitedNoBroadcast::~DirectoryEntryLimitedNoBroadcast()
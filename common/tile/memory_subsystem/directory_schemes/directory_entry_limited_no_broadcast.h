@@ -5,7 +5,7 @@
 class DirectoryEntryLimitedNoBroadcast : public DirectoryEntryLimited
 {
 public:
-   DirectoryEntryLimitedNoBroadcast(SInt32 max_hw_sharers);
+   DirectoryEntryLimitedNoBroadcast(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryLimitedNoBroadcast();
    
    void removeSharer(tile_id_t sharer_id, bool reply_expected);
@@ -6,9 +6,9 @@
 bool DirectoryEntryLimitless::_software_trap_penalty_initialized = false;
 UInt32 DirectoryEntryLimitless::_software_trap_penalty;
 
-DirectoryEntryLimitless::DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 max_num_sharers)
-   : DirectoryEntryLimited(max_hw_sharers)
-   , _software_sharers(NULL)
+DirectoryEntryLimitless::DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage)
+   : DirectoryEntryLimited(LIMITLESS, max_hw_sharers, max_num_sharers, storage)
+   , _software_sharers(max_num_sharers, _storage + getHWSharerWords(max_hw_sharers))
    , _max_num_sharers(max_num_sharers)
    , _software_trap_enabled(false)
 {
@@ -20,17 +20,14 @@ DirectoryEntryLimitless::DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 m
 }
 
 DirectoryEntryLimitless::~DirectoryEntryLimitless()
-{
-   if (_software_sharers)
-      delete _software_sharers;
-}
+{}
 
 bool
 DirectoryEntryLimitless::hasSharer(tile_id_t sharer_id)
 {
    if (_software_trap_enabled) // Explicit software tracking of sharers
    {
-      return _software_sharers->at(sharer_id);
+      return _software_sharers.at(sharer_id);
    }
    else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
    {
@@ -46,8 +43,8 @@ DirectoryEntryLimitless::addSharer(tile_id_t sharer_id)
 {
    if (_software_trap_enabled) // Explicit software tracking of sharers
    {
-      assert(!_software_sharers->at(sharer_id));
-      _software_sharers->set(sharer_id);
+      assert(!_software_sharers.at(sharer_id));
+      _software_sharers.set(sharer_id);
    }
 
    else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
@@ -57,19 +54,18 @@ DirectoryEntryLimitless::addSharer(tile_id_t sharer_id)
       {
          // Migrate the sharers from hardware to software
          _software_trap_enabled = true;
-         _software_sharers = new BitVector(_max_num_sharers);
          for (SInt32 i = 0; i < _max_hw_sharers; i++)
          {
             if (_sharers[i] != INVALID_SHARER)
             {
                assert(_sharers[i] >= 0 && _sharers[i] < _max_num_sharers);
-               _software_sharers->set(_sharers[i]);
+               _software_sharers.set(_sharers[i]);
                _sharers[i] = INVALID_SHARER;
                _num_tracked_sharers --;
             }
          }
          // Add current sharer
-         _software_sharers->set(sharer_id);
+         _software_sharers.set(sharer_id);
          LOG_ASSERT_ERROR(_num_tracked_sharers == 0, "Num Tracked Sharers(%i)", _num_tracked_sharers);
       }
    }
@@ -85,8 +81,8 @@ DirectoryEntryLimitless::removeSharer(tile_id_t sharer_id, bool reply_expected)
 
    if (_software_trap_enabled) // Explicit software tracking of sharers
    {
-      assert(_software_sharers->at(sharer_id));
-      _software_sharers->clear(sharer_id);
+      assert(_software_sharers.at(sharer_id));
+      _software_sharers.clear(sharer_id);
    }
    else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
    {
@@ -103,18 +99,8 @@ DirectoryEntryLimitless::getSharersList(vector<tile_id_t>& sharers_list)
 {
    if (_software_trap_enabled) // Explicit software tracking of sharers
    {
-      sharers_list.resize(_software_sharers->size());
-      
-      _software_sharers->resetFind();
-
-      tile_id_t new_sharer = -1;
-      SInt32 i = 0;
-      while ((new_sharer = _software_sharers->find()) != -1)
-      {
-         sharers_list[i] = new_sharer;
-         i++;
-         assert (i <= (tile_id_t) _software_sharers->size());
-      }
+      sharers_list.clear();
+      _software_sharers.getList(sharers_list);
    }
    else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
    {
@@ -127,7 +113,7 @@ DirectoryEntryLimitless::getSharersList(vector<tile_id_t>& sharers_list)
 SInt32
 DirectoryEntryLimitless::getNumSharers()
 {
-   return (_software_trap_enabled) ? _software_sharers->size() : _num_tracked_sharers;
+   return (_software_trap_enabled) ? _software_sharers.size() : _num_tracked_sharers;
 }
 
 UInt32
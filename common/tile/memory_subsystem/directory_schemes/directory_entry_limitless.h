@@ -1,12 +1,12 @@
 #pragma once
 
 #include "directory_entry_limited.h"
-#include "bit_vector.h"
+#include "sharer_bitset.h"
 
 class DirectoryEntryLimitless : public DirectoryEntryLimited
 {
 public:
-   DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 max_num_sharers);
+   DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 max_num_sharers, UInt64* storage);
    ~DirectoryEntryLimitless();
    
    bool hasSharer(tile_id_t sharer_id);
@@ -19,8 +19,8 @@ public:
    UInt32 getLatency();
 
 private:
-   // Software Sharers
-   BitVector* _software_sharers;
+   // Software Sharers, after the hardware pointers in the entry storage
+   SharerBitset _software_sharers;
 
    // Max Num Sharers - For Software Trap
    SInt32 _max_num_sharers;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+using std::vector;
+
+#include "fixed_types.h"
+
+// Fixed-width set of sharers. The words are not owned: they are part of the
+// storage of the directory entry, which is sized at construction
+class SharerBitset
+{
+public:
+   SharerBitset(UInt32 num_bits, UInt64* words)
+      : _num_words(getNumWords(num_bits))
+      , _words(words)
+      , _size(0)
+   { memset(_words, 0, _num_words * sizeof(UInt64)); }
+
+   static UInt32 getNumWords(UInt32 num_bits) { return (num_bits + 63) >> 6; }
+
+   bool at(UInt32 bit) const
+   { return (_words[bit >> 6] >> (bit & 63)) & 1; }
+
+   void set(UInt32 bit)
+   {
+      if (!at(bit))
+      {
+         _words[bit >> 6] |= (1ULL << (bit & 63));
+         _size ++;
+      }
+   }
+
+   void clear(UInt32 bit)
+   {
+      if (at(bit))
+      {
+         _words[bit >> 6] &= ~(1ULL << (bit & 63));
+         _size --;
+      }
+   }
+
+   UInt32 size() const { return _size; }
+
+   // Appends the set bits in increasing order
+   void getList(vector<tile_id_t>& list) const
+   {
+      for (UInt32 i = 0; i < _num_words; i++)
+      {
+         for (UInt64 word = _words[i]; word != 0; word &= (word - 1))
+            list.push_back((i << 6) + __builtin_ctzll(word));
+      }
+   }
+
+private:
+   UInt32 _num_words;
+   UInt64* _words;
+   UInt32 _size;
+};
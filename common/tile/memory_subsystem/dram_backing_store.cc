@@ -0,0 +1,170 @@
+#include <sys/mman.h>
+#include <cassert>
+#include <cstring>
+
+#include "dram_backing_store.h"
+#include "utils.h"
+#include "log.h"
+
+// Page number reserved to mark empty page table slots
+static const IntPtr EMPTY_PAGE_NUM = (IntPtr) ~0;
+static const UInt64 INITIAL_PAGE_TABLE_SIZE = 1024;
+
+DramBackingStore::DramBackingStore(UInt32 cache_line_size)
+   : _cache_line_size(cache_line_size)
+   , _log_page_size(floorLog2(PAGE_SIZE))
+   , _page_table_size(INITIAL_PAGE_TABLE_SIZE)
+   , _num_pages(0)
+   , _arena_offset(ARENA_SIZE)
+{
+   LOG_ASSERT_ERROR(isPower2(_cache_line_size) && (_cache_line_size <= PAGE_SIZE),
+                    "Cache line size(%u) must be a power of 2 not larger than the page size(%u)",
+                    _cache_line_size, PAGE_SIZE);
+
+   _page_table = new PageEntry[_page_table_size];
+   for (UInt64 i = 0; i < _page_table_size; i++)
+      _page_table[i]._page_num = EMPTY_PAGE_NUM;
+}
+
+DramBackingStore::~DramBackingStore()
+{
+   for (vector<Byte*>::iterator it = _arena_list.begin(); it != _arena_list.end(); it++)
+      munmap((void*) *it, ARENA_SIZE);
+   delete [] _page_table;
+}
+
+Byte*
+DramBackingStore::getLine(IntPtr address)
+{
+   IntPtr page_num = address >> _log_page_size;
+   PageEntry* page_entry = lookupPageEntry(_page_table, _page_table_size, page_num);
+   if (page_entry->_page_num == EMPTY_PAGE_NUM)
+   {
+      // Keep the load factor below 1/2
+      if (2 * (_num_pages + 1) > _page_table_size)
+      {
+         growPageTable();
+         page_entry = lookupPageEntry(_page_table, _page_table_size, page_num);
+      }
+      page_entry->_page_num = page_num;
+      page_entry->_page = allocatePage();
+      _num_pages ++;
+   }
+   return page_entry->_page + (address & (PAGE_SIZE-1));
+}
+
+Byte*
+DramBackingStore::findLine(IntPtr address) const
+{
+   IntPtr page_num = address >> _log_page_size;
+   PageEntry* page_entry = lookupPageEntry(_page_table, _page_table_size, page_num);
+   if (page_entry->_page_num == EMPTY_PAGE_NUM)
+      return NULL;
+   return page_entry->_page + (address & (PAGE_SIZE-1));
+}
+
+void
+DramBackingStore::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint << _num_pages;
+   for (UInt64 i = 0; i < _page_table_size; i++)
+   {
+      if (_page_table[i]._page_num != EMPTY_PAGE_NUM)
+      {
+         checkpoint << _page_table[i]._page_num;
+         checkpoint.put(_page_table[i]._page, PAGE_SIZE);
+      }
+   }
+}
+
+void
+DramBackingStore::restoreState(CheckpointReader& checkpoint)
+{
+   // The pages hold the live application's data, so they are only compared
+   // against the checkpoint. Untouched pages read as zeros on either side
+   static const Byte zero_page[PAGE_SIZE] = { 0 };
+   Byte saved_page[PAGE_SIZE];
+   set<IntPtr> saved_page_nums;
+   UInt64 num_mismatched_pages = 0;
+
+   UInt64 num_pages;
+   checkpoint >> num_pages;
+   for (UInt64 i = 0; i < num_pages; i++)
+   {
+      IntPtr page_num;
+      checkpoint >> page_num;
+      checkpoint.get(saved_page, PAGE_SIZE);
+      saved_page_nums.insert(page_num);
+
+      Byte* page = findLine(page_num << _log_page_size);
+      if (memcmp(saved_page, page ? page : zero_page, PAGE_SIZE) != 0)
+         num_mismatched_pages ++;
+   }
+
+   for (UInt64 i = 0; i < _page_table_size; i++)
+   {
+      if ((_page_table[i]._page_num != EMPTY_PAGE_NUM) &&
+          (saved_page_nums.find(_page_table[i]._page_num) == saved_page_nums.end()) &&
+          (memcmp(_page_table[i]._page, zero_page, PAGE_SIZE) != 0))
+         num_mismatched_pages ++;
+   }
+
+   if (num_mismatched_pages > 0)
+   {
+      LOG_PRINT_WARNING("%llu DRAM pages differ from the checkpoint, keeping the live ones",
+                        (unsigned long long) num_mismatched_pages);
+   }
+}
+
+Byte*
+DramBackingStore::allocatePage()
+{
+   if (_arena_offset == ARENA_SIZE)
+   {
+      // Anonymous mappings are zero-filled and only consume memory once touched
+      void* arena = mmap(NULL, ARENA_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      LOG_ASSERT_ERROR(arena != MAP_FAILED, "Could not allocate DRAM backing store arena");
+      _arena_list.push_back((Byte*) arena);
+      _arena_offset = 0;
+   }
+   Byte* page = _arena_list.back() + _arena_offset;
+   _arena_offset += PAGE_SIZE;
+   return page;
+}
+
+void
+DramBackingStore::growPageTable()
+{
+   UInt64 new_page_table_size = 2 * _page_table_size;
+   PageEntry* new_page_table = new PageEntry[new_page_table_size];
+   for (UInt64 i = 0; i < new_page_table_size; i++)
+      new_page_table[i]._page_num = EMPTY_PAGE_NUM;
+
+   for (UInt64 i = 0; i < _page_table_size; i++)
+   {
+      if (_page_table[i]._page_num != EMPTY_PAGE_NUM)
+         *lookupPageEntry(new_page_table, new_page_table_size, _page_table[i]._page_num) = _page_table[i];
+   }
+
+   delete [] _page_table;
+   _page_table = new_page_table;
+   _page_table_size = new_page_table_size;
+}
+
+UInt64
+DramBackingStore::hashPageNum(IntPtr page_num) const
+{
+   // Fibonacci hashing spreads the (often consecutive) page numbers over the table
+   return (UInt64) page_num * 0x9E3779B97F4A7C15ULL;
+}
+
+DramBackingStore::PageEntry*
+DramBackingStore::lookupPageEntry(PageEntry* page_table, UInt64 page_table_size, IntPtr page_num) const
+{
+   // Linear probing - returns the slot holding 'page_num' or the empty slot where it belongs
+   UInt64 index = (hashPageNum(page_num) >> 32) & (page_table_size-1);
+   while ((page_table[index]._page_num != page_num) && (page_table[index]._page_num != EMPTY_PAGE_NUM))
+      index = (index + 1) & (page_table_size-1);
+   return &page_table[index];
+}
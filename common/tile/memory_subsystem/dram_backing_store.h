@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <set>
+using std::vector;
+using std::set;
+
+#include "fixed_types.h"
+#include "checkpoint_stream.h"
+
+// Functional data held by a DRAM controller
+// Data is kept at page granularity: pages are carved out of large anonymous mmap() arenas
+// (zero-filled and only backed by host memory once touched), and located through
+// an open-addressing hash table keyed on the page number
+class DramBackingStore
+{
+public:
+   DramBackingStore(UInt32 cache_line_size);
+   ~DramBackingStore();
+
+   // Returns the cache line at 'address', allocating (zero-filled) storage on first touch
+   Byte* getLine(IntPtr address);
+   // Returns the cache line at 'address' or NULL if its page was never touched
+   Byte* findLine(IntPtr address) const;
+
+   // Only pages that were touched are saved. The pages hold the live
+   // application's data, so a restore only compares them with the checkpoint
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
+   static const UInt32 PAGE_SIZE = 4096;
+   static const UInt32 ARENA_SIZE = 64 << 20;
+
+private:
+   struct PageEntry
+   {
+      IntPtr _page_num;
+      Byte* _page;
+   };
+
+   UInt32 _cache_line_size;
+   UInt32 _log_page_size;
+
+   // Page table
+   PageEntry* _page_table;
+   UInt64 _page_table_size;
+   UInt64 _num_pages;
+
+   // Arenas
+   vector<Byte*> _arena_list;
+   UInt32 _arena_offset;
+
+   Byte* allocatePage();
+   void growPageTable();
+   UInt64 hashPageNum(IntPtr page_num) const;
+   PageEntry* lookupPageEntry(PageEntry* page_table, UInt64 page_table_size, IntPtr page_num) const;
+};
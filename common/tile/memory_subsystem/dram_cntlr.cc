@@ -14,6 +14,8 @@ DramCntlr::DramCntlr(Tile* tile,
       string dram_queue_model_type,
       UInt32 cache_line_size)
    : _tile(tile)
+   , _data_store(cache_line_size)
+   , _zero_latency(0, DRAM_FREQUENCY)
    , _cache_line_size(cache_line_size)
 {
    _dram_perf_model = new DramPerfModel(dram_access_cost, 
@@ -36,14 +38,10 @@ DramCntlr::~DramCntlr()
 void
 DramCntlr::getDataFromDram(IntPtr address, Byte* data_buf, bool modeled)
 {
-   if (_data_map[address] == NULL)
-   {
-      _data_map[address] = new Byte[_cache_line_size];
-      memset((void*) _data_map[address], 0x00, _cache_line_size);
-   }
-   memcpy((void*) data_buf, (void*) _data_map[address], _cache_line_size);
+   // Lines that were never written read as zero
+   memcpy((void*) data_buf, (void*) _data_store.getLine(address), _cache_line_size);
 
-   Latency dram_access_latency = modeled ? runDramPerfModel() : Latency(0,DRAM_FREQUENCY);
+   Latency dram_access_latency = modeled ? runDramPerfModel() : _zero_latency;
    LOG_PRINT("Dram Access Latency(%llu)", dram_access_latency.getCycles());
    getShmemPerfModel()->incrCurrTime(dram_access_latency);
 
@@ -53,11 +51,12 @@ DramCntlr::getDataFromDram(IntPtr address, Byte* data_buf, bool modeled)
 void
 DramCntlr::putDataToDram(IntPtr address, Byte* data_buf, bool modeled)
 {
-   LOG_ASSERT_ERROR(_data_map[address] != NULL, "Data Buffer does not exist");
+   Byte* line = _data_store.findLine(address);
+   LOG_ASSERT_ERROR(line != NULL, "Data Buffer does not exist");
    
-   memcpy((void*) _data_map[address], (void*) data_buf, _cache_line_size);
+   memcpy((void*) line, (void*) data_buf, _cache_line_size);
 
-   __attribute(__unused__) Latency dram_access_latency = modeled ? runDramPerfModel() : Latency(0,DRAM_FREQUENCY);
+   __attribute(__unused__) Latency dram_access_latency = modeled ? runDramPerfModel() : _zero_latency;
    
    addToDramAccessCount(address, WRITE);
 }
@@ -73,6 +72,20 @@ DramCntlr::runDramPerfModel()
    return _dram_perf_model->getAccessLatency(pkt_time, pkt_size);
 }
 
+void
+DramCntlr::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_DRAM);
+   _data_store.saveState(checkpoint);
+}
+
+void
+DramCntlr::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.checkSection(CHECKPOINT_DRAM);
+   _data_store.restoreState(checkpoint);
+}
+
 void
 DramCntlr::addToDramAccessCount(IntPtr address, AccessType access_type)
 {
@@ -8,6 +8,7 @@ using std::map;
 #include "shmem_perf_model.h"
 #include "fixed_types.h"
 #include "time_types.h"
+#include "dram_backing_store.h"
 
 class DramCntlr
 {
@@ -31,11 +32,16 @@ public:
 
    void getDataFromDram(IntPtr address, Byte* data_buf, bool modeled);
    void putDataToDram(IntPtr address, Byte* data_buf, bool modeled);
+
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
    
 private:
    Tile* _tile;
-   map<IntPtr, Byte*> _data_map;
+   DramBackingStore _data_store;
    DramPerfModel* _dram_perf_model;
+   // Latency of an unmodeled access
+   Latency _zero_latency;
 
    typedef std::map<IntPtr,UInt64> AccessCountMap;
    AccessCountMap* _dram_access_count;
@@ -9,6 +9,7 @@ using namespace std;
 #include "mem_component.h"
 #include "caching_protocol_type.h"
 #include "shmem_perf_model.h"
+#include "checkpoint_stream.h"
 
 void MemoryManagerNetworkCallback(void* obj, NetPacket packet);
 
@@ -39,6 +40,11 @@ public:
    virtual void enableModels();
    virtual void disableModels();
    bool isEnabled()                       { return _enabled;  }
+
+   // Checkpoint the caches, directories and DRAM contents of the tile
+   // Only valid while no memory requests are in flight
+   virtual void saveState(CheckpointWriter& checkpoint) = 0;
+   virtual void restoreState(CheckpointReader& checkpoint) = 0;
   
    // APP + SIM thread synchronization 
    void waitForAppThread();
@@ -6,6 +6,7 @@ using namespace std;
 #include "dram_perf_model.h"
 #include "queue_model_history_list.h"
 #include "queue_model_history_tree.h"
+#include "queue_model_history_calendar.h"
 #include "constants.h"
 
 // Note: Each Dram Controller owns a single DramModel object
@@ -27,6 +28,7 @@ DramPerfModel::DramPerfModel(float dram_access_cost,
    m_dram_access_cost(UInt64(dram_access_cost)),
    m_dram_bandwidth(dram_bandwidth),
    m_cache_block_size(cache_block_size),
+   m_frequency_domain(DRAM_FREQUENCY),
    m_queue_model_type(queue_model_type),
    m_queue_model_enabled(queue_model_enabled),
    m_enabled(false)
@@ -79,14 +81,14 @@ DramPerfModel::getAccessLatency(Time pkt_time, UInt64 pkt_size)
    // 1 cycle = 1 nanosecond.
    
    // convert to nanoseconds
-   UInt64 pkt_time_ns = (UInt64) ceil(pkt_time.getTime()/1000.0);
+   UInt64 pkt_time_ns = pkt_time.toCycles(m_frequency_domain);
 
    // pkt_size is in 'Bytes'
    // m_dram_bandwidth is in 'Bytes per clock cycle'
    if (!m_enabled) 
    {
       LOG_PRINT("Not enabled. Return 0");
-      return Latency(0,DRAM_FREQUENCY);
+      return Latency(0,m_frequency_domain);
    }
 
    UInt64 processing_time = (UInt64) ((float) pkt_size/m_dram_bandwidth) + 1;
@@ -112,7 +114,7 @@ DramPerfModel::getAccessLatency(Time pkt_time, UInt64 pkt_size)
    m_total_access_latency += (double) access_latency;
    m_total_queueing_delay += (double) queue_delay;
 
-   return Latency(access_latency,DRAM_FREQUENCY);
+   return Latency(access_latency,m_frequency_domain);
 }
 
 void
@@ -139,7 +141,8 @@ DramPerfModel::outputSummary(ostream& out)
 
 
    std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
-   if (m_queue_model && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
+   if (m_queue_model && ((queue_model_type == "history_list") || (queue_model_type == "history_tree") ||
+                         (queue_model_type == "history_calendar")))
    {
       out << "    Queue Model:" << endl;
        
@@ -152,7 +155,7 @@ DramPerfModel::outputSummary(ostream& out)
          out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
          out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
       }
-      else // (queue_model_type == "history_tree")
+      else if (queue_model_type == "history_tree")
       {
          float queue_utilization = ((QueueModelHistoryTree*) m_queue_model)->getQueueUtilization();
          float frac_requests_using_analytical_model = \
@@ -161,6 +164,15 @@ DramPerfModel::outputSummary(ostream& out)
          out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
          out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
       }
+      else // (queue_model_type == "history_calendar")
+      {
+         float queue_utilization = ((QueueModelHistoryCalendar*) m_queue_model)->getQueueUtilization();
+         float frac_requests_using_analytical_model = \
+            ((float) ((QueueModelHistoryCalendar*) m_queue_model)->getTotalRequestsUsingAnalyticalModel()) / \
+            ((QueueModelHistoryCalendar*) m_queue_model)->getTotalRequests();
+         out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
+         out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
+      }
    }
 }
 
@@ -174,7 +186,8 @@ DramPerfModel::dummyOutputSummary(ostream& out)
    
    bool queue_model_enabled = Sim()->getCfg()->getBool("dram/queue_model/enabled");
    std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
-   if (queue_model_enabled && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
+   if (queue_model_enabled && ((queue_model_type == "history_list") || (queue_model_type == "history_tree") ||
+                               (queue_model_type == "history_calendar")))
    {
       out << "    Queue Model:" << endl;
       out << "      Queue Utilization(\%): " << endl;
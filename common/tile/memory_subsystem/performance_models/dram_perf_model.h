@@ -25,6 +25,8 @@ class DramPerfModel
 
       UInt32 m_cache_block_size;
 
+      // The DRAM is clocked at DRAM_FREQUENCY
+      FrequencyDomain m_frequency_domain;
 
       // Queue Model
       QueueModel* m_queue_model;
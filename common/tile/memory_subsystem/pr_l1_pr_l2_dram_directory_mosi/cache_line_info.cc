@@ -20,6 +20,23 @@ createCacheLineInfo(SInt32 cache_level)
    }
 }
 
+void
+createCacheLineInfoArray(SInt32 cache_level, UInt32 num_lines, CacheLineInfo** cache_line_info_array)
+{
+   switch (cache_level)
+   {
+   case L1:
+      CacheLineInfo::constructArray<PrL1CacheLineInfo>(num_lines, cache_line_info_array);
+      break;
+   case L2:
+      CacheLineInfo::constructArray<PrL2CacheLineInfo>(num_lines, cache_line_info_array);
+      break;
+   default:
+      LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
+      break;
+   }
+}
+
 //// PrL2 CacheLineInfo
 
 PrL2CacheLineInfo::PrL2CacheLineInfo(IntPtr tag, CacheState::Type cstate, MemComponent::Type cached_loc)
@@ -74,4 +91,18 @@ PrL2CacheLineInfo::assign(CacheLineInfo* cache_line_info)
    _cached_loc = L2_cache_line_info->getCachedLoc();
 }
 
+void
+PrL2CacheLineInfo::saveState(CheckpointWriter& checkpoint)
+{
+   CacheLineInfo::saveState(checkpoint);
+   checkpoint << _cached_loc;
+}
+
+void
+PrL2CacheLineInfo::restoreState(CheckpointReader& checkpoint)
+{
+   CacheLineInfo::restoreState(checkpoint);
+   checkpoint >> _cached_loc;
+}
+
 }
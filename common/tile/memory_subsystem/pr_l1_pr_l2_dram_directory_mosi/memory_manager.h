@@ -48,6 +48,9 @@ namespace PrL1PrL2DramDirectoryMOSI
       void enableModels();
       void disableModels();
 
+      void saveState(CheckpointWriter& checkpoint);
+      void restoreState(CheckpointReader& checkpoint);
+
       UInt32 getModeledLength(const void* pkt_data)
       { return ((ShmemMsg*) pkt_data)->getModeledLength(); }
       bool isModeled(const void* pkt_data)
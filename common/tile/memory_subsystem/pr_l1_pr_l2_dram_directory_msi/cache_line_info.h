@@ -9,6 +9,7 @@ namespace PrL1PrL2DramDirectoryMSI
 {
 
 CacheLineInfo* createCacheLineInfo(SInt32 cache_level);
+void createCacheLineInfoArray(SInt32 cache_level, UInt32 num_lines, CacheLineInfo** cache_line_info_array);
 
 typedef CacheLineInfo PrL1CacheLineInfo;
 
@@ -27,6 +28,9 @@ public:
    void invalidate();
    void assign(CacheLineInfo* cache_line_info);
 
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
 private:
    MemComponent::Type _cached_loc;
 };
@@ -43,6 +43,9 @@ namespace PrL1PrL2DramDirectoryMSI
       void enableModels();
       void disableModels();
 
+      void saveState(CheckpointWriter& checkpoint);
+      void restoreState(CheckpointReader& checkpoint);
+
       tile_id_t getShmemRequester(const void* pkt_data)
       { return ((ShmemMsg*) pkt_data)->getRequester(); }
       UInt32 getModeledLength(const void* pkt_data)
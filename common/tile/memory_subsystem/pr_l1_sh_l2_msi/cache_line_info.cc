@@ -1,4 +1,5 @@
 #include "cache_line_info.h"
+#include "l2_directory_cfg.h"
 #include "log.h"
 
 namespace PrL1ShL2MSI
@@ -18,6 +19,23 @@ CacheLineInfo* createCacheLineInfo(SInt32 cache_level)
    }
 }
 
+void
+createCacheLineInfoArray(SInt32 cache_level, UInt32 num_lines, CacheLineInfo** cache_line_info_array)
+{
+   switch (cache_level)
+   {
+   case L1:
+      CacheLineInfo::constructArray<PrL1CacheLineInfo>(num_lines, cache_line_info_array);
+      break;
+   case L2:
+      CacheLineInfo::constructArray<ShL2CacheLineInfo>(num_lines, cache_line_info_array);
+      break;
+   default:
+      LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
+      break;
+   }
+}
+
 // ShL2 CacheLineInfo
 
 ShL2CacheLineInfo::ShL2CacheLineInfo(IntPtr tag, DirectoryEntry* directory_entry)
@@ -38,4 +56,34 @@ ShL2CacheLineInfo::assign(CacheLineInfo* cache_line_info)
    _caching_component = L2_cache_line_info->getCachingComponent();
 }
 
+void
+ShL2CacheLineInfo::saveState(CheckpointWriter& checkpoint)
+{
+   CacheLineInfo::saveState(checkpoint);
+   checkpoint << _caching_component << (bool) (_directory_entry != NULL);
+   if (_directory_entry)
+      _directory_entry->saveState(checkpoint);
+}
+
+void
+ShL2CacheLineInfo::restoreState(CheckpointReader& checkpoint)
+{
+   CacheLineInfo::restoreState(checkpoint);
+
+   bool has_directory_entry;
+   checkpoint >> _caching_component >> has_directory_entry;
+
+   // Directory entries belong to the L2 cache controller, which keeps the
+   // live ones; the saved entry is only read past
+   if (has_directory_entry)
+   {
+      DirectoryEntry* directory_entry = DirectoryEntry::create(PR_L1_SH_L2_MSI,
+                                                               L2DirectoryCfg::getDirectoryType(),
+                                                               L2DirectoryCfg::getMaxHWSharers(),
+                                                               L2DirectoryCfg::getMaxNumSharers());
+      directory_entry->restoreState(checkpoint);
+      delete directory_entry;
+   }
+}
+
 }
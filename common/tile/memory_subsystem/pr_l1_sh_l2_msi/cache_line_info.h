@@ -8,6 +8,7 @@ namespace PrL1ShL2MSI
 {
 
 CacheLineInfo* createCacheLineInfo(SInt32 cache_level);
+void createCacheLineInfoArray(SInt32 cache_level, UInt32 num_lines, CacheLineInfo** cache_line_info_array);
 
 typedef CacheLineInfo PrL1CacheLineInfo;
 
@@ -18,6 +19,11 @@ public:
    ~ShL2CacheLineInfo();
 
    void assign(CacheLineInfo* cache_line_info);
+
+   // The directory entry of a valid line is saved along with it, but is
+   // not restored
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
    
    DirectoryEntry* getDirectoryEntry() const
    { return _directory_entry; }
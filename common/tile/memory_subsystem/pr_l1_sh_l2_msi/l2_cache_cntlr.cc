@@ -295,7 +295,7 @@ L2CacheCntlr::processNextReqFromL1Cache(IntPtr address)
    LOG_PRINT("Start processNextReqFromL1Cache(%#lx)", address);
    
    // Add 1 cycle to denote that we are moving to the next request
-   getShmemPerfModel()->incrCurrTime(Latency(1,_memory_manager->getTile()->getFrequency()));
+   getShmemPerfModel()->incrCurrTime(Latency(1,_memory_manager->getTile()->getFrequencyDomain()));
 
    assert(_L2_cache_req_queue.count(address) >= 1);
    
@@ -801,7 +801,7 @@ void
 L2CacheCntlr::restartShmemReq(ShmemReq* shmem_req, ShL2CacheLineInfo* L2_cache_line_info, Byte* data_buf)
 {
    // Add 1 cycle to denote that we are restarting the request
-   getShmemPerfModel()->incrCurrTime(Latency(1,_memory_manager->getTile()->getFrequency()));
+   getShmemPerfModel()->incrCurrTime(Latency(1,_memory_manager->getTile()->getFrequencyDomain()));
 
    // Update ShmemReq & ShmemPerfModel internal time
    shmem_req->updateTime(getShmemPerfModel()->getCurrTime());
@@ -425,6 +425,41 @@ MemoryManager::disableModels()
    ::MemoryManager::disableModels();
 }
 
+void
+MemoryManager::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_MEMORY_MANAGER);
+
+   _L1_cache_cntlr->getL1ICache()->saveState(checkpoint);
+   _L1_cache_cntlr->getL1DCache()->saveState(checkpoint);
+   _L2_cache_cntlr->getL2Cache()->saveState(checkpoint);
+
+   checkpoint << _dram_cntlr_present;
+   if (_dram_cntlr_present)
+   {
+      _dram_cntlr->saveState(checkpoint);
+   }
+}
+
+void
+MemoryManager::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.checkSection(CHECKPOINT_MEMORY_MANAGER);
+
+   _L1_cache_cntlr->getL1ICache()->restoreState(checkpoint);
+   _L1_cache_cntlr->getL1DCache()->restoreState(checkpoint);
+   _L2_cache_cntlr->getL2Cache()->restoreState(checkpoint);
+
+   bool dram_cntlr_present;
+   checkpoint >> dram_cntlr_present;
+   LOG_ASSERT_ERROR(dram_cntlr_present == _dram_cntlr_present,
+                    "Checkpoint has a different placement of memory controllers");
+   if (_dram_cntlr_present)
+   {
+      _dram_cntlr->restoreState(checkpoint);
+   }
+}
+
 void
 MemoryManager::outputSummary(std::ostream &os)
 {
@@ -3,7 +3,10 @@
 #include "network_model.h"
 #include "network_types.h"
 #include "memory_manager.h"
+#include "distributed_sync_server.h"
+#include "process_syscall_server.h"
 #include "main_core.h"
+#include "core_model.h"
 #include "simulator.h"
 #include "log.h"
 #include <string.h>
@@ -11,16 +14,26 @@
 Tile::Tile(tile_id_t id)
    : _id(id)
    , _memory_manager(NULL)
+   , _sync_server(NULL)
+   , _syscall_server(NULL)
 {
    LOG_PRINT("Tile ctor for (%i)", _id);
 
-   _frequency = Config::getSingleton()->getTileFrequency(_id);
+   setFrequency(Config::getSingleton()->getTileFrequency(_id));
    _network = new Network(this);
    _core = new MainCore(this);
    
    if (Config::getSingleton()->isSimulatingSharedMemory())
       _memory_manager = MemoryManager::createMMU(Sim()->getCfg()->getString("caching_protocol/type"), this);
 
+   // Mutexes are homed on the application tiles
+   if (DistributedSyncServer::isEnabled() && ((UInt32) _id < Config::getSingleton()->getApplicationTiles()))
+      _sync_server = new DistributedSyncServer(this);
+
+   // Process-local syscalls are served on the thread spawner tile of the process
+   if (SyscallServer::isPerProcessEnabled() && (_id == Config::getSingleton()->getCurrentThreadSpawnerTileNum()))
+      _syscall_server = new ProcessSyscallServer(this);
+
    // Register callback for clock frequency change
    getNetwork()->registerCallback(FREQ_CONTROL, TileFreqScalingCallback, this);
 }
@@ -29,6 +42,10 @@ Tile::~Tile()
 {
    getNetwork()->unregisterCallback(FREQ_CONTROL);
 
+   if (_syscall_server)
+      delete _syscall_server;
+   if (_sync_server)
+      delete _sync_server;
    if (_memory_manager)
       delete _memory_manager;
    delete _core;
@@ -81,6 +98,30 @@ void Tile::disableModels()
    LOG_PRINT("disableModels(%i) end", _id);
 }
 
+void Tile::saveState(CheckpointWriter& checkpoint)
+{
+   checkpoint.putSection(CHECKPOINT_TILE);
+   checkpoint << _id;
+
+   if (_core->getModel())
+      _core->getModel()->saveState(checkpoint);
+   if (_memory_manager)
+      _memory_manager->saveState(checkpoint);
+}
+
+void Tile::restoreState(CheckpointReader& checkpoint)
+{
+   checkpoint.checkSection(CHECKPOINT_TILE);
+   tile_id_t id;
+   checkpoint >> id;
+   LOG_ASSERT_ERROR(id == _id, "Restoring tile(%i) from the checkpoint of tile(%i)", _id, id);
+
+   if (_core->getModel())
+      _core->getModel()->restoreState(checkpoint);
+   if (_memory_manager)
+      _memory_manager->restoreState(checkpoint);
+}
+
 void
 Tile::updateInternalVariablesOnFrequencyChange(float old_frequency, float new_frequency)
 {
@@ -8,9 +8,13 @@ using std::ostream;
 class Network;
 class Core;
 class MemoryManager;
+class DistributedSyncServer;
+class ProcessSyscallServer;
 
 #include "fixed_types.h"
 #include "network.h"
+#include "time_types.h"
+#include "checkpoint_stream.h"
 
 void TileFreqScalingCallback(void* obj, NetPacket packet);
 
@@ -31,20 +35,30 @@ public:
    static bool isMainCore(core_id_t core_id)       { return (core_id.core_type == MAIN_CORE_TYPE); }
 
    float getFrequency() const          { return _frequency; }
-   void setFrequency(float frequency)  { _frequency = frequency; }
+   const FrequencyDomain& getFrequencyDomain() const  { return _frequency_domain; }
+   void setFrequency(float frequency)
+   { _frequency = frequency; _frequency_domain.setFrequency(frequency); }
 
    void updateInternalVariablesOnFrequencyChange(float old_frequency, float new_frequency);
 
    void enableModels();
    void disableModels();
 
+   void saveState(CheckpointWriter& checkpoint);
+   void restoreState(CheckpointReader& checkpoint);
+
 private:
    tile_id_t _id;
    Network* _network;
    Core* _core;
    MemoryManager* _memory_manager;
+   // NULL unless general/distributed_sync is set
+   DistributedSyncServer* _sync_server;
+   // NULL unless syscall_server/per_process is set and this is the thread spawner tile
+   ProcessSyscallServer* _syscall_server;
 
    float _frequency;
+   FrequencyDomain _frequency_domain;
 };
 
 #endif
@@ -0,0 +1,579 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "shmtransport.h"
+#include "packet_buffer_pool.h"
+#include "simulator.h"
+#include "config.h"
+#include "utils.h"
+#include "log.h"
+
+using std::string;
+
+ShmTransport::ShmTransport()
+   : m_barrier_sense(0)
+   , m_update_thread_state(RUNNING)
+{
+   getProcInfo();
+   initSegment();
+   initBufferLists();
+
+   m_update_thread = Thread::create(updateThreadFunc, this);
+   m_update_thread->run();
+
+   m_global_node = new ShmNode(GLOBAL_TAG, this);
+}
+
+ShmTransport::~ShmTransport()
+{
+   LOG_PRINT("dtor");
+
+   delete m_global_node;
+
+   m_update_thread_state = EXITING;
+   while (m_update_thread_state != EXITED)
+      sched_yield();
+   delete m_update_thread;
+
+   delete [] m_buffer_list_sems;
+   delete [] m_buffer_list_locks;
+   delete [] m_buffer_lists;
+
+   for (SInt32 i = 0; i < m_num_procs; i++)
+   {
+      if (m_partial_frames[i].m_buffer)
+         PacketBufferPool::release(m_partial_frames[i].m_buffer);
+   }
+   delete [] m_partial_frames;
+   delete [] m_send_locks;
+
+   munmap(m_header, m_segment_size);
+}
+
+bool ShmTransport::isColocated()
+{
+   UInt32 num_procs = Config::getSingleton()->getProcessCount();
+   string first_addr;
+
+   for (UInt32 proc = 0; proc < num_procs; proc++)
+   {
+      char proc_str[8];
+      snprintf(proc_str, 8, "%d", proc);
+      string server_string = "process_map/process";
+      server_string += proc_str;
+
+      string server_addr = Sim()->getCfg()->getString(server_string, "127.0.0.1");
+      if (proc == 0)
+         first_addr = server_addr;
+      else if (server_addr != first_addr)
+         return false;
+   }
+
+   return true;
+}
+
+void ShmTransport::getProcInfo()
+{
+   m_num_procs = (SInt32)Config::getSingleton()->getProcessCount();
+
+   const char *proc_index_str = getenv("CARBON_PROCESS_INDEX");
+   LOG_ASSERT_ERROR(proc_index_str != NULL || m_num_procs == 1,
+                    "Process index undefined with multiple processes.");
+
+   if (proc_index_str)
+      m_proc_index = atoi(proc_index_str);
+   else
+      m_proc_index = 0;
+
+   LOG_ASSERT_ERROR(0 <= m_proc_index && m_proc_index < m_num_procs,
+                    "Invalid process index: %d with num_procs: %d", m_proc_index, m_num_procs);
+
+   Config::getSingleton()->setProcessNum(m_proc_index);
+   LOG_PRINT("Process number set to %i", Config::getSingleton()->getCurrentProcessNum());
+}
+
+void ShmTransport::initSegment()
+{
+   m_ring_size = Sim()->getCfg()->getInt("transport/shm_ring_size", DEFAULT_RING_SIZE);
+   LOG_ASSERT_ERROR(isPower2(m_ring_size) && (m_ring_size >= CACHE_LINE_SIZE),
+                    "transport/shm_ring_size(%llu) must be a power of 2", m_ring_size);
+
+   // The segment is named after the user and the run, which the launcher
+   // identifies with a token that is passed to all of its processes
+   const char *run_id_str = getenv("CARBON_RUN_ID");
+   LOG_ASSERT_ERROR(run_id_str != NULL || m_num_procs == 1,
+                    "Run id undefined with multiple processes.");
+
+   char name[64];
+   if (run_id_str)
+      snprintf(name, sizeof(name), "/graphite_%u_%s", (UInt32) getuid(), run_id_str);
+   else
+      snprintf(name, sizeof(name), "/graphite_%u_%d", (UInt32) getuid(), (SInt32) getpid());
+   LOG_ASSERT_ERROR(strchr(name + 1, '/') == NULL, "Invalid run id: %s", run_id_str);
+   m_segment_name = name;
+
+   UInt32 num_rings = m_num_procs * m_num_procs;
+   UInt64 header_size = (sizeof(SegmentHeader) + CACHE_LINE_SIZE - 1) & ~((UInt64) CACHE_LINE_SIZE - 1);
+   m_segment_size = header_size + num_rings * (sizeof(Ring) + m_ring_size);
+
+   void *segment;
+   if (m_proc_index == 0)
+   {
+      // Only a segment left behind by a crashed run may be thrown away
+      SInt32 fd = shm_open(m_segment_name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+      if ((fd < 0) && (errno == EEXIST))
+      {
+         if (isSegmentStale())
+         {
+            shm_unlink(m_segment_name.c_str());
+            fd = shm_open(m_segment_name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+         }
+         else
+         {
+            LOG_PRINT_ERROR("Shared memory segment %s is in use by a running simulation", m_segment_name.c_str());
+         }
+      }
+      LOG_ASSERT_ERROR(fd >= 0, "Could not create shared memory segment %s", m_segment_name.c_str());
+      __attribute(__unused__) SInt32 err = ftruncate(fd, m_segment_size);
+      LOG_ASSERT_ERROR(err == 0, "Could not size shared memory segment %s to %llu bytes",
+                       m_segment_name.c_str(), m_segment_size);
+
+      segment = mmap(NULL, m_segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      LOG_ASSERT_ERROR(segment != MAP_FAILED, "Could not map shared memory segment %s", m_segment_name.c_str());
+      close(fd);
+
+      // A freshly sized segment is zero-filled, so the rings start out empty
+      m_header = (SegmentHeader*) segment;
+      m_header->m_magic = SEGMENT_MAGIC;
+      m_header->m_num_procs = m_num_procs;
+      m_header->m_ring_size = m_ring_size;
+      m_header->m_owner_pid = getpid();
+      __sync_synchronize();
+      m_header->m_ready = 1;
+   }
+   else
+   {
+      // Wait for process 0 to create, size and initialize the segment. Until
+      // it has replaced it, the name may still refer to a segment left behind
+      // by a crashed run, which must not be attached to
+      while (true)
+      {
+         SInt32 fd = shm_open(m_segment_name.c_str(), O_RDWR, 0);
+         if (fd >= 0)
+         {
+            struct stat st;
+            if ((fstat(fd, &st) == 0) && ((UInt64) st.st_size == m_segment_size))
+            {
+               segment = mmap(NULL, m_segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+               LOG_ASSERT_ERROR(segment != MAP_FAILED, "Could not map shared memory segment %s", m_segment_name.c_str());
+               close(fd);
+
+               if (waitForSegment((SegmentHeader*) segment, st.st_ino))
+                  break;
+               munmap(segment, m_segment_size);
+            }
+            else
+            {
+               close(fd);
+            }
+         }
+         usleep(1000);
+      }
+
+      m_header = (SegmentHeader*) segment;
+      LOG_ASSERT_ERROR(m_header->m_magic == SEGMENT_MAGIC &&
+                       m_header->m_num_procs == m_num_procs &&
+                       m_header->m_ring_size == m_ring_size,
+                       "Shared memory segment %s does not match this simulation", m_segment_name.c_str());
+   }
+
+   m_rings = (Ring*) ((Byte*) segment + header_size);
+   m_ring_data = (Byte*) (m_rings + num_rings);
+
+   // Once everybody is attached the name is no longer needed
+   __sync_add_and_fetch(&m_header->m_num_attached, 1);
+   if (m_proc_index == 0)
+   {
+      while (m_header->m_num_attached < m_num_procs)
+         sched_yield();
+      shm_unlink(m_segment_name.c_str());
+   }
+
+   m_send_locks = new Lock[m_num_procs];
+   m_partial_frames = new PartialFrame[m_num_procs];
+   for (SInt32 i = 0; i < m_num_procs; i++)
+   {
+      m_partial_frames[i].m_buffer = NULL;
+      m_partial_frames[i].m_received = 0;
+   }
+
+   LOG_PRINT("Mapped shared memory segment %s: %llu bytes", m_segment_name.c_str(), m_segment_size);
+}
+
+// Returns true once 'header' is initialized by process 0 of this run, and
+// false if it turns out to be stale
+bool ShmTransport::waitForSegment(SegmentHeader *header, ino_t inode)
+{
+   while (true)
+   {
+      // A stale segment may be fully initialized too, but its owner is gone
+      if (header->m_ready)
+         return isProcessAlive(header->m_owner_pid);
+
+      // Process 0 has replaced the segment under the name
+      SInt32 fd = shm_open(m_segment_name.c_str(), O_RDWR, 0);
+      if (fd < 0)
+         return false;
+      struct stat st;
+      bool replaced = (fstat(fd, &st) != 0) || (st.st_ino != inode);
+      close(fd);
+      if (replaced)
+         return false;
+
+      usleep(1000);
+   }
+}
+
+// Returns true if the segment under the name was created by a process that
+// has since died. One whose creator has not yet recorded its pid is in use
+bool ShmTransport::isSegmentStale()
+{
+   SInt32 fd = shm_open(m_segment_name.c_str(), O_RDONLY, 0);
+   if (fd < 0)
+      return (errno == ENOENT);
+
+   bool stale = false;
+   struct stat st;
+   if ((fstat(fd, &st) == 0) && ((UInt64) st.st_size >= sizeof(SegmentHeader)))
+   {
+      void *segment = mmap(NULL, sizeof(SegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+      if (segment != MAP_FAILED)
+      {
+         SInt32 owner_pid = ((SegmentHeader*) segment)->m_owner_pid;
+         stale = (owner_pid != 0) && !isProcessAlive(owner_pid);
+         munmap(segment, sizeof(SegmentHeader));
+      }
+   }
+   close(fd);
+   return stale;
+}
+
+bool ShmTransport::isProcessAlive(SInt32 pid)
+{
+   return (pid > 0) && ((kill(pid, 0) == 0) || (errno == EPERM));
+}
+
+void ShmTransport::initBufferLists()
+{
+   m_num_lists
+      = Config::getSingleton()->getTotalTiles() // for tiles
+      + 1; // for global node
+
+   m_buffer_lists = new buffer_list[m_num_lists];
+   m_buffer_list_locks = new Lock[m_num_lists];
+   m_buffer_list_sems = new Semaphore[m_num_lists];
+}
+
+void ShmTransport::insertInBufferList(SInt32 tag, Byte *buffer)
+{
+   if (tag == GLOBAL_TAG)
+      tag = m_num_lists - 1;
+
+   LOG_ASSERT_ERROR(0 <= tag && tag < m_num_lists, "Unexpected tag value: %d", tag);
+
+   m_buffer_list_locks[tag].acquire();
+   m_buffer_lists[tag].push_back(buffer);
+   m_buffer_list_locks[tag].release();
+
+   m_buffer_list_sems[tag].signal();
+}
+
+void ShmTransport::updateThreadFunc(void *vp)
+{
+   LOG_PRINT("Starting updateThreadFunc");
+
+   ShmTransport *st = (ShmTransport*)vp;
+
+   while (st->m_update_thread_state == RUNNING)
+   {
+      st->updateBufferLists();
+      sched_yield();
+   }
+
+   st->m_update_thread_state = EXITED;
+
+   LOG_PRINT("Leaving updateThreadFunc");
+}
+
+void ShmTransport::updateBufferLists()
+{
+   for (SInt32 proc = 0; proc < m_num_procs; proc++)
+   {
+      if (proc != m_proc_index)
+         receiveFrames(proc);
+   }
+}
+
+void ShmTransport::receiveFrames(SInt32 proc)
+{
+   Ring &ring = getRing(proc, m_proc_index);
+   const Byte *data = getRingData(proc, m_proc_index);
+   PartialFrame &frame = m_partial_frames[proc];
+
+   while (true)
+   {
+      UInt64 available = ring.m_tail - ring.m_head;
+
+      if (!frame.m_buffer)
+      {
+         if (available < sizeof(FrameHeader))
+            break;
+
+         ringRead(ring, data, &frame.m_header, sizeof(FrameHeader));
+         frame.m_buffer = PacketBufferPool::allocate(frame.m_header.length);
+         frame.m_received = 0;
+         continue;
+      }
+
+      // Frames larger than the ring arrive in several pieces
+      UInt32 length = frame.m_header.length - frame.m_received;
+      if (length > available)
+         length = available;
+
+      ringRead(ring, data, frame.m_buffer + frame.m_received, length);
+      frame.m_received += length;
+
+      if (frame.m_received < frame.m_header.length)
+         break;
+
+      insertInBufferList(frame.m_header.tag, frame.m_buffer);
+      frame.m_buffer = NULL;
+   }
+}
+
+void ShmTransport::sendFrame(SInt32 dest_proc, SInt32 tag, const void *buffer, UInt32 length)
+{
+   Ring &ring = getRing(m_proc_index, dest_proc);
+   Byte *data = getRingData(m_proc_index, dest_proc);
+
+   FrameHeader header;
+   header.length = length;
+   header.tag = tag;
+
+   // The lock keeps the frames of different threads from interleaving
+   m_send_locks[dest_proc].acquire();
+   ringWrite(ring, data, &header, sizeof(header));
+   ringWrite(ring, data, buffer, length);
+   m_send_locks[dest_proc].release();
+}
+
+void ShmTransport::ringWrite(Ring &ring, Byte *data, const void *buffer, UInt32 length)
+{
+   const Byte *src = (const Byte*) buffer;
+
+   while (length > 0)
+   {
+      UInt64 tail = ring.m_tail;
+      UInt64 space = m_ring_size - (tail - ring.m_head);
+      if (space == 0)
+      {
+         // The receiving update thread drains the ring without blocking
+         sched_yield();
+         continue;
+      }
+
+      UInt32 chunk = (length < space) ? length : space;
+      UInt64 offset = tail & (m_ring_size - 1);
+      UInt64 first = m_ring_size - offset;
+      if (first >= chunk)
+      {
+         memcpy(data + offset, src, chunk);
+      }
+      else
+      {
+         memcpy(data + offset, src, first);
+         memcpy(data, src + first, chunk - first);
+      }
+
+      // Publish the bytes only after they are in place
+      __sync_synchronize();
+      ring.m_tail = tail + chunk;
+
+      src += chunk;
+      length -= chunk;
+   }
+}
+
+void ShmTransport::ringRead(Ring &ring, const Byte *data, void *buffer, UInt32 length)
+{
+   // Caller has checked that 'length' bytes are available
+   Byte *dest = (Byte*) buffer;
+   UInt64 head = ring.m_head;
+   UInt64 offset = head & (m_ring_size - 1);
+   UInt64 first = m_ring_size - offset;
+
+   __sync_synchronize();
+   if (first >= length)
+   {
+      memcpy(dest, data + offset, length);
+   }
+   else
+   {
+      memcpy(dest, data + offset, first);
+      memcpy(dest + first, data, length - first);
+   }
+
+   // Hand the space back only after the bytes are copied out
+   __sync_synchronize();
+   ring.m_head = head + length;
+}
+
+ShmTransport::Ring& ShmTransport::getRing(SInt32 src_proc, SInt32 dest_proc)
+{
+   return m_rings[src_proc * m_num_procs + dest_proc];
+}
+
+Byte* ShmTransport::getRingData(SInt32 src_proc, SInt32 dest_proc)
+{
+   return m_ring_data + (src_proc * m_num_procs + dest_proc) * m_ring_size;
+}
+
+Transport::Node* ShmTransport::createNode(tile_id_t tile_id)
+{
+   return new ShmNode(tile_id, this);
+}
+
+void ShmTransport::barrier()
+{
+   // Sense-reversing barrier on the shared segment. As with
+   // SockTransport::barrier(), only one thread per process enters it.
+
+   LOG_PRINT("Entering transport barrier");
+
+   m_barrier_sense = !m_barrier_sense;
+
+   if (__sync_add_and_fetch(&m_header->m_barrier_count, 1) == m_num_procs)
+   {
+      m_header->m_barrier_count = 0;
+      __sync_synchronize();
+      m_header->m_barrier_sense = m_barrier_sense;
+   }
+   else
+   {
+      while (m_header->m_barrier_sense != m_barrier_sense)
+         sched_yield();
+   }
+
+   LOG_PRINT("Exiting transport barrier");
+}
+
+Transport::Node* ShmTransport::getGlobalNode()
+{
+   return m_global_node;
+}
+
+// -- ShmTransport::ShmNode
+
+ShmTransport::ShmNode::ShmNode(tile_id_t tile_id, ShmTransport *trans)
+   : Node(tile_id)
+   , m_transport(trans)
+{
+}
+
+ShmTransport::ShmNode::~ShmNode()
+{
+}
+
+void ShmTransport::ShmNode::globalSend(SInt32 dest_proc,
+                                       const void *buffer,
+                                       UInt32 length)
+{
+   Byte *buff_cpy = PacketBufferPool::allocate(length);
+   memcpy(buff_cpy, buffer, length);
+   send(dest_proc, GLOBAL_TAG, buff_cpy, length);
+}
+
+void ShmTransport::ShmNode::send(tile_id_t dest_tile,
+                                 const void *buffer,
+                                 UInt32 length)
+{
+   Byte *buff_cpy = PacketBufferPool::allocate(length);
+   memcpy(buff_cpy, buffer, length);
+   sendBuffer(dest_tile, buff_cpy, length);
+}
+
+void ShmTransport::ShmNode::sendBuffer(tile_id_t dest_tile,
+                                       Byte *buffer,
+                                       UInt32 length)
+{
+   SInt32 dest_proc = Config::getSingleton()->getProcessNumForTile(dest_tile);
+   send(dest_proc, dest_tile, buffer, length);
+}
+
+void ShmTransport::ShmNode::send(SInt32 dest_proc,
+                                 SInt32 tag,
+                                 Byte *buffer,
+                                 UInt32 length)
+{
+   // two cases:
+   // (1) remote process, copy into the shared ring
+   // (2) single process, put directly in buffer list
+
+   if (dest_proc == m_transport->m_proc_index)
+   {
+      m_transport->insertInBufferList(tag, buffer);
+   }
+   else
+   {
+      m_transport->sendFrame(dest_proc, tag, buffer, length);
+      PacketBufferPool::release(buffer);
+   }
+
+   LOG_PRINT("Message sent.");
+}
+
+Byte* ShmTransport::ShmNode::recv()
+{
+   LOG_PRINT("Entering recv");
+
+   tile_id_t tag = getTileId();
+   tag = (tag == GLOBAL_TAG) ? m_transport->m_num_lists - 1 : tag;
+
+   m_transport->m_buffer_list_sems[tag].wait();
+
+   Lock &lock = m_transport->m_buffer_list_locks[tag];
+   lock.acquire();
+
+   buffer_list &list = m_transport->m_buffer_lists[tag];
+   LOG_ASSERT_ERROR(!list.empty(), "Buffer list empty after waiting on semaphore.");
+   Byte* buffer = list.front();
+   list.pop_front();
+
+   lock.release();
+
+   LOG_PRINT("Message recv'd");
+
+   return buffer;
+}
+
+bool ShmTransport::ShmNode::query()
+{
+   tile_id_t tag = getTileId();
+   tag = (tag == GLOBAL_TAG) ? m_transport->m_num_lists - 1 : tag;
+
+   buffer_list &list = m_transport->m_buffer_lists[tag];
+   Lock &lock = m_transport->m_buffer_list_locks[tag];
+
+   lock.acquire();
+   bool result = !list.empty();
+   lock.release();
+   return result;
+}
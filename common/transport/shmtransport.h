@@ -0,0 +1,148 @@
+#ifndef SHM_TRANSPORT_H
+#define SHM_TRANSPORT_H
+
+#include "transport.h"
+#include "thread.h"
+#include "semaphore.h"
+#include "lock.h"
+
+#include <list>
+#include <string>
+
+// Transport between processes running on the same host
+//
+// All processes map one POSIX shared-memory segment holding a
+// single-producer, single-consumer byte ring for every ordered pair of
+// processes. Senders in a process serialize on a per-destination lock, and a
+// per-process update thread drains the incoming rings into per-tile buffer
+// lists, the same way SockTransport does with its sockets. Messages between
+// tiles of the same process never touch shared memory.
+
+class ShmTransport : public Transport
+{
+public:
+   ShmTransport();
+   ~ShmTransport();
+
+   class ShmNode : public Node
+   {
+   public:
+      ShmNode(tile_id_t tile_id, ShmTransport *trans);
+      ~ShmNode();
+
+      void globalSend(SInt32 dest_proc, const void *buffer, UInt32 length);
+      void send(tile_id_t dest_tile, const void *buffer, UInt32 length);
+      void sendBuffer(tile_id_t dest_tile, Byte *buffer, UInt32 length);
+      Byte* recv();
+      bool query();
+
+   private:
+      void send(SInt32 dest_proc, SInt32 tag, Byte *buffer, UInt32 length);
+
+      ShmTransport *m_transport;
+   };
+
+   Node *createNode(tile_id_t tile_id);
+
+   void barrier();
+   Node *getGlobalNode();
+
+   // All processes in [process_map] have the same address
+   static bool isColocated();
+
+private:
+   static const SInt32 GLOBAL_TAG = -1;
+   static const UInt32 CACHE_LINE_SIZE = 64;
+   static const UInt32 SEGMENT_MAGIC = 0x47534d54;
+   static const UInt32 DEFAULT_RING_SIZE = 1 << 20;
+
+   struct FrameHeader
+   {
+      UInt32 length;
+      SInt32 tag;
+   } __attribute__((__packed__));
+
+   // Ring indices only ever increase; the producer and consumer ones are
+   // kept on separate cache lines
+   struct Ring
+   {
+      volatile UInt64 m_tail;
+      char m_tail_padding[CACHE_LINE_SIZE - sizeof(UInt64)];
+      volatile UInt64 m_head;
+      char m_head_padding[CACHE_LINE_SIZE - sizeof(UInt64)];
+   };
+
+   struct SegmentHeader
+   {
+      UInt32 m_magic;
+      SInt32 m_num_procs;
+      UInt64 m_ring_size;
+      // Process 0 of the run that created the segment, set before m_ready
+      volatile SInt32 m_owner_pid;
+      volatile SInt32 m_ready;
+      volatile SInt32 m_num_attached;
+      volatile SInt32 m_barrier_count;
+      volatile SInt32 m_barrier_sense;
+   };
+
+   // A frame that has only partially arrived in its ring
+   struct PartialFrame
+   {
+      FrameHeader m_header;
+      Byte *m_buffer;
+      UInt32 m_received;
+   };
+
+   enum UpdateThreadState
+   {
+      RUNNING,
+      EXITING,
+      EXITED
+   };
+
+   void getProcInfo();
+   void initSegment();
+   bool waitForSegment(SegmentHeader *header, ino_t inode);
+   bool isSegmentStale();
+   static bool isProcessAlive(SInt32 pid);
+   void initBufferLists();
+   void insertInBufferList(SInt32 tag, Byte *buffer);
+
+   static void updateThreadFunc(void *vp);
+   void updateBufferLists();
+   void receiveFrames(SInt32 proc);
+
+   void sendFrame(SInt32 dest_proc, SInt32 tag, const void *buffer, UInt32 length);
+   void ringWrite(Ring &ring, Byte *data, const void *buffer, UInt32 length);
+   void ringRead(Ring &ring, const Byte *data, void *buffer, UInt32 length);
+
+   Ring& getRing(SInt32 src_proc, SInt32 dest_proc);
+   Byte* getRingData(SInt32 src_proc, SInt32 dest_proc);
+
+   Node *m_global_node;
+
+   SInt32 m_num_procs;
+   SInt32 m_proc_index;
+
+   std::string m_segment_name;
+   UInt64 m_segment_size;
+   SegmentHeader *m_header;
+   Ring *m_rings;
+   Byte *m_ring_data;
+   UInt64 m_ring_size;
+   SInt32 m_barrier_sense;
+
+   Lock *m_send_locks;
+   PartialFrame *m_partial_frames;
+
+   Thread *m_update_thread;
+   volatile UpdateThreadState m_update_thread_state;
+
+   typedef std::list<Byte*> buffer_list;
+   SInt32 m_num_lists;
+   buffer_list *m_buffer_lists;
+   Lock *m_buffer_list_locks;
+   Semaphore *m_buffer_list_sems;
+};
+
+#endif // SHM_TRANSPORT_H
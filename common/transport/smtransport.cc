@@ -1,6 +1,7 @@
 #include <string.h>
 
 #include "smtransport.h"
+#include "packet_buffer_pool.h"
 #include "config.h"
 #include "log.h"
 
@@ -78,7 +79,7 @@ SmTransport::SmNode::SmNode(tile_id_t tile_id, SmTransport *smt)
 
 SmTransport::SmNode::~SmNode()
 {
-   LOG_ASSERT_WARNING(m_queue.empty(), "Unread messages in queue for tile: %d", getTileId());
+   LOG_ASSERT_WARNING(m_mailbox.empty(), "Unread messages in queue for tile: %d", getTileId());
    m_smt->clearNodeForId(getTileId());
 }
 
@@ -89,57 +90,58 @@ void SmTransport::SmNode::globalSend(SInt32 dest_proc, const void *buffer, UInt3
 }
 
 void SmTransport::SmNode::send(SInt32 dest_id, const void* buffer, UInt32 length)
+{
+   send(getNode(dest_id), buffer, length);
+}
+
+void SmTransport::SmNode::sendBuffer(SInt32 dest_id, Byte* buffer, UInt32 length)
+{
+   SmNode *dest_node = getNode(dest_id);
+
+   // Same address space, so the buffer itself becomes the message
+   LOG_PRINT("sending buffer -- size: %i, data: %p, dest: %p", length, buffer, dest_node);
+
+   dest_node->m_mailbox.push(buffer);
+}
+
+SmTransport::SmNode* SmTransport::SmNode::getNode(SInt32 dest_id)
 {
    SmNode *dest_node = m_smt->getNodeFromId(dest_id);
    LOG_ASSERT_ERROR(dest_node != NULL, "Attempt to send to non-existent node: %d", dest_id);
-   send(dest_node, buffer, length);
+   return dest_node;
 }
 
 void SmTransport::SmNode::send(SmNode *dest_node, const void *buffer, UInt32 length)
 {
-   Byte *data = new Byte[length];
+   Byte *data = PacketBufferPool::allocate(length);
    memcpy(data, buffer, length);
 
    LOG_PRINT("sending msg -- size: %i, data: %p, dest: %p", length, data, dest_node);
 
-   dest_node->m_lock.acquire();
-   dest_node->m_queue.push(data);
-   dest_node->m_lock.release();
-   dest_node->m_cond.broadcast();
+   dest_node->m_mailbox.push(data);
 }
 
 Byte* SmTransport::SmNode::recv()
 {
    LOG_PRINT("attempting recv -- this: %p", this);
 
-   m_lock.acquire();
-
-   while (true)
-   {
-      if (!m_queue.empty())
-      {
-         Byte *data = m_queue.front();
-         m_queue.pop();
-         m_lock.release();
+   Byte *data = m_mailbox.pop();
 
-         LOG_PRINT("msg recv'd -- data: %p, this: %p", data, this);
+   LOG_PRINT("msg recv'd -- data: %p, this: %p", data, this);
 
-         return data;
-      }
-      else
-      {
-         m_cond.wait(m_lock);
-      }
-   }
+   return data;
 }
 
-bool SmTransport::SmNode::query()
+UInt32 SmTransport::SmNode::recvMany(Byte** buffers, UInt32 max_buffers)
 {
-   bool result = false;
+   UInt32 num_buffers = m_mailbox.popMany(buffers, max_buffers);
 
-   m_lock.acquire();
-   result = !m_queue.empty();
-   m_lock.release();
+   LOG_PRINT("%u msgs recv'd -- this: %p", num_buffers, this);
 
-   return result;
+   return num_buffers;
+}
+
+bool SmTransport::SmNode::query()
+{
+   return !m_mailbox.empty();
 }
@@ -1,10 +1,8 @@
 #ifndef SMTRANSPORT_H
 #define SMTRANSPORT_H
 
-#include <queue>
-
 #include "transport.h"
-#include "cond.h"
+#include "mailbox.h"
 
 class SmTransport : public Transport
 {
@@ -20,15 +18,16 @@ public:
 
       void globalSend(SInt32, const void*, UInt32);
       void send(tile_id_t, const void*, UInt32);
+      void sendBuffer(tile_id_t, Byte*, UInt32);
       Byte* recv();
+      UInt32 recvMany(Byte** buffers, UInt32 max_buffers);
       bool query();
 
    private:
       void send(SmNode *dest, const void *buffer, UInt32 length);
+      SmNode* getNode(tile_id_t dest_id);
 
-      std::queue<Byte*> m_queue;
-      Lock m_lock;
-      ConditionVariable m_cond;
+      Mailbox m_mailbox;
       SmTransport *m_smt;
    };
 
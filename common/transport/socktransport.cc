@@ -9,11 +9,15 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <sched.h>
+#include <sys/uio.h>
+#include <sys/time.h>
+#include <netinet/tcp.h>
 
 #include "log.h"
 #include "config.h"
 #include "simulator.h" //interface to config file singleton
 #include "socktransport.h"
+#include "packet_buffer_pool.h"
 
 // #define __CHECKSUM_ENABLED__     1
 
@@ -27,10 +31,13 @@ SockTransport::SockTransport()
    : m_update_thread_state(RUNNING)
 {
    m_base_port = Sim()->getCfg()->getInt("transport/base_port", DEFAULT_BASE_PORT);
+   m_flush_interval = Sim()->getCfg()->getInt("transport/flush_interval", 0);
+   m_flush_size = Sim()->getCfg()->getInt("transport/flush_size", DEFAULT_FLUSH_SIZE);
 
    getProcInfo();
    initSockets();
    initBufferLists();
+   initStreams();
 
    m_update_thread = Thread::create(updateThreadFunc, this);
    m_update_thread->run();
@@ -90,6 +97,8 @@ void SockTransport::initSockets()
       }
 
       m_send_sockets[proc].connect(server_addr.c_str(), m_base_port + proc);
+      // Messages are coalesced in the send queues, so do not delay them further
+      m_send_sockets[proc].setNoDelay();
 
       m_send_sockets[proc].send(&m_proc_index, sizeof(m_proc_index));
    }
@@ -129,6 +138,20 @@ void SockTransport::initBufferLists()
    m_buffer_list_sems = new Semaphore[m_num_lists];
 }
 
+void SockTransport::initStreams()
+{
+   m_send_queues = new SendQueue[m_num_procs];
+
+   m_recv_streams = new RecvStream[m_num_procs];
+   for (SInt32 i = 0; i < m_num_procs; i++)
+   {
+      m_recv_streams[i].m_buffer = (Byte*) malloc(RECV_BUFFER_SIZE);
+      m_recv_streams[i].m_capacity = RECV_BUFFER_SIZE;
+      m_recv_streams[i].m_begin = 0;
+      m_recv_streams[i].m_end = 0;
+   }
+}
+
 void SockTransport::updateThreadFunc(void *vp)
 {
    LOG_PRINT("Starting updateThreadFunc");
@@ -138,6 +161,7 @@ void SockTransport::updateThreadFunc(void *vp)
    while (st->m_update_thread_state == RUNNING)
    {
       st->updateBufferLists();
+      st->flushSendQueues(true);
       sched_yield();
    }
 
@@ -150,71 +174,256 @@ void SockTransport::updateBufferLists()
 {
    for (SInt32 i = 0; i < m_num_procs; i++)
    {
-      while (true)
+      if (!receiveFrames(i))
+         return;
+   }
+}
+
+bool SockTransport::receiveFrames(SInt32 proc)
+{
+   RecvStream &stream = m_recv_streams[proc];
+   bool running = true;
+   UInt32 space;
+   UInt32 recvd;
+
+   m_recv_locks[proc].acquire();
+
+   do
+   {
+      // Pull everything that is available in as few reads as possible
+      if (stream.m_end == stream.m_capacity)
+         reserveRecvStream(stream, stream.m_capacity - stream.m_begin + 1);
+
+      space = stream.m_capacity - stream.m_end;
+      recvd = m_recv_sockets[proc].recvSome(stream.m_buffer + stream.m_end, space);
+      stream.m_end += recvd;
+
+      // Hand out all complete frames
+      while (running)
       {
-         UInt32 length;
+         UInt32 available = stream.m_end - stream.m_begin;
+         if (available < sizeof(FrameHeader))
+            break;
 
-         m_recv_locks[i].acquire();
+         FrameHeader header;
+         memcpy(&header, stream.m_buffer + stream.m_begin, sizeof(header));
+
+         UInt32 frame_size = sizeof(FrameHeader) + header.length;
+#ifdef __CHECKSUM_ENABLED__
+         if (hasChecksum(header.tag))
+            frame_size += sizeof(UInt64);
+#endif // __CHECKSUM_ENABLED__
 
-         // first get packet length, abort if none available
-         if (!m_recv_sockets[i].recv(&length, sizeof(length), false))
+         if (available < frame_size)
          {
-            m_recv_locks[i].release();
+            // Partial frame, make sure the remainder fits in the buffer
+            reserveRecvStream(stream, frame_size);
             break;
          }
 
-         // now receive tag
-         SInt32 tag;
-         m_recv_sockets[i].recv(&tag, sizeof(tag), true);
-
-         // now receive packet
-         Byte *buffer = new Byte[length];
-         m_recv_sockets[i].recv(buffer, length, true);
+         Byte *buffer = PacketBufferPool::allocate(header.length);
+         memcpy(buffer, stream.m_buffer + stream.m_begin + sizeof(FrameHeader), header.length);
 
-#ifdef __CHECKSUM_ENABLED__
-         // now receive checksum
          UInt64 checksum = 0;
-         if ((tag != TERMINATE_TAG) && (tag != BARRIER_TAG))
-         {
-            m_recv_sockets[i].recv(&checksum, sizeof(checksum), true);
-         }
+#ifdef __CHECKSUM_ENABLED__
+         if (hasChecksum(header.tag))
+            memcpy(&checksum, stream.m_buffer + stream.m_begin + sizeof(FrameHeader) + header.length, sizeof(checksum));
 #endif // __CHECKSUM_ENABLED__
+         running = processFrame(proc, header.tag, buffer, header.length, checksum);
 
-         m_recv_locks[i].release();
+         stream.m_begin += frame_size;
+      }
 
-         switch (tag)
-         {
-         case TERMINATE_TAG:
-            LOG_PRINT("Quit message received.");
-            LOG_ASSERT_ERROR(m_update_thread_state == RUNNING, "Terminate received in unexpected state: %d", m_update_thread_state);
-            LOG_ASSERT_ERROR(i == m_proc_index, "Terminate received from unexpected process: %d != %d", i, m_proc_index);
-            m_update_thread_state = EXITING;
-
-            delete [] buffer;
-            return;
-
-         case BARRIER_TAG:
-            m_barrier_sem.signal();
-            LOG_ASSERT_ERROR(i == (m_proc_index + m_num_procs - 1) % m_num_procs,
-                             "Barrier update from unexpected process: %d", i);
-            delete [] buffer;
-            break;
+      if (stream.m_begin == stream.m_end)
+         stream.m_begin = stream.m_end = 0;
+   }
+   while (running && (recvd == space));
+
+   m_recv_locks[proc].release();
+
+   return running;
+}
+
+void SockTransport::reserveRecvStream(RecvStream &stream, UInt32 size)
+{
+   if (stream.m_capacity - stream.m_begin >= size)
+      return;
+
+   // Move the pending bytes to the front, growing the buffer if a single
+   // frame does not fit
+   memmove(stream.m_buffer, stream.m_buffer + stream.m_begin, stream.m_end - stream.m_begin);
+   stream.m_end -= stream.m_begin;
+   stream.m_begin = 0;
+
+   if (stream.m_capacity < size)
+   {
+      while (stream.m_capacity < size)
+         stream.m_capacity *= 2;
+      stream.m_buffer = (Byte*) realloc(stream.m_buffer, stream.m_capacity);
+      LOG_ASSERT_ERROR(stream.m_buffer != NULL, "Could not grow receive buffer to %u bytes", stream.m_capacity);
+   }
+}
 
-         case GLOBAL_TAG:
-         default:
+bool SockTransport::processFrame(SInt32 proc, SInt32 tag, Byte *buffer, UInt32 length, UInt64 checksum)
+{
+   switch (tag)
+   {
+   case TERMINATE_TAG:
+      LOG_PRINT("Quit message received.");
+      LOG_ASSERT_ERROR(m_update_thread_state == RUNNING, "Terminate received in unexpected state: %d", m_update_thread_state);
+      LOG_ASSERT_ERROR(proc == m_proc_index, "Terminate received from unexpected process: %d != %d", proc, m_proc_index);
+      m_update_thread_state = EXITING;
+
+      PacketBufferPool::release(buffer);
+      return false;
+
+   case BARRIER_TAG:
+      m_barrier_sem.signal();
+      LOG_ASSERT_ERROR(proc == (m_proc_index + m_num_procs - 1) % m_num_procs,
+                       "Barrier update from unexpected process: %d", proc);
+      PacketBufferPool::release(buffer);
+      return true;
+
+   case GLOBAL_TAG:
+   default:
 #ifdef __CHECKSUM_ENABLED__
-            Header* header = new Header(length, checksum);
-            insertInBufferList(tag, buffer, header);
+      Header* header = new Header(length, checksum);
+      insertInBufferList(tag, buffer, header);
 #else
-            insertInBufferList(tag, buffer);
+      insertInBufferList(tag, buffer);
 #endif // __CHECKSUM_ENABLED__
-            // do NOT delete buffer
-            break;
-         };
+      // do NOT delete buffer
+      return true;
+   };
+}
+
+void SockTransport::enqueueFrame(SInt32 dest_proc, SInt32 tag, Byte *buffer, UInt32 length, bool flush)
+{
+   Lock &lock = m_send_locks[dest_proc];
+   SendQueue &queue = m_send_queues[dest_proc];
+
+   lock.acquire();
+
+   if (queue.m_num_frames == MAX_BATCH_FRAMES)
+      flushSendQueue(dest_proc);
+
+   UInt32 frame = queue.m_num_frames ++;
+   if (frame == 0)
+      queue.m_oldest_time = getTime();
+
+   // Length, Tag, Data, (Checksum)
+   queue.m_headers[frame].length = length;
+   queue.m_headers[frame].tag = tag;
+   queue.m_buffers[frame] = buffer;
+
+   struct iovec *iov = &queue.m_iovecs[queue.m_num_iovecs];
+   iov[0].iov_base = &queue.m_headers[frame];
+   iov[0].iov_len = sizeof(FrameHeader);
+   iov[1].iov_base = buffer;
+   iov[1].iov_len = length;
+   queue.m_num_iovecs += 2;
+   queue.m_num_bytes += sizeof(FrameHeader) + length;
+
+#ifdef __CHECKSUM_ENABLED__
+   if (hasChecksum(tag))
+   {
+      queue.m_checksums[frame] = computeCheckSum(buffer, length);
+      iov[2].iov_base = &queue.m_checksums[frame];
+      iov[2].iov_len = sizeof(UInt64);
+      queue.m_num_iovecs ++;
+      queue.m_num_bytes += sizeof(UInt64);
+   }
+#endif // __CHECKSUM_ENABLED__
+
+   if (flush || (queue.m_num_bytes >= m_flush_size))
+      flushSendQueue(dest_proc);
+
+   lock.release();
+}
+
+bool SockTransport::flushSendQueue(SInt32 dest_proc, bool block)
+{
+   // Caller holds m_send_locks[dest_proc]
+   SendQueue &queue = m_send_queues[dest_proc];
+
+   if (queue.m_num_frames == 0)
+      return true;
+
+   struct iovec *iov = &queue.m_iovecs[queue.m_first_iovec];
+   UInt32 count = queue.m_num_iovecs - queue.m_first_iovec;
+
+   if (block)
+   {
+      m_send_sockets[dest_proc].send(iov, count);
+   }
+   else
+   {
+      // Keep whatever did not fit in the socket buffer for the next try
+      UInt32 sent = m_send_sockets[dest_proc].sendSome(iov, count);
+
+      while ((queue.m_first_iovec < queue.m_num_iovecs) && (sent >= iov->iov_len))
+      {
+         sent -= iov->iov_len;
+         iov ++;
+         queue.m_first_iovec ++;
+      }
+      if (queue.m_first_iovec < queue.m_num_iovecs)
+      {
+         iov->iov_base = (Byte*) iov->iov_base + sent;
+         iov->iov_len -= sent;
+         return false;
+      }
+   }
+
+   for (UInt32 i = 0; i < queue.m_num_frames; i++)
+      PacketBufferPool::release(queue.m_buffers[i]);
+
+   queue.m_num_frames = 0;
+   queue.m_first_iovec = 0;
+   queue.m_num_iovecs = 0;
+   queue.m_num_bytes = 0;
+   return true;
+}
+
+void SockTransport::flushSendQueues(bool stale_only)
+{
+   UInt64 now = stale_only ? getTime() : 0;
+
+   for (SInt32 proc = 0; proc < m_num_procs; proc++)
+   {
+      SendQueue &queue = m_send_queues[proc];
+
+      // Unlocked peek; re-checked below
+      if (queue.m_num_frames == 0)
+         continue;
+
+      if (stale_only)
+      {
+         // Called from the update thread, which must never block on a
+         // peer that is itself waiting for us to drain its frames. Skip
+         // queues another thread is busy with and write what fits.
+         if (!m_send_locks[proc].tryLock())
+            continue;
+         if (now - queue.m_oldest_time >= m_flush_interval)
+            flushSendQueue(proc, false);
+         m_send_locks[proc].release();
+      }
+      else
+      {
+         m_send_locks[proc].acquire();
+         flushSendQueue(proc);
+         m_send_locks[proc].release();
       }
    }
 }
 
+UInt64 SockTransport::getTime()
+{
+   struct timeval t;
+   gettimeofday(&t, NULL);
+   return (((UInt64) t.tv_sec) * 1000000 + t.tv_usec);
+}
+
 void SockTransport::insertInBufferList(SInt32 tag, Byte *buffer, Header* header)
 {
    if (tag == GLOBAL_TAG)
@@ -254,6 +463,7 @@ SockTransport::~SockTransport()
 
    delete m_global_node;
 
+   flushSendQueues(false);
    terminateUpdateThread();
    delete m_update_thread;
 
@@ -266,6 +476,11 @@ SockTransport::~SockTransport()
 
    delete [] m_buffer_lists;
 
+   for (SInt32 i = 0; i < m_num_procs; i++)
+      free(m_recv_streams[i].m_buffer);
+   delete [] m_recv_streams;
+   delete [] m_send_queues;
+
    for (SInt32 i = 0; i < m_num_procs; i++)
    {
       m_recv_sockets[i].close();
@@ -300,22 +515,31 @@ void SockTransport::barrier()
 
    LOG_PRINT("Entering transport barrier");
 
-   Socket &sock = m_send_sockets[(m_proc_index+1) % m_num_procs];
-   SInt32 message[] = { sizeof(SInt32), BARRIER_TAG, 0 };
+   SInt32 next_proc = (m_proc_index+1) % m_num_procs;
+
+   // Everything sent before the barrier goes out before it
+   flushSendQueues(false);
 
    if (m_proc_index != 0)
       m_barrier_sem.wait();
 
-   sock.send(message, sizeof(message));
+   sendBarrierMessage(next_proc);
 
    m_barrier_sem.wait();
 
    if (m_proc_index != m_num_procs - 1)
-      sock.send(message, sizeof(message));
+      sendBarrierMessage(next_proc);
 
    LOG_PRINT("Exiting transport barrier");
 }
 
+void SockTransport::sendBarrierMessage(SInt32 dest_proc)
+{
+   Byte *message = PacketBufferPool::allocate(sizeof(SInt32));
+   *((SInt32*) message) = 0;
+   enqueueFrame(dest_proc, BARRIER_TAG, message, sizeof(SInt32), true);
+}
+
 Transport::Node* SockTransport::getGlobalNode()
 {
    return m_global_node;
@@ -348,6 +572,30 @@ void SockTransport::SockNode::send(tile_id_t dest_tile,
    send(dest_proc, dest_tile, buffer, length);
 }
 
+void SockTransport::SockNode::sendBuffer(tile_id_t dest_tile,
+                                         Byte *buffer,
+                                         UInt32 length)
+{
+   int dest_proc = Config::getSingleton()->getProcessNumForTile(dest_tile);
+
+   if (dest_proc == m_transport->m_proc_index)
+   {
+      // Same process, queue the buffer itself
+#ifdef __CHECKSUM_ENABLED__
+      Header* header = new Header(length, computeCheckSum(buffer, length));
+      m_transport->insertInBufferList(dest_tile, buffer, header);
+#else
+      m_transport->insertInBufferList(dest_tile, buffer);
+#endif // __CHECKSUM_ENABLED__
+
+      LOG_PRINT("Message sent.");
+   }
+   else
+   {
+      m_transport->enqueueFrame(dest_proc, dest_tile, buffer, length, false);
+   }
+}
+
 Byte* SockTransport::SockNode::recv()
 {
    LOG_PRINT("Entering recv");
@@ -404,20 +652,16 @@ void SockTransport::SockNode::send(SInt32 dest_proc,
                                    UInt32 length)
 {
    // two cases:
-   // (1) remote process, use sockets
+   // (1) remote process, queue for the socket
    // (2) single process, put directly in buffer list
 
-#ifdef __CHECKSUM_ENABLED__
-   UInt64 checksum =  computeCheckSum((const Byte*) buffer, length);
-#endif // __CHECKSUM_ENABLED__
+   Byte *buff_cpy = PacketBufferPool::allocate(length);
+   memcpy(buff_cpy, buffer, length);
 
    if (dest_proc == m_transport->m_proc_index)
    {
-      Byte *buff_cpy = new Byte[length];
-      memcpy(buff_cpy, buffer, length);
-
 #ifdef __CHECKSUM_ENABLED__
-      Header* header =  new Header(length, checksum);
+      Header* header =  new Header(length, computeCheckSum(buff_cpy, length));
       m_transport->insertInBufferList(tag, buff_cpy, header);
 #else
       m_transport->insertInBufferList(tag, buff_cpy);
@@ -425,30 +669,7 @@ void SockTransport::SockNode::send(SInt32 dest_proc,
    }
    else
    {
-#ifdef __CHECKSUM_ENABLED__
-      SInt32 pkt_len = sizeof(length) + sizeof(tag) + length + sizeof(checksum);
-#else
-      SInt32 pkt_len = sizeof(length) + sizeof(tag) + length;
-#endif // __CHECKSUM_ENABLED__
-
-      Byte *pkt_buff = new Byte[pkt_len];
-
-      // Length, Tag, Data, (Checksum)
-      Packet *p = (Packet*)pkt_buff;
-      
-      p->length = length;
-      p->tag = tag;
-      memcpy(&p->data, buffer, length);
-
-#ifdef __CHECKSUM_ENABLED__
-      memcpy(&p->data + length, &checksum, sizeof(checksum));
-#endif // __CHECKSUM_ENABLED__
-
-      m_transport->m_send_locks[dest_proc].acquire();
-      m_transport->m_send_sockets[dest_proc].send(pkt_buff, pkt_len);
-      m_transport->m_send_locks[dest_proc].release();
-
-      delete [] pkt_buff;
+      m_transport->enqueueFrame(dest_proc, tag, buff_cpy, length, false);
    }
 
    LOG_PRINT("Message sent.");
@@ -571,6 +792,52 @@ void SockTransport::Socket::send(const void* buffer, UInt32 length)
    LOG_ASSERT_ERROR(sent == SInt32(length), "Failure sending packet on socket %d -- %d != %d", m_socket, sent, length);
 }
 
+void SockTransport::Socket::send(struct iovec *iov, UInt32 count)
+{
+   while (count > 0)
+   {
+      ssize_t sent = ::writev(m_socket, iov, count);
+      LOG_ASSERT_ERROR(sent >= 0, "Failure sending packets on socket %d", m_socket);
+
+      // Skip what went out and retry with the remainder
+      while ((count > 0) && ((size_t) sent >= iov->iov_len))
+      {
+         sent -= iov->iov_len;
+         iov ++;
+         count --;
+      }
+      if (count > 0)
+      {
+         iov->iov_base = (Byte*) iov->iov_base + sent;
+         iov->iov_len -= sent;
+      }
+   }
+}
+
+UInt32 SockTransport::Socket::sendSome(struct iovec *iov, UInt32 count)
+{
+   struct msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = iov;
+   msg.msg_iovlen = count;
+
+   ssize_t sent = ::sendmsg(m_socket, &msg, MSG_DONTWAIT);
+
+   LOG_ASSERT_ERROR(sent >= 0 || errno == EAGAIN || errno == EWOULDBLOCK,
+                    "Failure sending packets on socket %d", m_socket);
+
+   return (sent > 0) ? sent : 0;
+}
+
+UInt32 SockTransport::Socket::recvSome(void *buffer, UInt32 length)
+{
+   SInt32 recvd = ::recv(m_socket, buffer, length, MSG_DONTWAIT);
+
+   LOG_ASSERT_ERROR(recvd >= -1, "recvd(%i), length(%u)", recvd, length);
+
+   return (recvd > 0) ? recvd : 0;
+}
+
 bool SockTransport::Socket::recv(void *buffer, UInt32 length, bool block)
 {
    SInt32 recvd;
@@ -614,6 +881,13 @@ bool SockTransport::Socket::recv(void *buffer, UInt32 length, bool block)
    }
 }
 
+void SockTransport::Socket::setNoDelay()
+{
+   SInt32 on = 1;
+   SInt32 err = ::setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+   LOG_ASSERT_WARNING(err >= 0, "Failed to set TCP_NODELAY on socket: %d", m_socket);
+}
+
 void SockTransport::Socket::close()
 {
    LOG_PRINT("Closing socket: %d", m_socket);
@@ -6,6 +6,7 @@
 #include "semaphore.h"
 
 #include <list>
+#include <sys/uio.h>
 
 class SockTransport : public Transport
 {
@@ -21,6 +22,7 @@ public:
 
       void globalSend(SInt32 dest_proc, const void *buffer, UInt32 length);
       void send(tile_id_t dest_tile, const void *buffer, UInt32 length);
+      void sendBuffer(tile_id_t dest_tile, Byte *buffer, UInt32 length);
       Byte* recv();
       bool query();
 
@@ -36,13 +38,43 @@ public:
    Node *getGlobalNode();
 
 private:
-   struct Packet
+   struct FrameHeader
    {
       UInt32 length;
       SInt32 tag;
-      Byte data;
    } __attribute__((__packed__));
 
+   static const UInt32 MAX_BATCH_FRAMES = 256;
+   static const UInt32 RECV_BUFFER_SIZE = 256 << 10;
+   static const UInt32 DEFAULT_FLUSH_SIZE = 64 << 10;
+
+   // Frames waiting to go out to one process in a single writev(); the
+   // payload buffers are released once written. A nonblocking flush may
+   // leave the queue partially written, starting at m_first_iovec.
+   struct SendQueue
+   {
+      SendQueue() : m_num_frames(0), m_first_iovec(0), m_num_iovecs(0), m_num_bytes(0), m_oldest_time(0) {}
+
+      struct iovec m_iovecs[3 * MAX_BATCH_FRAMES];
+      FrameHeader m_headers[MAX_BATCH_FRAMES];
+      UInt64 m_checksums[MAX_BATCH_FRAMES];
+      Byte* m_buffers[MAX_BATCH_FRAMES];
+      UInt32 m_num_frames;
+      UInt32 m_first_iovec;
+      UInt32 m_num_iovecs;
+      UInt32 m_num_bytes;
+      UInt64 m_oldest_time;
+   };
+
+   // Bytes read from one process, parsed into frames
+   struct RecvStream
+   {
+      Byte* m_buffer;
+      UInt32 m_capacity;
+      UInt32 m_begin;
+      UInt32 m_end;
+   };
+
    struct Header
    {
       Header(UInt32 length, UInt64 checksum):
@@ -55,12 +87,25 @@ private:
    void getProcInfo();
    void initSockets();
    void initBufferLists();
+   void initStreams();
    void insertInBufferList(SInt32 tag, Byte *buffer, Header* header = NULL);
 
    static void updateThreadFunc(void *vp);
    void updateBufferLists();
+   bool receiveFrames(SInt32 proc);
+   void reserveRecvStream(RecvStream &stream, UInt32 size);
+   bool processFrame(SInt32 proc, SInt32 tag, Byte *buffer, UInt32 length, UInt64 checksum);
+   static bool hasChecksum(SInt32 tag) { return (tag != TERMINATE_TAG) && (tag != BARRIER_TAG); }
    void terminateUpdateThread();
 
+   // Takes over 'buffer', which must come from the PacketBufferPool
+   void enqueueFrame(SInt32 dest_proc, SInt32 tag, Byte *buffer, UInt32 length, bool flush);
+   // Returns false if a nonblocking flush left data queued
+   bool flushSendQueue(SInt32 dest_proc, bool block = true);
+   void flushSendQueues(bool stale_only);
+   void sendBarrierMessage(SInt32 dest_proc);
+   static UInt64 getTime();
+
    class Socket
    {
    public:
@@ -75,7 +120,14 @@ private:
       void connect(const char *addr, SInt32 port);
 
       void send(const void* buffer, UInt32 length);
+      void send(struct iovec *iov, UInt32 count);
+      // Non-blocking, returns the number of bytes written
+      UInt32 sendSome(struct iovec *iov, UInt32 count);
       bool recv(void *buffer, UInt32 length, bool block);
+      // Non-blocking, returns the number of bytes read
+      UInt32 recvSome(void *buffer, UInt32 length);
+
+      void setNoDelay();
 
       void close();
 
@@ -111,6 +163,13 @@ private:
    Lock *m_send_locks;
    Socket *m_send_sockets;
 
+   // Outgoing frames are held back for up to m_flush_interval microseconds
+   // or until m_flush_size bytes are pending
+   SendQueue *m_send_queues;
+   RecvStream *m_recv_streams;
+   UInt64 m_flush_interval;
+   UInt32 m_flush_size;
+
    Thread *m_update_thread;
    UpdateThreadState m_update_thread_state;
 
@@ -3,10 +3,13 @@
 #include <assert.h>
 
 #include "transport.h"
+#include "packet_buffer_pool.h"
 #include "smtransport.h"
+#include "shmtransport.h"
 //#include "mpitransport.h"
 #include "socktransport.h"
 
+#include "simulator.h"
 #include "config.h"
 #include "log.h"
 
@@ -25,11 +28,17 @@ Transport* Transport::create()
 
    assert(m_singleton == NULL);
 
-   if (true)
+   if (Config::getSingleton()->getProcessCount() == 1)
+      m_singleton = new SmTransport();
+
+   // processes on the same host talk through shared memory unless disabled
+   else if ((Config::getSingleton()->getProcessCount() > 1) &&
+            Sim()->getCfg()->getBool("transport/shared_memory", true) &&
+            ShmTransport::isColocated())
+      m_singleton = new ShmTransport();
+
+   else if (Config::getSingleton()->getProcessCount() > 1)
       m_singleton = new SockTransport();
-   
-   // else if (Config::getSingleton()->getProcessCount() == 1)
-   //    m_singleton = new SmTransport();
 
    // else if (Config::getSingleton()->getProcessCount() > 1)
    //    m_singleton = new MpiTransport();
@@ -56,3 +65,23 @@ tile_id_t Transport::Node::getTileId()
 {
    return m_tile_id;
 }
+
+void Transport::Node::sendBuffer(tile_id_t dest, Byte *buffer, UInt32 length)
+{
+   send(dest, buffer, length);
+   PacketBufferPool::release(buffer);
+}
+
+UInt32 Transport::Node::recvMany(Byte** buffers, UInt32 max_buffers)
+{
+   assert(max_buffers > 0);
+
+   UInt32 num_buffers = 0;
+   do
+   {
+      buffers[num_buffers ++] = recv();
+   }
+   while ((num_buffers < max_buffers) && query());
+
+   return num_buffers;
+}
@@ -16,8 +16,16 @@ public:
       virtual ~Node() { }
 
       virtual void globalSend(SInt32 dest_proc, const void *buffer, UInt32 length) = 0;
+      // Copies 'buffer' into a transport-owned message
       virtual void send(tile_id_t dest, const void *buffer, UInt32 length) = 0;
+      // Hands a PacketBufferPool buffer over to the transport without copying;
+      // the caller gives up its reference
+      virtual void sendBuffer(tile_id_t dest, Byte *buffer, UInt32 length);
+      // Received buffers come from the PacketBufferPool and must be
+      // returned with PacketBufferPool::release()
       virtual Byte* recv() = 0;
+      // Blocks for at least one message, then drains up to 'max_buffers' available ones
+      virtual UInt32 recvMany(Byte** buffers, UInt32 max_buffers);
       virtual bool query() = 0;
 
    protected:
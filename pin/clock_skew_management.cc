@@ -36,3 +36,11 @@ void addPeriodicSync(INS ins)
 
    INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handlePeriodicSync), IARG_END);
 }
+
+void addPeriodicSync(BBL bbl)
+{
+   if (!enabled())
+      return;
+
+   BBL_InsertCall(bbl, IPOINT_BEFORE, AFUNPTR(handlePeriodicSync), IARG_END);
+}
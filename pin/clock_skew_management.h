@@ -5,5 +5,6 @@
 
 void handlePeriodicSync();
 void addPeriodicSync(INS ins);
+void addPeriodicSync(BBL bbl);
 
 #endif /* __CLOCK_SKEW_MANAGEMENT_H__ */
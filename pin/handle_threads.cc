@@ -39,3 +39,19 @@ void addYield(INS ins)
    }
    INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handleYield), IARG_END);
 }
+
+void addYield(BBL bbl)
+{
+   if (!enabled())
+      return;
+
+   // Yield once per block, before its first instruction that is not a branch or memory instruction
+   for (INS ins = BBL_InsHead(bbl); INS_Valid(ins); ins = INS_Next(ins))
+   {
+      if (!(INS_IsMemoryRead (ins) || INS_IsMemoryWrite (ins) || INS_IsBranch(ins)))
+      {
+         INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handleYield), IARG_END);
+         return;
+      }
+   }
+}
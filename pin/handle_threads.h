@@ -5,5 +5,6 @@
 
 void handleYield();
 void addYield(INS ins);
+void addYield(BBL bbl);
 
 #endif /* __HANDLE_THREADS_H__ */
@@ -21,6 +21,22 @@ void handleInstruction(Instruction* instruction)
    core_model->iterate();
 }
 
+// Called once every time a basic block (or the part of it between REP
+// instructions) starts executing. The instructions of the previous blocks
+// are modeled first; their memory and branch info has been pushed by now,
+// so none of them has to wait for it.
+void handleBasicBlock(BasicBlock* basic_block)
+{
+   if (!Sim()->isEnabled())
+      return;
+
+   CoreModel *core_model = Sim()->getTileManager()->getCurrentCore()->getModel();
+   assert(core_model);
+
+   core_model->iterate();
+   core_model->queueBasicBlock(basic_block);
+}
+
 void handleBranch(BOOL taken, ADDRINT target)
 {
    if (!Sim()->isEnabled())
@@ -157,7 +173,7 @@ VOID fillOperandList(OperandList *list, INS ins)
    }
 }
 
-VOID addInstructionModeling(INS ins)
+Instruction* createInstruction(INS ins)
 {
    Instruction* instruction;
 
@@ -168,18 +184,6 @@ VOID addInstructionModeling(INS ins)
    if (INS_IsBranch(ins) && INS_HasFallThrough(ins))
    {
       instruction = new BranchInstruction(INS_Opcode(ins), list);
-
-      INS_InsertCall(
-         ins, IPOINT_TAKEN_BRANCH, (AFUNPTR)handleBranch,
-         IARG_BOOL, TRUE,
-         IARG_BRANCH_TARGET_ADDR,
-         IARG_END);
-
-      INS_InsertCall(
-         ins, IPOINT_AFTER, (AFUNPTR)handleBranch,
-         IARG_BOOL, FALSE,
-         IARG_BRANCH_TARGET_ADDR,
-         IARG_END);
    }
 
    // Now handle instructions which have a static cost
@@ -208,5 +212,67 @@ VOID addInstructionModeling(INS ins)
    instruction->setAddress(INS_Address(ins));
    instruction->setSize(INS_Size(ins));
 
+   return instruction;
+}
+
+VOID addBranchModeling(INS ins)
+{
+   if (!(INS_IsBranch(ins) && INS_HasFallThrough(ins)))
+      return;
+
+   INS_InsertCall(
+      ins, IPOINT_TAKEN_BRANCH, (AFUNPTR)handleBranch,
+      IARG_BOOL, TRUE,
+      IARG_BRANCH_TARGET_ADDR,
+      IARG_END);
+
+   INS_InsertCall(
+      ins, IPOINT_AFTER, (AFUNPTR)handleBranch,
+      IARG_BOOL, FALSE,
+      IARG_BRANCH_TARGET_ADDR,
+      IARG_END);
+}
+
+VOID addInstructionModeling(INS ins)
+{
+   Instruction* instruction = createInstruction(ins);
+   addBranchModeling(ins);
+
    INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handleInstruction), IARG_PTR, instruction, IARG_END);
 }
+
+static VOID insertBasicBlockCall(INS head, BasicBlock* basic_block)
+{
+   if (basic_block)
+      INS_InsertCall(head, IPOINT_BEFORE, AFUNPTR(handleBasicBlock), IARG_PTR, basic_block, IARG_END);
+}
+
+VOID addBasicBlockModeling(BBL bbl)
+{
+   // The block is decoded once here and shared by all its executions.
+   // REP-prefixed instructions run a data-dependent number of iterations
+   // (possibly none), each pushing its own memory info, so they are modeled
+   // per iteration as in instruction mode and split the block around them.
+   BasicBlock* basic_block = NULL;
+   INS head = INS_Invalid();
+   for (INS ins = BBL_InsHead(bbl); INS_Valid(ins); ins = INS_Next(ins))
+   {
+      if (INS_HasRealRep(ins))
+      {
+         insertBasicBlockCall(head, basic_block);
+         basic_block = NULL;
+         addInstructionModeling(ins);
+         continue;
+      }
+
+      if (!basic_block)
+      {
+         basic_block = new BasicBlock();
+         head = ins;
+      }
+      basic_block->push_back(createInstruction(ins));
+      addBranchModeling(ins);
+   }
+
+   insertBasicBlockCall(head, basic_block);
+}
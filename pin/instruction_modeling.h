@@ -4,5 +4,6 @@
 #include <pin.H>
 
 void addInstructionModeling(INS ins);
+void addBasicBlockModeling(BBL bbl);
 
 #endif
@@ -61,6 +61,8 @@
 // -- a PinSimulator class or smthg
 bool done_app_initialization = false;
 config::ConfigFile *cfg;
+// Model the core one basic block at a time instead of one instruction at a time
+bool basic_block_modeling = false;
 
 // clone stuff
 extern int *parent_tidptr;
@@ -174,7 +176,7 @@ VOID instructionCallback(INS ins, void *v)
             IARG_END);
    }
 
-   if (Config::getSingleton()->getEnableCoreModeling())
+   if (Config::getSingleton()->getEnableCoreModeling() && !basic_block_modeling)
    {
       // Core Performance Modeling
       addInstructionModeling(ins);
@@ -224,6 +226,26 @@ VOID instructionCallback(INS ins, void *v)
    }
 }
 
+VOID traceCallback(TRACE trace, void *v)
+{
+   // Only added when basic_block_modeling is set; the functional
+   // instrumentation stays in instructionCallback
+   for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl))
+   {
+      // Core Performance Modeling
+      addBasicBlockModeling(bbl);
+
+      // Progress Trace
+      addProgressTrace(bbl);
+
+      // Clock Skew Management
+      addPeriodicSync(bbl);
+
+      // Scheduling
+      addYield(bbl);
+   }
+}
+
 // syscall model wrappers
 void initializeSyscallModeling()
 {
@@ -438,6 +460,16 @@ int main(int argc, char *argv[])
    // Add INS instrumentation
    INS_AddInstrumentFunction(instructionCallback, 0);
 
+   // Add TRACE instrumentation
+   std::string instrumentation_granularity = cfg->getString("core/instrumentation_granularity", "instruction");
+   if (instrumentation_granularity == "basic_block")
+      basic_block_modeling = true;
+   else if (instrumentation_granularity != "instruction")
+      LOG_PRINT_ERROR("Unrecognized core/instrumentation_granularity(%s)", instrumentation_granularity.c_str());
+
+   if (Config::getSingleton()->getEnableCoreModeling() && basic_block_modeling)
+      TRACE_AddInstrumentFunction(traceCallback, 0);
+
    initProgressTrace();
 
    // Add Application Fini function
@@ -130,3 +130,11 @@ VOID addProgressTrace(INS ins)
 
    INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(traceProgress), IARG_END);
 }
+
+VOID addProgressTrace(BBL bbl)
+{
+   if (!enabled())
+      return;
+
+   BBL_InsertCall(bbl, IPOINT_BEFORE, AFUNPTR(traceProgress), IARG_END);
+}
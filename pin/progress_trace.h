@@ -5,5 +5,6 @@ VOID initProgressTrace();
 VOID shutdownProgressTrace();
 VOID threadStartProgressTrace();
 VOID addProgressTrace(INS ins);
+VOID addProgressTrace(BBL bbl);
 
 #endif
@@ -220,7 +220,7 @@ void* sendNetworkTraffic(void*)
          // Check if a packet has arrived for this core (Should be non-blocking)
          core_id_t core_id = tile->getCore()->getId();
          NetPacket recv_net_packet = tile->getNetwork()->netRecvType(_packet_type, core_id);
-         delete [] (Byte*) recv_net_packet.data;
+         recv_net_packet.release();
          total_packets_received ++;
       }
 
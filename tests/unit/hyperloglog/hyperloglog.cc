@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "hyperloglog.h"
+
+#define PRECISION          12
+#define LINE_SIZE          64
+#define BASE_ADDRESS       0x10000000ULL
+
+// Estimates may be off by up to this many standard errors
+#define MAX_ERRORS         4
+
+void fail(const char* step, UInt64 expected, UInt64 got)
+{
+   fprintf(stderr, "*ERROR* %s, Expected(%llu), Got(%llu)\n", step,
+           (unsigned long long) expected, (unsigned long long) got);
+   fprintf(stderr, "HyperLogLog test: FAILED\n");
+   exit(EXIT_FAILURE);
+}
+
+void checkEstimate(const char* step, const HyperLogLog& estimator, UInt64 num_distinct)
+{
+   UInt64 estimate = estimator.estimate();
+   double error = fabs((double) estimate - (double) num_distinct);
+   if (error > MAX_ERRORS * HyperLogLog::getStandardError(PRECISION) * num_distinct)
+      fail(step, num_distinct, estimate);
+}
+
+// Inserts 'num_distinct' cache line addresses, each of them 'num_repeats' times
+void testDistinct(UInt64 num_distinct, UInt32 num_repeats)
+{
+   HyperLogLog estimator(PRECISION);
+   for (UInt32 repeat = 0; repeat < num_repeats; repeat++)
+   {
+      for (UInt64 i = 0; i < num_distinct; i++)
+         estimator.insert(BASE_ADDRESS + i * LINE_SIZE);
+      checkEstimate("Distinct addresses", estimator, num_distinct);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting HyperLogLog test\n");
+
+   HyperLogLog empty(PRECISION);
+   if (empty.estimate() != 0)
+      fail("Empty", 0, empty.estimate());
+
+   // Linear counting range, then well beyond the number of registers
+   testDistinct(10, 2);
+   testDistinct(1000, 2);
+   testDistinct(20000, 2);
+   testDistinct(1000000, 3);
+
+   printf("HyperLogLog test: SUCCESS\n");
+   CarbonStopSim();
+
+   return 0;
+}
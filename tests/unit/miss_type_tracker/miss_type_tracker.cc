@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "exact_miss_type_tracker.h"
+#include "hashed_miss_type_tracker.h"
+
+// 512-line LRU cache
+#define NUM_SETS              64
+#define ASSOCIATIVITY         8
+#define NUM_CACHE_LINES       (NUM_SETS * ASSOCIATIVITY)
+#define LINE_SIZE             64
+#define BASE_ADDRESS          0x10000000ULL
+
+// Random accesses to twice as many lines as the cache holds, with a
+// resident line invalidated by another tile every INVALIDATION_INTERVAL accesses
+#define FOOTPRINT_LINES       (2 * NUM_CACHE_LINES)
+#define NUM_ACCESSES          200000
+#define INVALIDATION_INTERVAL 50
+
+// Hashed tracker with the default history size, and a bloom filter sized
+// for exactly the footprint
+#define EXPECTED_LINES        FOOTPRINT_LINES
+#define FALSE_POSITIVE_RATE   0.01
+#define HISTORY_ENTRIES       4
+#define HISTORY_ASSOCIATIVITY 4
+
+// Allowed shortfall of the hashed cold and capacity miss counts (in percent)
+#define MAX_COLD_ERROR        2
+#define MAX_CAPACITY_ERROR    3
+
+UInt64 exact_misses[Cache::NUM_MISS_TYPES];
+UInt64 hashed_misses[Cache::NUM_MISS_TYPES];
+
+void fail(const char* step, UInt64 exact, UInt64 hashed)
+{
+   fprintf(stderr, "*ERROR* %s, Exact(%llu), Hashed(%llu)\n", step,
+           (unsigned long long) exact, (unsigned long long) hashed);
+   fprintf(stderr, "Miss-Type-Tracker test: FAILED\n");
+   exit(EXIT_FAILURE);
+}
+
+// The hashed counts may fall short of the exact ones by up to 'max_error' percent
+void checkLowerBound(const char* step, Cache::MissType miss_type, UInt64 max_error)
+{
+   UInt64 exact = exact_misses[miss_type];
+   UInt64 hashed = hashed_misses[miss_type];
+   if ((hashed > exact) || ((exact - hashed) * 100 > exact * max_error))
+      fail(step, exact, hashed);
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Miss-Type-Tracker test\n");
+
+   ExactMissTypeTracker exact;
+   HashedMissTypeTracker hashed(NUM_CACHE_LINES, EXPECTED_LINES, FALSE_POSITIVE_RATE,
+                                HISTORY_ENTRIES, HISTORY_ASSOCIATIVITY);
+
+   // Most recently used line first
+   std::vector<std::list<IntPtr> > sets(NUM_SETS);
+
+   srand(1);
+   for (UInt32 i = 0; i < NUM_ACCESSES; i++)
+   {
+      IntPtr address = BASE_ADDRESS + (rand() % FOOTPRINT_LINES) * LINE_SIZE;
+      std::list<IntPtr>& set = sets[(address / LINE_SIZE) % NUM_SETS];
+
+      bool hit = false;
+      for (std::list<IntPtr>::iterator it = set.begin(); it != set.end(); it++)
+      {
+         if (*it == address)
+         {
+            set.erase(it);
+            hit = true;
+            break;
+         }
+      }
+
+      if (!hit)
+      {
+         exact_misses[exact.getMissType(address)] ++;
+         hashed_misses[hashed.getMissType(address)] ++;
+         exact.recordFetch(address);
+         hashed.recordFetch(address);
+
+         if (set.size() == ASSOCIATIVITY)
+         {
+            exact.recordEviction(set.back());
+            hashed.recordEviction(set.back());
+            set.pop_back();
+         }
+      }
+      set.push_front(address);
+
+      if ((i % INVALIDATION_INTERVAL) == 0)
+      {
+         std::list<IntPtr>& invalidated_set = sets[rand() % NUM_SETS];
+         if (!invalidated_set.empty())
+         {
+            exact.recordInvalidation(invalidated_set.back());
+            hashed.recordInvalidation(invalidated_set.back());
+            invalidated_set.pop_back();
+         }
+      }
+   }
+
+   if (exact_misses[Cache::COLD_MISS] != FOOTPRINT_LINES)
+      fail("Exact cold misses", FOOTPRINT_LINES, exact_misses[Cache::COLD_MISS]);
+
+   // Misclassified misses are counted as sharing misses
+   checkLowerBound("Cold misses", Cache::COLD_MISS, MAX_COLD_ERROR);
+   checkLowerBound("Capacity misses", Cache::CAPACITY_MISS, MAX_CAPACITY_ERROR);
+   if (hashed_misses[Cache::SHARING_MISS] < exact_misses[Cache::SHARING_MISS])
+      fail("Sharing misses", exact_misses[Cache::SHARING_MISS], hashed_misses[Cache::SHARING_MISS]);
+
+   printf("Miss-Type-Tracker test: SUCCESS\n");
+   CarbonStopSim();
+
+   return 0;
+}
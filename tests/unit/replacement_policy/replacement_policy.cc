@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <list>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "tree_plru_replacement_policy.h"
+#include "packed_lru_replacement_policy.h"
+
+// The tree PLRU and packed LRU policies track valid ways themselves and never
+// look at the line infos
+#define NO_LINE_INFOS   ((CacheLineInfo**) NULL)
+
+// 1 KB caches with a single set
+#define CACHE_SIZE      1
+
+#define NUM_ACCESSES    1000
+
+void fail(const char* policy, const char* step, UInt32 expected, UInt32 got)
+{
+   fprintf(stderr, "*ERROR* %s: %s, Expected way(%u), Got way(%u)\n", policy, step, expected, got);
+   fprintf(stderr, "Replacement-Policy test: FAILED\n");
+   exit(EXIT_FAILURE);
+}
+
+void checkVictim(CacheReplacementPolicy& policy, const char* name, const char* step, UInt32 expected)
+{
+   UInt32 way = policy.getReplacementWay(NO_LINE_INFOS, 0);
+   if (way != expected)
+      fail(name, step, expected, way);
+}
+
+// Invalid ways are filled lowest first, also after an invalidation
+void testFillOrder(CacheReplacementPolicy& policy, const char* name, UInt32 associativity)
+{
+   for (UInt32 way = 0; way < associativity; way++)
+   {
+      checkVictim(policy, name, "Fill", way);
+      policy.update(NO_LINE_INFOS, 0, way);
+   }
+
+   policy.invalidate(0, associativity-1);
+   policy.invalidate(0, 1);
+   checkVictim(policy, name, "Refill after invalidation", 1);
+   policy.update(NO_LINE_INFOS, 0, 1);
+   checkVictim(policy, name, "Refill after invalidation", associativity-1);
+   policy.update(NO_LINE_INFOS, 0, associativity-1);
+}
+
+// Replaces the victim 'num_victims' times
+void testVictimOrder(CacheReplacementPolicy& policy, const char* name, const UInt32* expected, UInt32 num_victims)
+{
+   for (UInt32 i = 0; i < num_victims; i++)
+   {
+      checkVictim(policy, name, "Victim order", expected[i]);
+      policy.update(NO_LINE_INFOS, 0, expected[i]);
+   }
+}
+
+// Compares against a list kept in recency order
+void testTrueLRU(CacheReplacementPolicy& policy, const char* name, UInt32 associativity)
+{
+   std::list<UInt32> lru_list;
+   for (UInt32 way = 0; way < associativity; way++)
+   {
+      policy.update(NO_LINE_INFOS, 0, way);
+      lru_list.push_front(way);
+   }
+
+   srand(1);
+   for (UInt32 i = 0; i < NUM_ACCESSES; i++)
+   {
+      checkVictim(policy, name, "Random accesses", lru_list.back());
+
+      UInt32 way = rand() % associativity;
+      policy.update(NO_LINE_INFOS, 0, way);
+      lru_list.remove(way);
+      lru_list.push_front(way);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Replacement-Policy test\n");
+
+   // Each replacement points the tree away from the replaced way, so the
+   // victims alternate between the two halves of the set
+   const UInt32 tree_plru_victims[] = {0, 2, 1, 3, 0, 2, 1, 3};
+   TreePLRUReplacementPolicy tree_plru(CACHE_SIZE, 4, 256);
+   testFillOrder(tree_plru, "Tree-PLRU", 4);
+   testVictimOrder(tree_plru, "Tree-PLRU", tree_plru_victims, 8);
+
+   // Ways 1 and 3 were refilled last, so 0 and 2 go first
+   const UInt32 packed_lru_victims[] = {0, 2, 1, 3, 0, 2, 1, 3};
+   PackedLRUReplacementPolicy packed_lru(CACHE_SIZE, 4, 256);
+   testFillOrder(packed_lru, "Packed-LRU", 4);
+   testVictimOrder(packed_lru, "Packed-LRU", packed_lru_victims, 8);
+
+   PackedLRUReplacementPolicy packed_lru_16(CACHE_SIZE, 16, 64);
+   testTrueLRU(packed_lru_16, "Packed-LRU", 16);
+
+   printf("Replacement-Policy test: SUCCESS\n");
+   CarbonStopSim();
+
+   return 0;
+}
@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <cstdlib>
+#include "carbon_user.h"
+#include "fixed_types.h"
+#include "tag_match.h"
+
+#define INVALID_TAG        ((IntPtr) ~0)
+#define MAX_ASSOCIATIVITY  16
+#define NUM_TRIALS         1000
+
+void fail(const char* step, UInt32 associativity, UInt32 expected, UInt32 got)
+{
+   fprintf(stderr, "*ERROR* %s, Associativity(%u), Expected(%#x), Got(%#x)\n", step, associativity, expected, got);
+   fprintf(stderr, "Tag-Match test: FAILED\n");
+   exit(EXIT_FAILURE);
+}
+
+// Both the vector and the scalar matches of every tag in 'tags', of the
+// invalid tag and of a missing tag
+void checkSet(const IntPtr* tags, UInt32 associativity)
+{
+   TagMatch::MatchMaskFn vector_match_mask = TagMatch::getVectorMatchMaskFn(associativity);
+   TagMatch tag_match(associativity);
+
+   IntPtr keys[MAX_ASSOCIATIVITY + 2];
+   for (UInt32 way = 0; way < associativity; way++)
+      keys[way] = tags[way];
+   keys[associativity] = INVALID_TAG;
+   keys[associativity + 1] = 0x7fffffffffffULL;
+
+   for (UInt32 i = 0; i < associativity + 2; i++)
+   {
+      UInt32 expected = TagMatch::scalarMatchMask(tags, associativity, keys[i]);
+      if (vector_match_mask && (vector_match_mask(tags, keys[i]) != expected))
+         fail("Vector match", associativity, expected, vector_match_mask(tags, keys[i]));
+
+      SInt32 highest = (expected == 0) ? -1 : (31 - __builtin_clz(expected));
+      SInt32 lowest = (expected == 0) ? -1 : __builtin_ctz(expected);
+      if (tag_match.findHighest(tags, keys[i]) != highest)
+         fail("Highest way", associativity, highest, tag_match.findHighest(tags, keys[i]));
+      if (tag_match.findLowest(tags, keys[i]) != lowest)
+         fail("Lowest way", associativity, lowest, tag_match.findLowest(tags, keys[i]));
+   }
+}
+
+// Random sets with some invalid ways, and tags that only differ in one
+// 32-bit half from another way's
+void testAssociativity(UInt32 associativity)
+{
+#ifdef VECTOR_TAG_MATCH
+   if ((associativity == 4 || associativity == 8 || associativity == 16) &&
+       (TagMatch::getVectorMatchMaskFn(associativity) == NULL))
+      fail("No vector match", associativity, 0, 0);
+#endif
+
+   IntPtr tags[MAX_ASSOCIATIVITY];
+   for (UInt32 trial = 0; trial < NUM_TRIALS; trial++)
+   {
+      for (UInt32 way = 0; way < associativity; way++)
+      {
+         switch (rand() % 4)
+         {
+         case 0:
+            tags[way] = INVALID_TAG;
+            break;
+         case 1:
+            tags[way] = (way > 0) ? (tags[way-1] ^ (1ULL << (rand() % 64))) : (IntPtr) rand();
+            break;
+         default:
+            tags[way] = ((IntPtr) rand() << 16) ^ (IntPtr) rand();
+            break;
+         }
+      }
+      checkSet(tags, associativity);
+   }
+
+   // All ways invalid
+   for (UInt32 way = 0; way < associativity; way++)
+      tags[way] = INVALID_TAG;
+   checkSet(tags, associativity);
+}
+
+int main(int argc, char* argv[])
+{
+   CarbonStartSim(argc, argv);
+   printf("Starting Tag-Match test\n");
+
+   srand(1);
+   testAssociativity(4);
+   testAssociativity(8);
+   testAssociativity(16);
+   // Scanned
+   testAssociativity(2);
+   testAssociativity(12);
+
+   printf("Tag-Match test: SUCCESS\n");
+   CarbonStopSim();
+
+   return 0;
+}
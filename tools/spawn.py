@@ -7,6 +7,7 @@ This is the python script that is responsible for spawning a simulation
 import sys
 import os
 import commands
+import binascii
 import subprocess
 
 from termcolors import *
@@ -30,14 +31,20 @@ def get_pin_home(graphite_home):
 #  start up a command on one machine
 #  can be called by spawn_master.py or spawn_slave.py
 
-def spawn_job(proc_num, command, graphite_home):
+def spawn_job(proc_num, command, graphite_home, run_id):
     # Set LD_LIBRARY_PATH using PIN_HOME from Makefile.config
     os.environ['LD_LIBRARY_PATH'] =  "%s/intel64/runtime" % get_pin_home(graphite_home)
     os.environ['CARBON_PROCESS_INDEX'] = "%d" % (proc_num)
+    os.environ['CARBON_RUN_ID'] = run_id
     os.environ['GRAPHITE_HOME'] = graphite_home
     proc = subprocess.Popen(command, shell=True, preexec_fn=os.setsid, env=os.environ)
     return proc
 
+# get_run_id:
+#  token that identifies a simulation among concurrent ones on the same machines
+def get_run_id():
+    return binascii.hexlify(os.urandom(8))
+
 # spawn_renew_permissions_proc:
 #  command to renew Kerberos/AFS tokens
 def spawn_renew_permissions_proc():
@@ -20,6 +20,7 @@ from termcolors import *
 def spawn_job(machine_list, command, working_dir, graphite_home):
     
     graphite_procs = {}
+    run_id = spawn.get_run_id()
 
     # spawn
     for i in range(0, len(machine_list)):
@@ -27,10 +28,10 @@ def spawn_job(machine_list, command, working_dir, graphite_home):
             exec_command = "%s" % (command)
             
             print "%s Starting process: %d: %s" % (pmaster(), i, exec_command)
-            graphite_procs[i] = spawn.spawn_job(i, exec_command, graphite_home)
+            graphite_procs[i] = spawn.spawn_job(i, exec_command, graphite_home, run_id)
         else:
             command = command.replace("\"", "\\\"")
-            spawn_slave_command = "python -u %s/tools/spawn_slave.py %s %d \\\"%s\\\"" % (graphite_home, working_dir, i, command)
+            spawn_slave_command = "python -u %s/tools/spawn_slave.py %s %d %s \\\"%s\\\"" % (graphite_home, working_dir, i, run_id, command)
             exec_command = "ssh -x %s \"%s\"" % (machine_list[i], spawn_slave_command)
    
             print "%s Starting process: %d: %s" % (pmaster(), i, exec_command)
@@ -16,10 +16,10 @@ from termcolors import *
 # spawn_job:
 #  start up a command over an ssh connection on one machine
 #  returns an object that can be passed to wait_job()
-def spawn_job(proc_num, command, working_dir, graphite_home):
+def spawn_job(proc_num, run_id, command, working_dir, graphite_home):
    exec_command = "cd %s; %s" % (working_dir, command)
    print "%s Starting process: %d: %s" % (pslave(), proc_num, exec_command)
-   graphite_proc = spawn.spawn_job(proc_num, exec_command, graphite_home)
+   graphite_proc = spawn.spawn_job(proc_num, exec_command, graphite_home, run_id)
    renew_permissions_proc = spawn.spawn_renew_permissions_proc()
    return [graphite_proc, renew_permissions_proc]
 
@@ -61,9 +61,10 @@ def pslave():
 if __name__=="__main__":
   
    proc_num = int(sys.argv[2])
-   command = " ".join(sys.argv[3:])
+   run_id = sys.argv[3]
+   command = " ".join(sys.argv[4:])
    working_dir = sys.argv[1]
    graphite_home = get_graphite_home(sys.argv[0])
 
-   [graphite_proc, renew_permissions_proc] = spawn_job(proc_num, command, working_dir, graphite_home)
+   [graphite_proc, renew_permissions_proc] = spawn_job(proc_num, run_id, command, working_dir, graphite_home)
    sys.exit(wait_job(graphite_proc, renew_permissions_proc, proc_num))